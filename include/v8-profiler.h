@@ -388,6 +388,47 @@ class V8EXPORT HeapSnapshot {
 };
 
 
+/**
+ * AllocationProfileNode represents a JavaScript stack frame in the
+ * allocation tree built by the sampling heap profiler. Counts and sizes
+ * are those of the sampled allocations whose stack ends at this node.
+ */
+class V8EXPORT AllocationProfileNode {
+ public:
+  /** Returns function name (empty string for anonymous functions.) */
+  Handle<String> GetFunctionName() const;
+
+  /** Returns resource name for script from where the function originates. */
+  Handle<String> GetScriptResourceName() const;
+
+  /**
+   * Returns the number, 1-based, of the line where the function originates.
+   * kNoLineNumberInfo if no line number information is available.
+   */
+  int GetLineNumber() const;
+
+  /** Returns the number of allocations sampled at this node. */
+  int GetSamplesCount() const;
+
+  /** Returns the total size of allocations sampled at this node. */
+  size_t GetSize() const;
+
+  /** Returns the number of sampled allocations that are still alive. */
+  int GetLiveSamplesCount() const;
+
+  /** Returns the total size of sampled allocations that are still alive. */
+  size_t GetLiveSize() const;
+
+  /** Returns child nodes count of the node. */
+  int GetChildrenCount() const;
+
+  /** Retrieves a child node by index. */
+  const AllocationProfileNode* GetChild(int index) const;
+
+  static const int kNoLineNumberInfo = Message::kNoLineNumberInfo;
+};
+
+
 class RetainedObjectInfo;
 
 /**
@@ -435,6 +476,29 @@ class V8EXPORT HeapProfiler {
       HeapSnapshot::Type type = HeapSnapshot::kFull,
       ActivityControl* control = NULL);
 
+  /**
+   * Takes a heap snapshot and writes it to |stream| as the heap is being
+   * traversed, keeping neither nodes, edges nor an object id mapping in
+   * memory. Nodes are numbered by their order in the snapshot, so these
+   * numbers are not comparable across snapshots. The output consists of
+   * lines, each holding one JSON array:
+   *
+   *   ["s", string_id, "string"]
+   *   ["n", node, type, name, self_size]
+   *   ["t", node, name]
+   *   ["e", type, from_node, to_node, name_or_index]
+   *
+   * A string record precedes the first record referring to its id, and a
+   * node record precedes all other records referring to its node. A "t"
+   * record names a node that was written with an empty name. Names are
+   * string ids, except that once the string table is full, names not in
+   * it are written inline as JSON strings. Node and edge types are those
+   * of HeapGraphNode::Type and HeapGraphEdge::Type.
+   * Returns false if the stream or |control| aborted the operation.
+   */
+  static bool StreamSnapshot(OutputStream* stream,
+                             ActivityControl* control = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -469,6 +533,27 @@ class V8EXPORT HeapProfiler {
    */
   static void DeleteAllSnapshots();
 
+  /**
+   * Starts the sampling heap profiler. Allocations are sampled on average
+   * once every |sample_interval| bytes and attributed to the JavaScript
+   * stack at the allocation site. Returns false if the sampling heap
+   * profiler is already running.
+   */
+  static bool StartSamplingHeapProfiler(int sample_interval = 512 * 1024);
+
+  /**
+   * Returns the root of the allocation tree collected so far, or NULL if
+   * the sampling heap profiler is not running. The tree is owned by the
+   * profiler and keeps being updated by allocations and garbage collections.
+   */
+  static const AllocationProfileNode* GetAllocationProfileRoot();
+
+  /**
+   * Stops the sampling heap profiler. All pointers to nodes previously
+   * returned become invalid.
+   */
+  static void StopSamplingHeapProfiler();
+
   /** Binds a callback to embedder's class ID. */
   static void DefineWrapperClass(
       uint16_t class_id,
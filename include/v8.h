@@ -538,6 +538,24 @@ class V8EXPORT ScriptData {  // NOLINT
    */
   static ScriptData* PreCompile(Handle<String> source);
 
+  /**
+   * Pre-compiles the specified script without entering or locking any
+   * isolate, so that it can be done on a background thread while the isolate
+   * keeps running JavaScript.  The result can be passed to Script::Compile or
+   * Script::New on the isolate's thread to skip over lazily compiled
+   * functions.  The source must not be modified until this call returns.
+   *
+   * \param input Pointer to UTF-8 script source code.
+   * \param length Length of UTF-8 script source code.
+   * \param max_stack_size Amount of stack the pre-compiler may use on the
+   *   calling thread.
+   * \return The pre-compilation data, or NULL if max_stack_size was
+   *   exceeded.
+   */
+  static ScriptData* PreCompileInBackground(const char* input,
+                                            int length,
+                                            size_t max_stack_size);
+
   /**
    * Load previous pre-compilation data.
    *
@@ -2024,6 +2042,21 @@ class V8EXPORT AccessorInfo {
 
 typedef Handle<Value> (*InvocationCallback)(const Arguments& args);
 
+/**
+ * Types of the parameters and the return value of fast callbacks, see
+ * FunctionTemplate::SetFastCallHandler.
+ */
+enum FastCallbackType {
+  kFastCallbackVoid,     // No value; for the return value and the receiver.
+  kFastCallbackInt32,    // int32_t, converted from a number.
+  kFastCallbackDouble,   // double, converted from a number.
+  kFastCallbackBool,     // bool, converted from true or false.
+  kFastCallbackExternal  // void*, only for the receiver: the pointer stored
+                         // in its first internal field.
+};
+
+typedef void (*FastCallback)();
+
 /**
  * NamedProperty[Getter|Setter] are used as interceptors on object.
  * See ObjectTemplate::SetNamedPropertyHandler.
@@ -2245,6 +2278,26 @@ class V8EXPORT FunctionTemplate : public Template {
   void SetCallHandler(InvocationCallback callback,
                       Handle<Value> data = Handle<Value>());
 
+  /**
+   * Sets a C++ function that optimized code may call directly, instead of
+   * the call handler, when the function created from this template is
+   * called as a method with exactly argc arguments of the given types.
+   * The function is cast to FastCallback. It is passed the receiver, if
+   * receiver_type is kFastCallbackExternal, followed by the unboxed
+   * arguments, and it returns a value of type return_type. All other
+   * calls go through the call handler, which must behave the same way.
+   *
+   * The function must not call into V8 in any way, including creating
+   * handles and throwing exceptions. At most four parameters, counting
+   * the receiver, are supported, and the template must not have a
+   * signature. Fast calls are currently only made on IA32 and X64.
+   */
+  void SetFastCallHandler(FastCallback callback,
+                          FastCallbackType return_type,
+                          FastCallbackType receiver_type,
+                          int argc,
+                          const FastCallbackType* argument_types);
+
   /** Get the InstanceTemplate. */
   Local<ObjectTemplate> InstanceTemplate();
 
@@ -2771,6 +2824,116 @@ class V8EXPORT HeapStatistics {
 };
 
 
+/**
+ * Structured description of a single garbage collection.
+ *
+ * V8 records one event per collection when running with
+ * --record_gc_events.  Events can be retrieved with V8::GetGCEvents.
+ * Times are in milliseconds and sizes in bytes.
+ */
+class V8EXPORT GCEvent {
+ public:
+  enum Phase {
+    kExternalPhase,
+    kMarkPhase,
+    kSweepPhase,
+    kSweepNewSpacePhase,
+    kEvacuatePagesPhase,
+    kUpdateNewToNewPointersPhase,
+    kUpdateRootToNewPointersPhase,
+    kUpdateOldToNewPointersPhase,
+    kUpdatePointersToEvacuatedPhase,
+    kUpdatePointersBetweenEvacuatedPhase,
+    kUpdateMiscPointersPhase,
+    kFlushCodePhase,
+    kNumberOfPhases
+  };
+
+  enum Space {
+    kNewSpace,
+    kOldPointerSpace,
+    kOldDataSpace,
+    kCodeSpace,
+    kMapSpace,
+    kCellSpace,
+    kLargeObjectSpace,
+    kNumberOfSpaces
+  };
+
+  GCEvent();
+  GCType type() { return type_; }
+  /** Sequence number of this collection, counting from one. */
+  unsigned int gc_count() { return gc_count_; }
+  /**
+   * Number of events that were dropped right before this one because the
+   * embedder did not poll often enough.
+   */
+  int dropped_before() { return dropped_before_; }
+  /** Start of the collection relative to isolate initialization. */
+  double start_time() { return start_time_; }
+  /** Time the mutator was paused for this collection. */
+  double pause_time() { return pause_time_; }
+  /** Time spent in incremental marking steps leading up to the pause. */
+  double incremental_time() { return incremental_time_; }
+  int incremental_steps() { return incremental_steps_; }
+  double phase_time(Phase phase) { return phase_times_[phase]; }
+  size_t promoted_size() { return promoted_size_; }
+  size_t freed_size() { return freed_size_; }
+  size_t space_size_before(Space space) { return space_sizes_before_[space]; }
+  size_t space_size_after(Space space) { return space_sizes_after_[space]; }
+
+ private:
+  GCType type_;
+  unsigned int gc_count_;
+  int dropped_before_;
+  double start_time_;
+  double pause_time_;
+  double incremental_time_;
+  int incremental_steps_;
+  double phase_times_[kNumberOfPhases];
+  size_t promoted_size_;
+  size_t freed_size_;
+  size_t space_sizes_before_[kNumberOfSpaces];
+  size_t space_sizes_after_[kNumberOfSpaces];
+
+  friend class V8;
+};
+
+
+/**
+ * Deoptimization counts of one function.
+ *
+ * Functions are identified like in optimization profiles (see
+ * V8::GetOptimizationProfile): by a hash of their source text and their
+ * start position in the script.  Counts are kept for the lifetime of the
+ * isolate and can be retrieved with V8::GetDeoptimizationStatistics.
+ */
+class V8EXPORT DeoptimizationStatistics {
+ public:
+  enum BailoutType {
+    kEager,     // A check in optimized code failed.
+    kLazy,      // Optimized code on the stack was invalidated.
+    kOsr,       // On-stack replacement.
+    kNumberOfBailoutTypes
+  };
+
+  DeoptimizationStatistics();
+  /** Debug name of the function.  Owned by V8, valid for the isolate's life. */
+  const char* function_name() { return function_name_; }
+  unsigned int source_hash() { return source_hash_; }
+  int start_position() { return start_position_; }
+  int count(BailoutType type) { return counts_[type]; }
+
+ private:
+  const char* function_name_;
+  unsigned int source_hash_;
+  int start_position_;
+  int counts_[kNumberOfBailoutTypes];
+
+  friend class V8;
+};
+
+
 class RetainedObjectInfo;
 
 /**
@@ -3331,6 +3494,45 @@ class V8EXPORT V8 {
    */
   static void GetHeapStatistics(HeapStatistics* heap_statistics);
 
+  /**
+   * Moves up to |length| GC events recorded by |isolate| since the last
+   * call into |events| and returns the number of events written.  Events
+   * are only recorded when V8 runs with --record_gc_events.  The events are
+   * kept in a bounded lock-free buffer, so this should be called regularly,
+   * e.g. from a GC epilogue callback or a periodic timer.  It does not need
+   * to be called from the isolate's thread, but only one thread may poll a
+   * given isolate.  Events that do not fit are dropped and reported through
+   * GCEvent::dropped_before.
+   */
+  static int GetGCEvents(Isolate* isolate, GCEvent* events, int length);
+
+  /**
+   * Returns the optimization profile of the current isolate: the functions
+   * the runtime profiler decided to optimize, plus those of a previously
+   * loaded profile.  Functions are identified by a hash of their source text
+   * and their start position in the script, so the profile stays valid in
+   * other processes running the same scripts.
+   */
+  static Local<String> GetOptimizationProfile();
+
+  /**
+   * Loads a profile returned by GetOptimizationProfile, typically in a new
+   * process.  Functions in the profile are optimized as soon as the runtime
+   * profiler sees them running instead of after warming up.  Returns false
+   * and leaves the current profile in place if the profile is malformed.
+   */
+  static bool LoadOptimizationProfile(Handle<String> profile);
+
+  /**
+   * Copies the deoptimization counts of up to |length| functions that were
+   * deoptimized in the current isolate into |statistics|, and returns the
+   * number of such functions, which may be larger than |length|.  A function
+   * that keeps deoptimizing is reoptimized with exponential back-off and
+   * eventually not optimized any more.
+   */
+  static int GetDeoptimizationStatistics(DeoptimizationStatistics* statistics,
+                                         int length);
+
   /**
    * Iterates through all external resources referenced from current isolate
    * heap. This method is not expected to be used except for debugging purposes
@@ -3579,6 +3781,22 @@ class V8EXPORT Context {
       Handle<ObjectTemplate> global_template = Handle<ObjectTemplate>(),
       Handle<Value> global_object = Handle<Value>());
 
+  /**
+   * Creates a new context by copying this one.  The copy starts out with
+   * the same global object state as this context has at the time of the
+   * call, including everything the embedder has installed in it, but the
+   * two contexts are independent afterwards.  Copying is considerably
+   * cheaper than creating and setting up a context with Context::New.
+   *
+   * Code and immutable values such as strings are shared with the
+   * original context.  Handles held by the embedder keep referring to
+   * objects in the original context.  Optimized code is not copied.
+   *
+   * Returns a persistent handle to the newly allocated context which has
+   * to be disposed when the context is no longer used.
+   */
+  Persistent<Context> Clone();
+
   /** Returns the last entered context. */
   static Local<Context> GetEntered();
 
@@ -1058,6 +1058,64 @@ void FunctionTemplate::SetCallHandler(InvocationCallback callback,
 }
 
 
+void FunctionTemplate::SetFastCallHandler(
+    FastCallback callback,
+    FastCallbackType return_type,
+    FastCallbackType receiver_type,
+    int argc,
+    const FastCallbackType* argument_types) {
+  STATIC_ASSERT(static_cast<int>(kFastCallbackVoid) == i::FAST_CALL_VOID);
+  STATIC_ASSERT(static_cast<int>(kFastCallbackInt32) == i::FAST_CALL_INT32);
+  STATIC_ASSERT(static_cast<int>(kFastCallbackDouble) == i::FAST_CALL_DOUBLE);
+  STATIC_ASSERT(static_cast<int>(kFastCallbackBool) == i::FAST_CALL_BOOL);
+  STATIC_ASSERT(
+      static_cast<int>(kFastCallbackExternal) == i::FAST_CALL_EXTERNAL);
+  i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
+  if (IsDeadCheck(isolate, "v8::FunctionTemplate::SetFastCallHandler()")) {
+    return;
+  }
+  const char* location = "v8::FunctionTemplate::SetFastCallHandler()";
+  int parameter_count = argc + (receiver_type == kFastCallbackExternal);
+  if (!ApiCheck(argc >= 0 &&
+                parameter_count <=
+                    i::FunctionTemplateInfo::kMaxFastCallParameters,
+                location,
+                "Too many parameters")) {
+    return;
+  }
+  if (!ApiCheck(return_type != kFastCallbackExternal &&
+                (receiver_type == kFastCallbackVoid ||
+                 receiver_type == kFastCallbackExternal),
+                location,
+                "Unsupported return or receiver type")) {
+    return;
+  }
+  typedef i::FunctionTemplateInfo Info;
+  int signature =
+      Info::FastCallReturnTypeField::encode(
+          static_cast<i::FastCallType>(return_type)) |
+      Info::FastCallReceiverTypeField::encode(
+          static_cast<i::FastCallType>(receiver_type)) |
+      Info::FastCallArgumentCountField::encode(argc);
+  for (int i = 0; i < argc; i++) {
+    if (!ApiCheck(argument_types[i] == kFastCallbackInt32 ||
+                  argument_types[i] == kFastCallbackDouble ||
+                  argument_types[i] == kFastCallbackBool,
+                  location,
+                  "Unsupported argument type")) {
+      return;
+    }
+    signature |= argument_types[i] << (Info::kFastCallArgumentTypesShift +
+                                       i * Info::kFastCallArgumentTypeBits);
+  }
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::Handle<i::FunctionTemplateInfo> info = Utils::OpenHandle(this);
+  SET_FIELD_WRAPPED(info, set_fast_call_function, callback);
+  info->set_fast_call_signature(i::Smi::FromInt(signature));
+}
+
+
 static i::Handle<i::AccessorInfo> MakeAccessorInfo(
       v8::Handle<String> name,
       AccessorGetter getter,
@@ -1460,6 +1518,18 @@ ScriptData* ScriptData::PreCompile(const char* input, int length) {
 }
 
 
+ScriptData* ScriptData::PreCompileInBackground(const char* input,
+                                               int length,
+                                               size_t max_stack_size) {
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const unsigned char*>(input), length);
+  uintptr_t stack_limit =
+      reinterpret_cast<uintptr_t>(&stream) - max_stack_size;
+  return i::ParserApi::PreParseInBackground(&stream, i::FLAG_harmony_scoping,
+                                             stack_limit);
+}
+
+
 ScriptData* ScriptData::PreCompile(v8::Handle<String> source) {
   i::Handle<i::String> str = Utils::OpenHandle(*source);
   if (str->IsExternalTwoByteString()) {
@@ -4298,6 +4368,119 @@ void v8::V8::GetHeapStatistics(HeapStatistics* heap_statistics) {
 }
 
 
+GCEvent::GCEvent(): type_(kGCTypeScavenge),
+                    gc_count_(0),
+                    dropped_before_(0),
+                    start_time_(0),
+                    pause_time_(0),
+                    incremental_time_(0),
+                    incremental_steps_(0),
+                    promoted_size_(0),
+                    freed_size_(0) {
+  for (int i = 0; i < kNumberOfPhases; i++) phase_times_[i] = 0;
+  for (int i = 0; i < kNumberOfSpaces; i++) {
+    space_sizes_before_[i] = 0;
+    space_sizes_after_[i] = 0;
+  }
+}
+
+
+Local<String> v8::V8::GetOptimizationProfile() {
+  i::Isolate* isolate = i::Isolate::Current();
+  if (IsDeadCheck(isolate, "v8::V8::GetOptimizationProfile()")) {
+    return Local<String>();
+  }
+  ENTER_V8(isolate);
+  return Utils::ToLocal(isolate->runtime_profiler()->GetOptimizationProfile());
+}
+
+
+bool v8::V8::LoadOptimizationProfile(Handle<String> profile) {
+  i::Isolate* isolate = i::Isolate::Current();
+  if (IsDeadCheck(isolate, "v8::V8::LoadOptimizationProfile()")) return false;
+  ENTER_V8(isolate);
+  return isolate->runtime_profiler()->LoadOptimizationProfile(
+      Utils::OpenHandle(*profile));
+}
+
+
+DeoptimizationStatistics::DeoptimizationStatistics()
+    : function_name_(NULL),
+      source_hash_(0),
+      start_position_(0) {
+  for (int i = 0; i < kNumberOfBailoutTypes; i++) counts_[i] = 0;
+}
+
+
+int v8::V8::GetDeoptimizationStatistics(DeoptimizationStatistics* statistics,
+                                        int length) {
+  STATIC_ASSERT(
+      static_cast<int>(DeoptimizationStatistics::kNumberOfBailoutTypes) ==
+      i::DeoptimizationStatistics::kBailoutTypeCount);
+  STATIC_ASSERT(static_cast<int>(DeoptimizationStatistics::kEager) ==
+                static_cast<int>(i::Deoptimizer::EAGER));
+  STATIC_ASSERT(static_cast<int>(DeoptimizationStatistics::kOsr) ==
+                static_cast<int>(i::Deoptimizer::OSR));
+  i::Isolate* isolate = i::Isolate::Current();
+  if (!isolate->IsInitialized()) return 0;
+  if (IsDeadCheck(isolate, "v8::V8::GetDeoptimizationStatistics()")) return 0;
+  ENTER_V8(isolate);
+  const i::List<i::DeoptimizationStatistics>& all =
+      isolate->runtime_profiler()->deoptimization_statistics();
+  for (int i = 0; i < all.length() && i < length; i++) {
+    DeoptimizationStatistics* stats = &statistics[i];
+    stats->function_name_ = all[i].name;
+    stats->source_hash_ = all[i].function.source_hash;
+    stats->start_position_ = all[i].function.start_position;
+    for (int j = 0; j < DeoptimizationStatistics::kNumberOfBailoutTypes; j++) {
+      stats->counts_[j] = all[i].counts[j];
+    }
+  }
+  return all.length();
+}
+
+
+int v8::V8::GetGCEvents(v8::Isolate* isolate,
+                        GCEvent* events,
+                        int length) {
+  STATIC_ASSERT(static_cast<int>(GCEvent::kNumberOfPhases) ==
+                static_cast<int>(i::GCTracer::Scope::kNumberOfScopes));
+  STATIC_ASSERT(static_cast<int>(GCEvent::kNumberOfSpaces) ==
+                static_cast<int>(i::LAST_SPACE + 1));
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  if (!internal_isolate->IsInitialized()) return 0;
+  i::GCEventRing* ring = internal_isolate->heap()->gc_events();
+  if (ring == NULL) return 0;
+
+  int count = 0;
+  i::GCEventRecord record;
+  while (count < length && ring->Pop(&record)) {
+    GCEvent* event = &events[count++];
+    event->type_ = record.collector == i::SCAVENGER
+        ? kGCTypeScavenge
+        : kGCTypeMarkSweepCompact;
+    event->gc_count_ = record.gc_count;
+    event->dropped_before_ = record.dropped_before;
+    event->start_time_ = record.start_time;
+    event->pause_time_ = record.pause_time;
+    event->incremental_time_ = record.incremental_time;
+    event->incremental_steps_ = record.incremental_steps;
+    for (int i = 0; i < GCEvent::kNumberOfPhases; i++) {
+      event->phase_times_[i] = record.scopes[i];
+    }
+    event->promoted_size_ = static_cast<size_t>(record.promoted_size);
+    event->freed_size_ = static_cast<size_t>(record.freed_size);
+    for (int i = 0; i < GCEvent::kNumberOfSpaces; i++) {
+      event->space_sizes_before_[i] =
+          static_cast<size_t>(record.space_sizes_before[i]);
+      event->space_sizes_after_[i] =
+          static_cast<size_t>(record.space_sizes_after[i]);
+    }
+  }
+  return count;
+}
+
+
 void v8::V8::VisitExternalResources(ExternalResourceVisitor* visitor) {
   i::Isolate* isolate = i::Isolate::Current();
   IsDeadCheck(isolate, "v8::V8::VisitExternalResources");
@@ -4419,6 +4602,20 @@ Persistent<Context> v8::Context::New(
 }
 
 
+Persistent<Context> v8::Context::Clone() {
+  i::Isolate* isolate = i::Isolate::Current();
+  LOG_API(isolate, "Context::Clone");
+  ON_BAILOUT(isolate, "v8::Context::Clone()", return Persistent<Context>());
+  i::Handle<i::Context> env;
+  {
+    ENTER_V8(isolate);
+    env = isolate->bootstrapper()->CloneEnvironment(isolate,
+                                                    Utils::OpenHandle(this));
+  }
+  return Persistent<Context>(Utils::ToLocal(env));
+}
+
+
 void v8::Context::SetSecurityToken(Handle<Value> token) {
   i::Isolate* isolate = i::Isolate::Current();
   if (IsDeadCheck(isolate, "v8::Context::SetSecurityToken()")) {
@@ -5919,6 +6116,79 @@ const CpuProfileNode* CpuProfileNode::GetChild(int index) const {
 }
 
 
+static const i::SamplingHeapProfiler::Node* ToInternal(
+    const AllocationProfileNode* node) {
+  return reinterpret_cast<const i::SamplingHeapProfiler::Node*>(node);
+}
+
+
+Handle<String> AllocationProfileNode::GetFunctionName() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetFunctionName");
+  return Handle<String>(ToApi<String>(
+      isolate->factory()->LookupAsciiSymbol(ToInternal(this)->name())));
+}
+
+
+Handle<String> AllocationProfileNode::GetScriptResourceName() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetScriptResourceName");
+  return Handle<String>(ToApi<String>(isolate->factory()->LookupAsciiSymbol(
+      ToInternal(this)->resource_name())));
+}
+
+
+int AllocationProfileNode::GetLineNumber() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetLineNumber");
+  return ToInternal(this)->line_number();
+}
+
+
+int AllocationProfileNode::GetSamplesCount() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetSamplesCount");
+  return ToInternal(this)->samples_count();
+}
+
+
+size_t AllocationProfileNode::GetSize() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetSize");
+  return static_cast<size_t>(ToInternal(this)->size());
+}
+
+
+int AllocationProfileNode::GetLiveSamplesCount() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetLiveSamplesCount");
+  return ToInternal(this)->live_samples_count();
+}
+
+
+size_t AllocationProfileNode::GetLiveSize() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetLiveSize");
+  return static_cast<size_t>(ToInternal(this)->live_size());
+}
+
+
+int AllocationProfileNode::GetChildrenCount() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetChildrenCount");
+  return ToInternal(this)->children()->length();
+}
+
+
+const AllocationProfileNode* AllocationProfileNode::GetChild(int index) const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetChild");
+  const i::SamplingHeapProfiler::Node* child =
+      ToInternal(this)->children()->at(index);
+  return reinterpret_cast<const AllocationProfileNode*>(child);
+}
+
+
 void CpuProfile::Delete() {
   i::Isolate* isolate = i::Isolate::Current();
   IsDeadCheck(isolate, "v8::CpuProfile::Delete");
@@ -6272,6 +6542,14 @@ const HeapSnapshot* HeapProfiler::TakeSnapshot(Handle<String> title,
 }
 
 
+bool HeapProfiler::StreamSnapshot(OutputStream* stream,
+                                  ActivityControl* control) {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StreamSnapshot");
+  return i::HeapProfiler::StreamSnapshot(stream, control);
+}
+
+
 void HeapProfiler::StartHeapObjectsTracking() {
   i::Isolate* isolate = i::Isolate::Current();
   IsDeadCheck(isolate, "v8::HeapProfiler::StartHeapObjectsTracking");
@@ -6300,6 +6578,29 @@ void HeapProfiler::DeleteAllSnapshots() {
 }
 
 
+bool HeapProfiler::StartSamplingHeapProfiler(int sample_interval) {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StartSamplingHeapProfiler");
+  ASSERT(sample_interval > 0);
+  return i::HeapProfiler::StartSamplingHeapProfiler(sample_interval);
+}
+
+
+const AllocationProfileNode* HeapProfiler::GetAllocationProfileRoot() {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::GetAllocationProfileRoot");
+  return reinterpret_cast<const AllocationProfileNode*>(
+      i::HeapProfiler::GetAllocationProfileRoot());
+}
+
+
+void HeapProfiler::StopSamplingHeapProfiler() {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StopSamplingHeapProfiler");
+  i::HeapProfiler::StopSamplingHeapProfiler();
+}
+
+
 void HeapProfiler::DefineWrapperClass(uint16_t class_id,
                                       WrapperInfoCallback callback) {
   i::Isolate::Current()->heap_profiler()->DefineWrapperClass(class_id,
@@ -162,6 +162,15 @@ void FullCodeGenerator::Generate() {
   // the frame (that is done below).
   FrameScope frame_scope(masm_, StackFrame::MANUAL);
 
+  // There is no code age sequence to patch on this architecture, so
+  // running the function makes its code young again by clearing the age.
+  if (FLAG_flush_code && info->scope()->is_function_scope()) {
+    __ ldr(r2, FieldMemOperand(r1, JSFunction::kSharedFunctionInfoOffset));
+    __ ldr(r3, FieldMemOperand(r2, SharedFunctionInfo::kCompilerHintsOffset));
+    __ bic(r3, r3, Operand(SharedFunctionInfo::kCodeAgeRawMask));
+    __ str(r3, FieldMemOperand(r2, SharedFunctionInfo::kCompilerHintsOffset));
+  }
+
   int locals_count = info->scope()->num_stack_slots();
 
   __ Push(lr, fp, cp, r1);
@@ -128,6 +128,7 @@ class LCodeGen;
   V(LoadKeyedFastElement)                       \
   V(LoadKeyedGeneric)                           \
   V(LoadKeyedSpecializedArrayElement)           \
+  V(LoadNamedDoubleField)                       \
   V(LoadNamedField)                             \
   V(LoadNamedFieldPolymorphic)                  \
   V(LoadNamedGeneric)                           \
@@ -158,6 +159,7 @@ class LCodeGen;
   V(StoreKeyedFastElement)                      \
   V(StoreKeyedGeneric)                          \
   V(StoreKeyedSpecializedArrayElement)          \
+  V(StoreNamedDoubleField)                      \
   V(StoreNamedField)                            \
   V(StoreNamedGeneric)                          \
   V(StringAdd)                                  \
@@ -1168,6 +1170,17 @@ class LReturn: public LTemplateInstruction<0, 1, 0> {
 };
 
 
+class LLoadNamedDoubleField: public LTemplateInstruction<1, 1, 0> {
+ public:
+  explicit LLoadNamedDoubleField(LOperand* object) {
+    inputs_[0] = object;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LoadNamedDoubleField, "load-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(LoadNamedDoubleField)
+};
+
+
 class LLoadNamedField: public LTemplateInstruction<1, 1, 0> {
  public:
   explicit LLoadNamedField(LOperand* object) {
@@ -1723,6 +1736,28 @@ class LStoreNamedField: public LTemplateInstruction<0, 2, 1> {
 };
 
 
+class LStoreNamedDoubleField: public LTemplateInstruction<0, 2, 0> {
+ public:
+  LStoreNamedDoubleField(LOperand* obj, LOperand* val) {
+    inputs_[0] = obj;
+    inputs_[1] = val;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreNamedDoubleField,
+                               "store-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(StoreNamedDoubleField)
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  LOperand* object() { return inputs_[0]; }
+  LOperand* value() { return inputs_[1]; }
+
+  Handle<Object> name() const { return hydrogen()->name(); }
+  bool is_in_object() { return hydrogen()->is_in_object(); }
+  int offset() { return hydrogen()->offset(); }
+};
+
+
 class LStoreNamedGeneric: public LTemplateInstruction<0, 2, 0> {
  public:
   LStoreNamedGeneric(LOperand* obj, LOperand* val) {
@@ -477,7 +477,7 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   if (environment == NULL) return;
 
   // The translation includes one command per value in the environment.
-  int translation_size = environment->values()->length();
+  int translation_size = environment->translation_size();
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
@@ -501,6 +501,21 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   }
   for (int i = 0; i < translation_size; ++i) {
     LOperand* value = environment->values()->at(i);
+    const LEnvironment::CapturedObject* captured =
+        environment->CapturedObjectAt(i);
+    if (captured != NULL) {
+      translation->StoreCapturedObject(
+          DefineDeoptimizationLiteral(captured->map),
+          captured->id,
+          captured->field_count);
+      for (int j = 0; j < captured->field_count; ++j) {
+        int field = captured->first_field + j;
+        AddToTranslation(translation,
+                         environment->values()->at(field),
+                         environment->HasTaggedValueAt(field));
+      }
+      continue;
+    }
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
     if (environment->spilled_registers() != NULL && value != NULL) {
@@ -2625,6 +2640,20 @@ void LCodeGen::DoStoreContextSlot(LStoreContextSlot* instr) {
 }
 
 
+void LCodeGen::DoLoadNamedDoubleField(LLoadNamedDoubleField* instr) {
+  Register object = ToRegister(instr->InputAt(0));
+  DwVfpRegister result = ToDoubleRegister(instr->result());
+  Register scratch = scratch0();
+  if (instr->hydrogen()->is_in_object()) {
+    __ ldr(scratch, FieldMemOperand(object, instr->hydrogen()->offset()));
+  } else {
+    __ ldr(scratch, FieldMemOperand(object, JSObject::kPropertiesOffset));
+    __ ldr(scratch, FieldMemOperand(scratch, instr->hydrogen()->offset()));
+  }
+  __ vldr(result, FieldMemOperand(scratch, HeapNumber::kValueOffset));
+}
+
+
 void LCodeGen::DoLoadNamedField(LLoadNamedField* instr) {
   Register object = ToRegister(instr->InputAt(0));
   Register result = ToRegister(instr->result());
@@ -3815,6 +3844,20 @@ void LCodeGen::DoCallRuntime(LCallRuntime* instr) {
 }
 
 
+void LCodeGen::DoStoreNamedDoubleField(LStoreNamedDoubleField* instr) {
+  Register object = ToRegister(instr->object());
+  DwVfpRegister value = ToDoubleRegister(instr->value());
+  Register scratch = scratch0();
+  if (instr->is_in_object()) {
+    __ ldr(scratch, FieldMemOperand(object, instr->offset()));
+  } else {
+    __ ldr(scratch, FieldMemOperand(object, JSObject::kPropertiesOffset));
+    __ ldr(scratch, FieldMemOperand(scratch, instr->offset()));
+  }
+  __ vstr(value, FieldMemOperand(scratch, HeapNumber::kValueOffset));
+}
+
+
 void LCodeGen::DoStoreNamedField(LStoreNamedField* instr) {
   Register object = ToRegister(instr->object());
   Register value = ToRegister(instr->value());
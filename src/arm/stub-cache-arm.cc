@@ -341,6 +341,32 @@ void StubCompiler::GenerateFastPropertyLoad(MacroAssembler* masm,
 }
 
 
+// Allocate a heap number in |result| without a register for its map.
+static void GenerateAllocateHeapNumber(MacroAssembler* masm,
+                                       Register result,
+                                       Register scratch1,
+                                       Register scratch2,
+                                       Label* gc_required) {
+  __ AllocateInNewSpace(HeapNumber::kSize, result, scratch1, scratch2,
+                        gc_required, TAG_OBJECT);
+  __ LoadRoot(scratch1, Heap::kHeapNumberMapRootIndex);
+  __ str(scratch1, FieldMemOperand(result, HeapObject::kMapOffset));
+}
+
+
+// Copy the value of the heap number in |source| into the heap number in
+// |target|.
+static void GenerateCopyHeapNumberValue(MacroAssembler* masm,
+                                        Register source,
+                                        Register target,
+                                        Register scratch) {
+  __ ldr(scratch, FieldMemOperand(source, HeapNumber::kMantissaOffset));
+  __ str(scratch, FieldMemOperand(target, HeapNumber::kMantissaOffset));
+  __ ldr(scratch, FieldMemOperand(source, HeapNumber::kExponentOffset));
+  __ str(scratch, FieldMemOperand(target, HeapNumber::kExponentOffset));
+}
+
+
 void StubCompiler::GenerateLoadArrayLength(MacroAssembler* masm,
                                            Register receiver,
                                            Register scratch,
@@ -494,6 +520,13 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
   // checks.
   ASSERT(object->IsJSGlobalProxy() || !object->IsAccessCheckNeeded());
 
+  // Double fields only hold heap numbers, anything else goes to the runtime.
+  bool is_double_field = IsDoubleField(object, name, transition);
+  if (is_double_field) {
+    __ CheckMap(r0, scratch1, Heap::kHeapNumberMapRootIndex, miss_label,
+                DO_SMI_CHECK);
+  }
+
   // Perform map transition for the receiver if necessary.
   if (!transition.is_null() && (object->map()->unused_property_fields() == 0)) {
     // The properties must be extended before we can store the value.
@@ -509,6 +542,21 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
     return;
   }
 
+  // The value written to the field; a new double field gets its own copy.
+  Register value_reg = r0;
+  if (is_double_field && !transition.is_null()) {
+    Label allocated, gc_required;
+    GenerateAllocateHeapNumber(masm, scratch2, scratch1, name_reg,
+                               &gc_required);
+    __ b(&allocated);
+    __ bind(&gc_required);
+    __ mov(name_reg, Operand(name));  // Restore the name for the miss handler.
+    __ jmp(miss_label);
+    __ bind(&allocated);
+    GenerateCopyHeapNumberValue(masm, r0, scratch2, scratch1);
+    value_reg = scratch2;
+  }
+
   if (!transition.is_null()) {
     // Update the map of the object.
     __ mov(scratch1, Operand(transition));
@@ -526,6 +574,14 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
                         OMIT_SMI_CHECK);
   }
 
+  if (is_double_field && transition.is_null()) {
+    // Update the field's heap number in place; no write barrier needed.
+    GenerateFastPropertyLoad(masm, scratch1, receiver_reg, object, index);
+    GenerateCopyHeapNumberValue(masm, r0, scratch1, scratch2);
+    __ Ret();
+    return;
+  }
+
   // Adjust for the number of properties stored in the object. Even in the
   // face of a transition we can use the old map here because the size of the
   // object and the number of in-object properties is not going to change.
@@ -534,14 +590,14 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
   if (index < 0) {
     // Set the property straight into the object.
     int offset = object->map()->instance_size() + (index * kPointerSize);
-    __ str(r0, FieldMemOperand(receiver_reg, offset));
+    __ str(value_reg, FieldMemOperand(receiver_reg, offset));
 
     // Skip updating write barrier if storing a smi.
-    __ JumpIfSmi(r0, &exit);
+    __ JumpIfSmi(value_reg, &exit);
 
     // Update the write barrier for the array address.
     // Pass the now unused name_reg as a scratch register.
-    __ mov(name_reg, r0);
+    __ mov(name_reg, value_reg);
     __ RecordWriteField(receiver_reg,
                         offset,
                         name_reg,
@@ -554,14 +610,14 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
     // Get the properties array
     __ ldr(scratch1,
            FieldMemOperand(receiver_reg, JSObject::kPropertiesOffset));
-    __ str(r0, FieldMemOperand(scratch1, offset));
+    __ str(value_reg, FieldMemOperand(scratch1, offset));
 
     // Skip updating write barrier if storing a smi.
-    __ JumpIfSmi(r0, &exit);
+    __ JumpIfSmi(value_reg, &exit);
 
     // Update the write barrier for the array address.
     // Ok to clobber receiver_reg and name_reg, since we return.
-    __ mov(name_reg, r0);
+    __ mov(name_reg, value_reg);
     __ RecordWriteField(scratch1,
                         offset,
                         name_reg,
@@ -1203,6 +1259,17 @@ void StubCompiler::GenerateLoadField(Handle<JSObject> object,
   // Check that the maps haven't changed.
   Register reg = CheckPrototypes(
       object, receiver, holder, scratch1, scratch2, scratch3, name, miss);
+  if (IsDoubleField(holder, name, Handle<Map>::null())) {
+    // The heap number of a double field is updated in place, so hand out a
+    // copy. The IC only compiles these loads for own fields.
+    ASSERT(holder.is_identical_to(object));
+    GenerateAllocateHeapNumber(masm(), scratch3, scratch1, scratch2, miss);
+    GenerateFastPropertyLoad(masm(), scratch1, reg, holder, index);
+    GenerateCopyHeapNumberValue(masm(), scratch1, scratch3, scratch2);
+    __ mov(r0, scratch3);
+    __ Ret();
+    return;
+  }
   GenerateFastPropertyLoad(masm(), r0, reg, holder, index);
   __ Ret();
 }
@@ -1345,7 +1412,7 @@ void StubCompiler::GenerateLoadInterceptor(Handle<JSObject> object,
   bool compile_followup_inline = false;
   if (lookup->IsFound() && lookup->IsCacheable()) {
     if (lookup->IsField()) {
-      compile_followup_inline = true;
+      compile_followup_inline = !lookup->GetPropertyDetails().IsDoubleField();
     } else if (lookup->type() == CALLBACKS &&
                lookup->GetCallbackObject()->IsAccessorInfo()) {
       AccessorInfo* callback = AccessorInfo::cast(lookup->GetCallbackObject());
@@ -38,7 +38,9 @@
 #include "macro-assembler.h"
 #include "natives.h"
 #include "objects-visiting.h"
+#include "parser.h"
 #include "platform.h"
+#include "scanner-character-streams.h"
 #include "snapshot.h"
 #include "extensions/externalize-string-extension.h"
 #include "extensions/gc-extension.h"
@@ -92,6 +94,28 @@ Handle<String> Bootstrapper::NativesSourceLookup(int index) {
 }
 
 
+Handle<String> Bootstrapper::ExperimentalNativesSourceLookup(int index) {
+  ASSERT(0 <= index && index < ExperimentalNatives::GetBuiltinsCount());
+  Isolate* isolate = Isolate::Current();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  int cache_index = Natives::GetBuiltinsCount() + index;
+  if (heap->natives_source_cache()->get(cache_index)->IsUndefined()) {
+    // Like the natives, every context and isolate shares the static source.
+    Vector<const char> source = ExperimentalNatives::GetRawScriptSource(index);
+    NativesExternalStringResource* resource =
+        new NativesExternalStringResource(this,
+                                          source.start(),
+                                          source.length());
+    Handle<String> source_code =
+        factory->NewExternalStringFromAscii(resource);
+    heap->natives_source_cache()->set(cache_index, *source_code);
+  }
+  Handle<Object> cached_source(heap->natives_source_cache()->get(cache_index));
+  return Handle<String>::cast(cached_source);
+}
+
+
 void Bootstrapper::Initialize(bool create_heap_objects) {
   extensions_cache_.Initialize(create_heap_objects);
   GCExtension::Register();
@@ -208,6 +232,7 @@ class Genesis BASE_EMBEDDED {
   bool InstallNatives();
   bool InstallExperimentalNatives();
   void InstallBuiltinFunctionIds();
+  void InstallExperimentalBuiltinFunctionIds();
   void InstallJSFunctionResultCaches();
   void InitializeNormalizedMapCaches();
 
@@ -268,11 +293,14 @@ class Genesis BASE_EMBEDDED {
 
   static bool CompileBuiltin(Isolate* isolate, int index);
   static bool CompileExperimentalBuiltin(Isolate* isolate, int index);
-  static bool CompileNative(Vector<const char> name, Handle<String> source);
+  static bool CompileNative(Vector<const char> name,
+                            Handle<String> source,
+                            ScriptDataImpl* pre_data);
   static bool CompileScriptCached(Vector<const char> name,
                                   Handle<String> source,
                                   SourceCodeCache* cache,
                                   v8::Extension* extension,
+                                  ScriptDataImpl* pre_data,
                                   Handle<Context> top_context,
                                   bool use_runtime_context);
 
@@ -671,6 +699,270 @@ static void AddToWeakGlobalContextList(Context* context) {
 }
 
 
+// Deep-copies the object graph reachable from a global context.  Objects
+// that never hold context-specific state (strings, oddballs, code, shared
+// function infos, scripts, API templates, copy-on-write arrays, scope
+// infos and the objects in the root list) are shared with the original;
+// everything else is copied and its references remapped.
+// Accessor infos carry embedder data from the context and are copied.
+// Heap numbers may be the mutable boxes of double fields, and byte arrays
+// and external arrays hold mutable raw data, so they are copied too; an
+// external array gets its own copy of the backing store, freed when the
+// copy dies.  Each copied global context gets a fresh random seed.
+// Shared function infos are copied while they track the in-object slack
+// of their constructor's initial map, so the copy tracks the copied map.
+//
+// The copy is done in a single pass without allocation retries, so no
+// GC may move objects while it is in progress.
+class EnvironmentCloner : public ObjectVisitor {
+ public:
+  explicit EnvironmentCloner(Heap* heap)
+      : heap_(heap),
+        copies_(new HashMap(&AddressMatch)),
+        host_(NULL) {
+    // Objects in the instanceof cache may belong to the original context
+    // and must not be shared through the root list below.
+    heap_->CompletelyClearInstanceofCache();
+    Object** roots = heap_->roots_array_start();
+    for (int i = 0; i < Heap::kStrongRootListLength; i++) {
+      if (roots[i]->IsHeapObject()) {
+        HeapObject* root = HeapObject::cast(roots[i]);
+        copies_->Lookup(root, Hash(root), true)->value = root;
+      }
+    }
+  }
+
+  ~EnvironmentCloner() { delete copies_; }
+
+  Context* Clone(Context* context) {
+    Context* result = Context::cast(Copy(context));
+    while (!worklist_.is_empty()) {
+      host_ = worklist_.RemoveLast();
+      host_->IterateBody(host_->map()->instance_type(), host_->Size(), this);
+    }
+    host_ = NULL;
+    // The weak list link of a copy is only set once its slots have been
+    // visited; visiting it would map the original back to the copy.
+    for (int i = 0; i < global_contexts_.length(); i++) {
+      AddToWeakGlobalContextList(global_contexts_[i]);
+    }
+    return result;
+  }
+
+  // Every slot needs the write barrier, including those left pointing at
+  // shared objects: the copy was filled by a raw block copy into old space
+  // and shared strings and numbers may still be in new space.
+  void VisitPointers(Object** start, Object** end) {
+    for (Object** p = start; p < end; p++) {
+      if (!(*p)->IsHeapObject()) continue;
+      HeapObject* copy = Copy(HeapObject::cast(*p));
+      *p = copy;
+      RecordWrite(p, copy);
+    }
+  }
+
+  // The code of a copied function is shared and reset explicitly.
+  void VisitCodeEntry(Address entry_address) { }
+
+ private:
+  static bool AddressMatch(void* key1, void* key2) { return key1 == key2; }
+
+  static uint32_t Hash(HeapObject* object) {
+    return ComputePointerHash(object);
+  }
+
+  bool IsShared(HeapObject* object) {
+    Map* map = object->map();
+    if (map == heap_->fixed_cow_array_map() ||
+        map == heap_->scope_info_map()) {
+      return true;
+    }
+    InstanceType type = map->instance_type();
+    if (type < FIRST_NONSTRING_TYPE) return true;
+    switch (type) {
+      case HEAP_NUMBER_TYPE:
+      case BYTE_ARRAY_TYPE:
+      case FIXED_ARRAY_TYPE:
+      case FIXED_DOUBLE_ARRAY_TYPE:
+      case MAP_TYPE:
+      case JS_GLOBAL_PROPERTY_CELL_TYPE:
+      case ACCESSOR_PAIR_TYPE:
+      case ACCESSOR_INFO_TYPE:
+      case ALIASED_ARGUMENTS_ENTRY_TYPE:
+        return false;
+      case SHARED_FUNCTION_INFO_TYPE:
+        return !SharedFunctionInfo::cast(object)->
+            IsInobjectSlackTrackingInProgress();
+      default:
+        if (type >= FIRST_EXTERNAL_ARRAY_TYPE &&
+            type <= LAST_EXTERNAL_ARRAY_TYPE) {
+          return false;
+        }
+        return type < FIRST_JS_RECEIVER_TYPE;
+    }
+  }
+
+  static int ExternalArrayElementSize(InstanceType type) {
+    switch (type) {
+      case EXTERNAL_BYTE_ARRAY_TYPE:
+      case EXTERNAL_UNSIGNED_BYTE_ARRAY_TYPE:
+      case EXTERNAL_PIXEL_ARRAY_TYPE:
+        return 1;
+      case EXTERNAL_SHORT_ARRAY_TYPE:
+      case EXTERNAL_UNSIGNED_SHORT_ARRAY_TYPE:
+        return 2;
+      case EXTERNAL_INT_ARRAY_TYPE:
+      case EXTERNAL_UNSIGNED_INT_ARRAY_TYPE:
+      case EXTERNAL_FLOAT_ARRAY_TYPE:
+        return 4;
+      case EXTERNAL_DOUBLE_ARRAY_TYPE:
+        return 8;
+      default:
+        UNREACHABLE();
+        return 0;
+    }
+  }
+
+  static void FreeExternalArrayData(v8::Persistent<v8::Value> handle,
+                                    void* data) {
+    free(data);
+    Isolate::Current()->global_handles()->Destroy(
+        Utils::OpenHandle(*handle).location());
+  }
+
+  // The copy owns a copy of the original's backing store.
+  void CopyExternalArrayData(ExternalArray* copy) {
+    int length = copy->length() *
+        ExternalArrayElementSize(copy->map()->instance_type());
+    if (length == 0) return;
+    void* data = malloc(length);
+    if (data == NULL) {
+      V8::FatalProcessOutOfMemory("Bootstrapper::CloneEnvironment");
+    }
+    memcpy(data, copy->external_pointer(), length);
+    copy->set_external_pointer(data);
+    GlobalHandles* global_handles = heap_->isolate()->global_handles();
+    Handle<Object> handle = global_handles->Create(copy);
+    global_handles->MakeWeak(handle.location(), data, &FreeExternalArrayData);
+  }
+
+  // Math.random must not continue the original's sequence.  A zeroed
+  // seed is filled from the entropy source on first use.
+  void ResetRandomSeed(Context* context) {
+    Object* result;
+    { MaybeObject* maybe_result =
+          heap_->AllocateByteArray(kRandomStateSize, TENURED);
+      if (!maybe_result->ToObject(&result)) {
+        V8::FatalProcessOutOfMemory("Bootstrapper::CloneEnvironment");
+      }
+    }
+    ByteArray* seed = ByteArray::cast(result);
+    memset(seed->GetDataStartAddress(), 0, kRandomStateSize);
+    copies_->Lookup(seed, Hash(seed), true)->value = seed;
+    context->set_random_seed(seed);
+  }
+
+  HeapObject* Copy(HeapObject* object) {
+    HashMap::Entry* entry = copies_->Lookup(object, Hash(object), true);
+    if (entry->value != NULL) {
+      return reinterpret_cast<HeapObject*>(entry->value);
+    }
+    if (IsShared(object)) {
+      entry->value = object;
+      return object;
+    }
+
+    InstanceType type = object->map()->instance_type();
+    int size = object->Size();
+    AllocationSpace space;
+    if (type == MAP_TYPE) {
+      space = MAP_SPACE;
+    } else if (type == JS_GLOBAL_PROPERTY_CELL_TYPE) {
+      space = CELL_SPACE;
+    } else if (size > Page::kMaxNonCodeHeapObjectSize) {
+      space = LO_SPACE;
+    } else {
+      space = heap_->TargetSpaceId(type);
+    }
+    Object* result;
+    { MaybeObject* maybe_result = heap_->AllocateRaw(size, space, space);
+      if (!maybe_result->ToObject(&result)) {
+        V8::FatalProcessOutOfMemory("Bootstrapper::CloneEnvironment");
+      }
+    }
+    HeapObject* copy = HeapObject::cast(result);
+    heap_->CopyBlock(copy->address(), object->address(), size);
+    // The lookup above may have been invalidated by a resize.
+    copies_->Lookup(object, Hash(object), true)->value = copy;
+
+    // Drop the state that only makes sense for the original: weak list
+    // links, caches keyed on the original's maps and optimized code.
+    Object* undefined = heap_->undefined_value();
+    if (type == MAP_TYPE) {
+      Map::cast(copy)->set_code_cache(heap_->empty_fixed_array());
+    } else if (type == JS_FUNCTION_TYPE) {
+      JSFunction* function = JSFunction::cast(copy);
+      Code* code = function->shared()->is_compiled()
+          ? function->shared()->code()
+          : function->code();
+      function->set_code(code);
+      function->set_next_function_link(undefined);
+    } else if (type == SHARED_FUNCTION_INFO_TYPE) {
+      // Optimized code is specialized to the original context.
+      SharedFunctionInfo::cast(copy)->ClearOptimizedCodeMap();
+    } else if (copy->IsGlobalContext()) {
+      Context* context = Context::cast(copy);
+      context->set(Context::OPTIMIZED_FUNCTIONS_LIST, undefined);
+      context->set(Context::MAP_CACHE_INDEX, undefined);
+      context->set(Context::NEXT_CONTEXT_LINK, undefined);
+      ResetRandomSeed(context);
+      global_contexts_.Add(context);
+    } else if (type >= FIRST_EXTERNAL_ARRAY_TYPE &&
+               type <= LAST_EXTERNAL_ARRAY_TYPE) {
+      CopyExternalArrayData(ExternalArray::cast(copy));
+    }
+
+    copy->set_map(Map::cast(Copy(object->map())));
+    worklist_.Add(copy);
+    return copy;
+  }
+
+  // Same as the WRITE_BARRIER macro, for a slot of the current host.
+  // Global property cells do not use the write barrier: the scavenger
+  // visits the whole cell space.
+  void RecordWrite(Object** slot, HeapObject* value) {
+    if (host_->IsJSGlobalPropertyCell()) return;
+    heap_->incremental_marking()->RecordWrite(host_, slot, value);
+    if (heap_->InNewSpace(value)) {
+      heap_->RecordWrite(host_->address(),
+                         static_cast<int>(reinterpret_cast<Address>(slot) -
+                                          host_->address()));
+    }
+  }
+
+  Heap* heap_;
+  HashMap* copies_;
+  List<HeapObject*> worklist_;
+  List<Context*> global_contexts_;
+  HeapObject* host_;
+  AlwaysAllocateScope always_allocate_;
+  DISALLOW_COPY_AND_ASSIGN(EnvironmentCloner);
+};
+
+
+Handle<Context> Bootstrapper::CloneEnvironment(Isolate* isolate,
+                                               Handle<Context> env) {
+  ASSERT(env->IsGlobalContext());
+  HandleScope scope;
+  Context* copy;
+  { EnvironmentCloner cloner(isolate->heap());
+    copy = cloner.Clone(*env);
+  }
+  isolate->counters()->contexts_created_by_cloning()->Increment();
+  return Handle<Context>::cast(isolate->global_handles()->Create(copy));
+}
+
+
 void Genesis::CreateRoots() {
   // Allocate the global context FixedArray first and then patch the
   // closure and extension object later (we need the empty function
@@ -1280,25 +1572,60 @@ void Genesis::InitializeExperimentalGlobal() {
 }
 
 
+// Preparse data for the natives scripts. The scripts are static, so each
+// of them is preparsed once per process and the data is shared by all
+// isolates. It lets the parser skip the bodies of the natives functions,
+// which are compiled when they are first called.
+static LazyMutex natives_preparse_mutex = LAZY_MUTEX_INITIALIZER;
+static ScriptDataImpl** natives_preparse_data = NULL;
+
+
+static ScriptDataImpl* NativesPreparseData(Isolate* isolate, int index) {
+  if (!FLAG_lazy || !FLAG_lazy_natives) return NULL;
+  ScopedLock lock(natives_preparse_mutex.Pointer());
+  if (natives_preparse_data == NULL) {
+    int count = Natives::GetBuiltinsCount();
+    natives_preparse_data = NewArray<ScriptDataImpl*>(count);
+    for (int i = 0; i < count; i++) natives_preparse_data[i] = NULL;
+  }
+  if (natives_preparse_data[index] == NULL) {
+    Vector<const char> source = Natives::GetRawScriptSource(index);
+    Utf8ToUtf16CharacterStream stream(
+        reinterpret_cast<const byte*>(source.start()), source.length());
+    ScriptDataImpl* data = ParserApi::PreParseInBackground(
+        &stream, kAllowNativesSyntax, isolate->stack_guard()->real_climit());
+    // On stack overflow the script is parsed eagerly this time and
+    // preparsing is retried on the next use.
+    if (data == NULL) return NULL;
+    ASSERT(!data->HasError());
+    natives_preparse_data[index] = data;
+  }
+  return natives_preparse_data[index]->NewView();
+}
+
+
 bool Genesis::CompileBuiltin(Isolate* isolate, int index) {
   Vector<const char> name = Natives::GetScriptName(index);
   Handle<String> source_code =
       isolate->bootstrapper()->NativesSourceLookup(index);
-  return CompileNative(name, source_code);
+  ScriptDataImpl* pre_data = NativesPreparseData(isolate, index);
+  bool result = CompileNative(name, source_code, pre_data);
+  delete pre_data;
+  return result;
 }
 
 
 bool Genesis::CompileExperimentalBuiltin(Isolate* isolate, int index) {
   Vector<const char> name = ExperimentalNatives::GetScriptName(index);
-  Factory* factory = isolate->factory();
   Handle<String> source_code =
-      factory->NewStringFromAscii(
-          ExperimentalNatives::GetRawScriptSource(index));
-  return CompileNative(name, source_code);
+      isolate->bootstrapper()->ExperimentalNativesSourceLookup(index);
+  return CompileNative(name, source_code, NULL);
 }
 
 
-bool Genesis::CompileNative(Vector<const char> name, Handle<String> source) {
+bool Genesis::CompileNative(Vector<const char> name,
+                            Handle<String> source,
+                            ScriptDataImpl* pre_data) {
   HandleScope scope;
   Isolate* isolate = source->GetIsolate();
 #ifdef ENABLE_DEBUGGER_SUPPORT
@@ -1314,6 +1641,7 @@ bool Genesis::CompileNative(Vector<const char> name, Handle<String> source) {
                                     source,
                                     NULL,
                                     NULL,
+                                    pre_data,
                                     Handle<Context>(isolate->context()),
                                     true);
   ASSERT(isolate->has_pending_exception() != result);
@@ -1329,6 +1657,7 @@ bool Genesis::CompileScriptCached(Vector<const char> name,
                                   Handle<String> source,
                                   SourceCodeCache* cache,
                                   v8::Extension* extension,
+                                  ScriptDataImpl* pre_data,
                                   Handle<Context> top_context,
                                   bool use_runtime_context) {
   Factory* factory = source->GetIsolate()->factory();
@@ -1346,7 +1675,7 @@ bool Genesis::CompileScriptCached(Vector<const char> name,
         0,
         0,
         extension,
-        NULL,
+        pre_data,
         Handle<String>::null(),
         use_runtime_context ? NATIVES_CODE : NOT_NATIVES_CODE);
     if (function_info.is_null()) return false;
@@ -1823,6 +2152,7 @@ bool Genesis::InstallExperimentalNatives() {
   }
 
   InstallExperimentalNativeFunctions();
+  InstallExperimentalBuiltinFunctionIds();
 
   return true;
 }
@@ -1872,6 +2202,22 @@ void Genesis::InstallBuiltinFunctionIds() {
 }
 
 
+void Genesis::InstallExperimentalBuiltinFunctionIds() {
+  HandleScope scope;
+#define INSTALL_BUILTIN_ID(holder_expr, fun_name, name) \
+  {                                                     \
+    Handle<JSObject> holder = ResolveBuiltinIdHolder(   \
+        global_context(), #holder_expr);                \
+    BuiltinFunctionId id = k##name;                     \
+    InstallBuiltinFunctionId(holder, #fun_name, id);    \
+  }
+  if (FLAG_harmony_collections) {
+    HARMONY_COLLECTIONS_FUNCTIONS_WITH_ID_LIST(INSTALL_BUILTIN_ID)
+  }
+#undef INSTALL_BUILTIN_ID
+}
+
+
 // Do not forget to update macros.py with named constant
 // of cache id.
 #define JSFUNCTION_RESULT_CACHE_LIST(F) \
@@ -2094,6 +2440,7 @@ bool Genesis::InstallExtension(v8::RegisteredExtension* current,
       source_code,
       isolate->bootstrapper()->extensions_cache(),
       extension,
+      NULL,
       Handle<Context>(isolate->context()),
       false);
   ASSERT(isolate->has_pending_exception() != result);
@@ -2190,6 +2537,10 @@ void Genesis::TransferNamedProperties(Handle<JSObject> from,
           Handle<String> key = Handle<String>(descs->GetKey(i));
           int index = descs->GetFieldIndex(i);
           Handle<Object> value = Handle<Object>(from->FastPropertyAt(index));
+          // Do not share the mutable box of a double field.
+          if (details.IsDoubleField()) {
+            value = factory()->NewHeapNumber(value->Number());
+          }
           CHECK_NOT_EMPTY_HANDLE(to->GetIsolate(),
                                  JSObject::SetLocalPropertyIgnoreAttributes(
                                      to, key, value, details.attributes()));
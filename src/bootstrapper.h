@@ -100,6 +100,11 @@ class Bootstrapper {
       v8::Handle<v8::ObjectTemplate> global_template,
       v8::ExtensionConfiguration* extensions);
 
+  // Creates a copy of an existing JavaScript Global Context, including its
+  // global object and everything reachable from it.  The returned value is
+  // a global handle.
+  Handle<Context> CloneEnvironment(Isolate* isolate, Handle<Context> env);
+
   // Detach the environment from its outer global object.
   void DetachGlobal(Handle<Context> env);
 
@@ -109,8 +114,9 @@ class Bootstrapper {
   // Traverses the pointers for memory management.
   void Iterate(ObjectVisitor* v);
 
-  // Accessor for the native scripts source code.
+  // Accessors for the native scripts source code.
   Handle<String> NativesSourceLookup(int index);
+  Handle<String> ExperimentalNativesSourceLookup(int index);
 
   // Tells whether bootstrapping is active.
   bool IsActive() const { return nesting_ != 0; }
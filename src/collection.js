@@ -88,6 +88,31 @@ function SetDelete(key) {
 }
 
 
+function SetForEach(f, receiver) {
+  if (!IS_SET(this)) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ['Set.prototype.forEach', this]);
+  }
+  if (!IS_SPEC_FUNCTION(f)) {
+    throw MakeTypeError('called_non_callable', [f]);
+  }
+  if (IS_NULL_OR_UNDEFINED(receiver)) {
+    receiver = %GetDefaultReceiver(f) || receiver;
+  } else if (!IS_SPEC_OBJECT(receiver)) {
+    receiver = ToObject(receiver);
+  }
+  // Walk the table in insertion order, so that values added by the
+  // callback are visited and values removed before being reached are not.
+  var iterator = %SetIterationStart(this);
+  var entry;
+  while ((entry = %SetNextEntry(this, iterator)) >= 0) {
+    var value = %SetKeyAt(this, entry);
+    if (value === undefined_sentinel) value = void 0;
+    %_CallFunction(receiver, value, value, this, f);
+  }
+}
+
+
 function MapConstructor() {
   if (%_IsConstructCall()) {
     %MapInitialize(this);
@@ -145,6 +170,31 @@ function MapDelete(key) {
 }
 
 
+function MapForEach(f, receiver) {
+  if (!IS_MAP(this)) {
+    throw MakeTypeError('incompatible_method_receiver',
+                        ['Map.prototype.forEach', this]);
+  }
+  if (!IS_SPEC_FUNCTION(f)) {
+    throw MakeTypeError('called_non_callable', [f]);
+  }
+  if (IS_NULL_OR_UNDEFINED(receiver)) {
+    receiver = %GetDefaultReceiver(f) || receiver;
+  } else if (!IS_SPEC_OBJECT(receiver)) {
+    receiver = ToObject(receiver);
+  }
+  // Walk the table in insertion order, so that entries added by the
+  // callback are visited and entries removed before being reached are not.
+  var iterator = %MapIterationStart(this);
+  var entry;
+  while ((entry = %MapNextEntry(this, iterator)) >= 0) {
+    var key = %MapKeyAt(this, entry);
+    if (key === undefined_sentinel) key = void 0;
+    %_CallFunction(receiver, %MapValueAt(this, entry), key, this, f);
+  }
+}
+
+
 function WeakMapConstructor() {
   if (%_IsConstructCall()) {
     %WeakMapInitialize(this);
@@ -218,7 +268,8 @@ function WeakMapDelete(key) {
   InstallFunctions($Set.prototype, DONT_ENUM, $Array(
     "add", SetAdd,
     "has", SetHas,
-    "delete", SetDelete
+    "delete", SetDelete,
+    "forEach", SetForEach
   ));
 
   // Set up the non-enumerable functions on the Map prototype object.
@@ -226,7 +277,8 @@ function WeakMapDelete(key) {
     "get", MapGet,
     "set", MapSet,
     "has", MapHas,
-    "delete", MapDelete
+    "delete", MapDelete,
+    "forEach", MapForEach
   ));
 
   // Set up the WeakMap constructor function.
@@ -141,6 +141,7 @@ enum BindingFlags {
   V(GET_STACK_TRACE_LINE_INDEX, JSFunction, get_stack_trace_line_fun) \
   V(CONFIGURE_GLOBAL_INDEX, JSFunction, configure_global_fun) \
   V(FUNCTION_CACHE_INDEX, JSObject, function_cache) \
+  V(INSTANCE_BOILERPLATE_CACHE_INDEX, Object, instance_boilerplate_cache) \
   V(JSFUNCTION_RESULT_CACHES_INDEX, FixedArray, jsfunction_result_caches) \
   V(NORMALIZED_MAP_CACHE_INDEX, NormalizedMapCache, normalized_map_cache) \
   V(RUNTIME_CONTEXT_INDEX, Context, runtime_context) \
@@ -269,6 +270,7 @@ class Context: public FixedArray {
     GET_STACK_TRACE_LINE_INDEX,
     CONFIGURE_GLOBAL_INDEX,
     FUNCTION_CACHE_INDEX,
+    INSTANCE_BOILERPLATE_CACHE_INDEX,
     JSFUNCTION_RESULT_CACHES_INDEX,
     NORMALIZED_MAP_CACHE_INDEX,
     RUNTIME_CONTEXT_INDEX,
@@ -199,8 +199,8 @@ DeoptimizedFrameInfo* Deoptimizer::DebuggerInspectableFrame(
   // Done with the GC-unsafe frame descriptions. This re-enables allocation.
   deoptimizer->DeleteFrameDescriptions();
 
-  // Allocate a heap number for the doubles belonging to this frame.
-  deoptimizer->MaterializeHeapNumbersForDebuggerInspectableFrame(
+  // Allocate heap numbers and captured objects belonging to this frame.
+  deoptimizer->MaterializeHeapObjectsForDebuggerInspectableFrame(
       parameters_top, parameters_size, expressions_top, expressions_size, info);
 
   // Finished using the deoptimizer instance.
@@ -368,7 +368,9 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
       output_count_(0),
       jsframe_count_(0),
       output_(NULL),
-      deferred_heap_numbers_(0) {
+      deferred_heap_numbers_(0),
+      deferred_objects_(0),
+      deferred_object_values_(0) {
   if (FLAG_trace_deopt && type != OSR) {
     if (type == DEBUGGER) {
       PrintF("**** DEOPT FOR DEBUGGER: ");
@@ -388,7 +390,6 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
            reinterpret_cast<intptr_t>(from),
            fp_to_sp_delta - (2 * kPointerSize));
   }
-  function->shared()->increment_deopt_count();
   // Find the optimized code.
   if (type == EAGER) {
     ASSERT(from == NULL);
@@ -427,6 +428,14 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
     optimized_code_ = optimized_code;
     ASSERT(optimized_code_->contains(from));
   }
+  // Debugger deoptimizations say nothing about the optimized code, keep them
+  // out of the counts that drive reoptimization.
+  if (type != DEBUGGER) {
+    function->shared()->increment_deopt_count();
+    isolate->runtime_profiler()->RecordDeoptimization(function->shared(),
+                                                      type,
+                                                      BailoutAstId());
+  }
   ASSERT(HEAP->allow_allocation(false));
   unsigned size = ComputeInputFrameSize();
   input_ = new(size) FrameDescription(size, function);
@@ -434,6 +443,16 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
 }
 
 
+// The AST id the function bails out at, which stays the same when the
+// function is optimized again.  For OSR the bailout id is the AST id.
+int Deoptimizer::BailoutAstId() {
+  if (bailout_type_ == OSR) return static_cast<int>(bailout_id_);
+  DeoptimizationInputData* input_data =
+      DeoptimizationInputData::cast(optimized_code_->deoptimization_data());
+  return input_data->AstId(bailout_id_).ToInt();
+}
+
+
 Deoptimizer::~Deoptimizer() {
   ASSERT(input_ == NULL && output_ == NULL);
 }
@@ -616,8 +635,21 @@ void Deoptimizer::DoComputeOutputFrames() {
 }
 
 
-void Deoptimizer::MaterializeHeapNumbers() {
+void Deoptimizer::MaterializeHeapObjects() {
   ASSERT_NE(DEBUGGER, bailout_type_);
+  List<Handle<JSObject> > objects(deferred_objects_.length());
+  MaterializeCapturedObjects(&objects);
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    ObjectMaterializationDescriptor d = deferred_objects_[i];
+    if (FLAG_trace_deopt) {
+      PrintF("Materializing a captured object %p in slot %p\n",
+             reinterpret_cast<void*>(*objects[i]),
+             d.slot_address());
+    }
+
+    Memory::Object_at(d.slot_address()) = *objects[i];
+  }
+
   for (int i = 0; i < deferred_heap_numbers_.length(); i++) {
     HeapNumberMaterializationDescriptor d = deferred_heap_numbers_[i];
     Handle<Object> num = isolate_->factory()->NewNumber(d.value());
@@ -634,7 +666,7 @@ void Deoptimizer::MaterializeHeapNumbers() {
 
 
 #ifdef ENABLE_DEBUGGER_SUPPORT
-void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
+void Deoptimizer::MaterializeHeapObjectsForDebuggerInspectableFrame(
     Address parameters_top,
     uint32_t parameters_size,
     Address expressions_top,
@@ -643,6 +675,9 @@ void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
   ASSERT_EQ(DEBUGGER, bailout_type_);
   Address parameters_bottom = parameters_top + parameters_size;
   Address expressions_bottom = expressions_top + expressions_size;
+  List<Handle<JSObject> > objects(deferred_objects_.length());
+  MaterializeCapturedObjects(&objects);
+
   for (int i = 0; i < deferred_heap_numbers_.length(); i++) {
     HeapNumberMaterializationDescriptor d = deferred_heap_numbers_[i];
 
@@ -683,6 +718,20 @@ void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
       info->SetExpression(index, *num);
     }
   }
+
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    ObjectMaterializationDescriptor d = deferred_objects_[i];
+    Address slot = d.slot_address();
+    if (parameters_top <= slot && slot < parameters_bottom) {
+      int index = (info->parameters_count() - 1) -
+          static_cast<int>(slot - parameters_top) / kPointerSize;
+      info->SetParameter(index, *objects[i]);
+    } else if (expressions_top <= slot && slot < expressions_bottom) {
+      int index = info->expression_count() - 1 -
+          static_cast<int>(slot - expressions_top) / kPointerSize;
+      info->SetExpression(index, *objects[i]);
+    }
+  }
 }
 #endif
 
@@ -869,6 +918,54 @@ void Deoptimizer::DoTranslateCommand(TranslationIterator* iterator,
       output_[frame_index]->SetFrameSlot(output_offset, value);
       return;
     }
+
+    case Translation::CAPTURED_OBJECT: {
+      Object* map = ComputeLiteral(iterator->Next());
+      int object_id = iterator->Next();
+      int field_count = iterator->Next();
+      if (FLAG_trace_deopt) {
+        PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- captured object"
+               " with %d fields\n",
+               output_[frame_index]->GetTop() + output_offset,
+               output_offset,
+               field_count);
+      }
+      // The object is allocated from its map and the field values after
+      // the frames are built.  Store a GC-safe placeholder in the frame.
+      AddCapturedObject(output_[frame_index]->GetTop() + output_offset,
+                        map,
+                        object_id,
+                        field_count);
+      for (int i = 0; i < field_count; i++) {
+        deferred_object_values_.Add(ComputeCapturedField(iterator));
+      }
+      output_[frame_index]->SetFrameSlot(output_offset, kPlaceholder);
+      return;
+    }
+  }
+}
+
+
+Object* Deoptimizer::ComputeCapturedField(TranslationIterator* iterator) {
+  // Fields of captured objects are always tagged.
+  Translation::Opcode opcode =
+      static_cast<Translation::Opcode>(iterator->Next());
+  switch (opcode) {
+    case Translation::REGISTER:
+      return reinterpret_cast<Object*>(
+          input_->GetRegister(iterator->Next()));
+
+    case Translation::STACK_SLOT: {
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(iterator->Next());
+      return reinterpret_cast<Object*>(input_->GetFrameSlot(input_offset));
+    }
+
+    case Translation::LITERAL:
+      return ComputeLiteral(iterator->Next());
+
+    default:
+      UNREACHABLE();
+      return NULL;
   }
 }
 
@@ -1044,6 +1141,13 @@ bool Deoptimizer::DoOsrTranslateCommand(TranslationIterator* iterator,
       UNREACHABLE();
       return false;
     }
+
+    case Translation::CAPTURED_OBJECT: {
+      // Objects are never captured across an OSR entry: the loop header
+      // merges them with the unoptimized values in a phi.
+      UNREACHABLE();
+      return false;
+    }
   }
 
   if (!duplicate) *input_offset -= kPointerSize;
@@ -1156,6 +1260,55 @@ void Deoptimizer::AddDoubleValue(intptr_t slot_address,
 }
 
 
+void Deoptimizer::AddCapturedObject(intptr_t slot_address,
+                                    Object* map,
+                                    int object_id,
+                                    int field_count) {
+  ObjectMaterializationDescriptor object_desc(
+      reinterpret_cast<Address>(slot_address),
+      object_id,
+      deferred_object_values_.length(),
+      field_count);
+  deferred_objects_.Add(object_desc);
+  deferred_object_values_.Add(map);
+}
+
+
+void Deoptimizer::MaterializeCapturedObjects(
+    List<Handle<JSObject> >* objects) {
+  // The maps and field values were collected as raw pointers while the
+  // frames were translated; handlify them before allocating anything.
+  List<Handle<Object> > values(deferred_object_values_.length());
+  for (int i = 0; i < deferred_object_values_.length(); i++) {
+    values.Add(Handle<Object>(deferred_object_values_[i], isolate_));
+  }
+
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    ObjectMaterializationDescriptor d = deferred_objects_[i];
+    // Several slots may refer to the same object.
+    int previous = 0;
+    while (previous < i &&
+           deferred_objects_[previous].object_id() != d.object_id()) {
+      previous++;
+    }
+    if (previous < i) {
+      objects->Add(objects->at(previous));
+      continue;
+    }
+
+    // The map is the one of a literal boilerplate that keeps all its
+    // fields in-object, so the object needs no properties backing store.
+    Handle<Map> map = Handle<Map>::cast(values[d.first_value()]);
+    Handle<JSObject> object =
+        isolate_->factory()->NewJSObjectFromMap(map, false);
+    for (int j = 0; j < d.field_count(); j++) {
+      object->InObjectPropertyAtPut(j, *values[d.first_value() + 1 + j]);
+    }
+    objects->Add(object);
+  }
+}
+
+
 MemoryChunk* Deoptimizer::CreateCode(BailoutType type) {
   // We cannot run this if the serializer is enabled because this will
   // cause us to emit relocation information for the external
@@ -1414,6 +1567,16 @@ void Translation::StoreArgumentsObject() {
 }
 
 
+void Translation::StoreCapturedObject(int map_literal_id,
+                                      int object_id,
+                                      int field_count) {
+  buffer_->Add(CAPTURED_OBJECT, zone());
+  buffer_->Add(map_literal_id, zone());
+  buffer_->Add(object_id, zone());
+  buffer_->Add(field_count, zone());
+}
+
+
 void Translation::MarkDuplicate() {
   buffer_->Add(DUPLICATE, zone());
 }
@@ -1437,6 +1600,7 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case CONSTRUCT_STUB_FRAME:
       return 2;
     case JS_FRAME:
+    case CAPTURED_OBJECT:
       return 3;
   }
   UNREACHABLE();
@@ -1472,6 +1636,8 @@ const char* Translation::StringFor(Opcode opcode) {
       return "LITERAL";
     case ARGUMENTS_OBJECT:
       return "ARGUMENTS_OBJECT";
+    case CAPTURED_OBJECT:
+      return "CAPTURED_OBJECT";
     case DUPLICATE:
       return "DUPLICATE";
   }
@@ -1550,6 +1716,9 @@ SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
       int literal_index = iterator->Next();
       return SlotRef(data->LiteralArray()->get(literal_index));
     }
+
+    case Translation::CAPTURED_OBJECT:
+      return ComputeSlotForCapturedObject(iterator, data, frame);
   }
 
   UNREACHABLE();
@@ -1557,15 +1726,38 @@ SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
 }
 
 
+SlotRef SlotRef::ComputeSlotForCapturedObject(TranslationIterator* iterator,
+                                              DeoptimizationInputData* data,
+                                              JavaScriptFrame* frame) {
+  int literal_index = iterator->Next();
+  iterator->Next();  // Drop object id.
+  int field_count = iterator->Next();
+  Vector<SlotRef> fields = Vector<SlotRef>::New(field_count);
+  for (int i = 0; i < field_count; i++) {
+    fields[i] = ComputeSlotForNextArgument(iterator, data, frame);
+  }
+  return SlotRef(data->LiteralArray()->get(literal_index), fields);
+}
+
+
 void SlotRef::ComputeSlotsForArguments(Vector<SlotRef>* args_slots,
                                        TranslationIterator* it,
                                        DeoptimizationInputData* data,
                                        JavaScriptFrame* frame) {
   // Process the translation commands for the arguments.
 
-  // Skip the translation command for the receiver.
-  it->Skip(Translation::NumberOfOperandsFor(
-      static_cast<Translation::Opcode>(it->Next())));
+  // Skip the translation command for the receiver, including the fields of
+  // a captured receiver object.
+  int commands_to_skip = 1;
+  while (commands_to_skip-- > 0) {
+    Translation::Opcode opcode = static_cast<Translation::Opcode>(it->Next());
+    if (opcode == Translation::CAPTURED_OBJECT) {
+      it->Skip(2);  // Map literal id and object id.
+      commands_to_skip += it->Next();
+    } else {
+      it->Skip(Translation::NumberOfOperandsFor(opcode));
+    }
+  }
 
   // Compute slots for arguments.
   for (int i = 0; i < args_slots->length(); ++i) {
@@ -57,6 +57,33 @@ class HeapNumberMaterializationDescriptor BASE_EMBEDDED {
 };
 
 
+class ObjectMaterializationDescriptor BASE_EMBEDDED {
+ public:
+  ObjectMaterializationDescriptor(Address slot_address,
+                                  int object_id,
+                                  int first_value,
+                                  int field_count)
+      : slot_address_(slot_address),
+        object_id_(object_id),
+        first_value_(first_value),
+        field_count_(field_count) { }
+
+  Address slot_address() const { return slot_address_; }
+  // Slots with the same object id refer to the same object.
+  int object_id() const { return object_id_; }
+  // Index of the map in the list of deferred object values.  The values of
+  // the fields follow the map.
+  int first_value() const { return first_value_; }
+  int field_count() const { return field_count_; }
+
+ private:
+  Address slot_address_;
+  int object_id_;
+  int first_value_;
+  int field_count_;
+};
+
+
 class OptimizedFunctionVisitor BASE_EMBEDDED {
  public:
   virtual ~OptimizedFunctionVisitor() {}
@@ -196,9 +223,9 @@ class Deoptimizer : public Malloced {
 
   ~Deoptimizer();
 
-  void MaterializeHeapNumbers();
+  void MaterializeHeapObjects();
 #ifdef ENABLE_DEBUGGER_SUPPORT
-  void MaterializeHeapNumbersForDebuggerInspectableFrame(
+  void MaterializeHeapObjectsForDebuggerInspectableFrame(
       Address parameters_top,
       uint32_t parameters_size,
       Address expressions_top,
@@ -294,6 +321,8 @@ class Deoptimizer : public Malloced {
   bool DoOsrTranslateCommand(TranslationIterator* iterator,
                              int* input_offset);
 
+  int BailoutAstId();
+
   unsigned ComputeInputFrameSize() const;
   unsigned ComputeFixedSize(JSFunction* function) const;
 
@@ -303,6 +332,13 @@ class Deoptimizer : public Malloced {
   Object* ComputeLiteral(int index) const;
 
   void AddDoubleValue(intptr_t slot_address, double value);
+  void AddCapturedObject(intptr_t slot_address,
+                         Object* map,
+                         int object_id,
+                         int field_count);
+  Object* ComputeCapturedField(TranslationIterator* iterator);
+  // Allocates the captured objects, in the order of deferred_objects_.
+  void MaterializeCapturedObjects(List<Handle<JSObject> >* objects);
 
   static MemoryChunk* CreateCode(BailoutType type);
   static void GenerateDeoptimizationEntries(
@@ -338,6 +374,8 @@ class Deoptimizer : public Malloced {
   FrameDescription** output_;
 
   List<HeapNumberMaterializationDescriptor> deferred_heap_numbers_;
+  List<ObjectMaterializationDescriptor> deferred_objects_;
+  List<Object*> deferred_object_values_;
 
   static const int table_entry_size_;
 
@@ -568,6 +606,7 @@ class Translation BASE_EMBEDDED {
     DOUBLE_STACK_SLOT,
     LITERAL,
     ARGUMENTS_OBJECT,
+    CAPTURED_OBJECT,
 
     // A prefix indicating that the next command is a duplicate of the one
     // that follows it.
@@ -598,6 +637,7 @@ class Translation BASE_EMBEDDED {
   void StoreDoubleStackSlot(int index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject();
+  void StoreCapturedObject(int map_literal_id, int object_id, int field_count);
   void MarkDuplicate();
 
   Zone* zone() const { return zone_; }
@@ -645,7 +685,8 @@ class SlotRef BASE_EMBEDDED {
     TAGGED,
     INT32,
     DOUBLE,
-    LITERAL
+    LITERAL,
+    CAPTURED_OBJECT
   };
 
   SlotRef()
@@ -657,6 +698,9 @@ class SlotRef BASE_EMBEDDED {
   explicit SlotRef(Object* literal)
       : literal_(literal), representation_(LITERAL) { }
 
+  SlotRef(Object* map, Vector<SlotRef> fields)
+      : literal_(map), fields_(fields), representation_(CAPTURED_OBJECT) { }
+
   Handle<Object> GetValue() {
     switch (representation_) {
       case TAGGED:
@@ -679,6 +723,19 @@ class SlotRef BASE_EMBEDDED {
       case LITERAL:
         return literal_;
 
+      case CAPTURED_OBJECT: {
+        // The fields are released once the object has been materialized.
+        Handle<JSObject> object =
+            Isolate::Current()->factory()->NewJSObjectFromMap(
+                Handle<Map>::cast(literal_), false);
+        for (int i = 0; i < fields_.length(); i++) {
+          Handle<Object> value = fields_[i].GetValue();
+          object->InObjectPropertyAtPut(i, *value);
+        }
+        fields_.Dispose();
+        return object;
+      }
+
       default:
         UNREACHABLE();
         return Handle<Object>::null();
@@ -690,9 +747,16 @@ class SlotRef BASE_EMBEDDED {
       int inlined_frame_index,
       int formal_parameter_count);
 
+  // Reads the operands of a CAPTURED_OBJECT translation command, whose
+  // opcode has already been consumed, and the commands for its fields.
+  static SlotRef ComputeSlotForCapturedObject(TranslationIterator* iterator,
+                                              DeoptimizationInputData* data,
+                                              JavaScriptFrame* frame);
+
  private:
   Address addr_;
   Handle<Object> literal_;
+  Vector<SlotRef> fields_;
   SlotRepresentation representation_;
 
   static Address SlotAddress(JavaScriptFrame* frame, int slot_index) {
@@ -744,8 +744,12 @@ Handle<JSFunction> Execution::InstantiateFunction(
 Handle<JSObject> Execution::InstantiateObject(Handle<ObjectTemplateInfo> data,
                                               bool* exc) {
   Isolate* isolate = data->GetIsolate();
-  if (data->property_list()->IsUndefined() &&
-      !data->constructor()->IsUndefined()) {
+  // Instances created by the constructor are already configured from its
+  // instance template, which is usually 'data' itself.
+  if (!data->constructor()->IsUndefined() &&
+      (data->property_list()->IsUndefined() ||
+       FunctionTemplateInfo::cast(data->constructor())->instance_template() ==
+           *data)) {
     // Initialization to make gcc happy.
     Object* result = NULL;
     {
@@ -112,6 +112,22 @@ Handle<ObjectHashTable> Factory::NewObjectHashTable(int at_least_space_for) {
 }
 
 
+Handle<OrderedHashSet> Factory::NewOrderedHashSet() {
+  CALL_HEAP_FUNCTION(isolate(),
+                     OrderedHashSet::Allocate(isolate()->heap(),
+                                              OrderedHashSet::kMinCapacity),
+                     OrderedHashSet);
+}
+
+
+Handle<OrderedHashMap> Factory::NewOrderedHashMap() {
+  CALL_HEAP_FUNCTION(isolate(),
+                     OrderedHashMap::Allocate(isolate()->heap(),
+                                              OrderedHashMap::kMinCapacity),
+                     OrderedHashMap);
+}
+
+
 Handle<DescriptorArray> Factory::NewDescriptorArray(int number_of_descriptors) {
   ASSERT(0 <= number_of_descriptors);
   CALL_HEAP_FUNCTION(isolate(),
@@ -609,6 +625,14 @@ Handle<Object> Factory::NewNumberFromUint(uint32_t value,
 }
 
 
+Handle<HeapNumber> Factory::NewHeapNumber(double value,
+                                          PretenureFlag pretenure) {
+  CALL_HEAP_FUNCTION(
+      isolate(),
+      isolate()->heap()->AllocateHeapNumber(value, pretenure), HeapNumber);
+}
+
+
 Handle<JSObject> Factory::NewNeanderObject() {
   CALL_HEAP_FUNCTION(
       isolate(),
@@ -917,10 +941,13 @@ Handle<GlobalObject> Factory::NewGlobalObject(
 
 
 
-Handle<JSObject> Factory::NewJSObjectFromMap(Handle<Map> map) {
+Handle<JSObject> Factory::NewJSObjectFromMap(Handle<Map> map,
+                                             bool allocate_properties) {
   CALL_HEAP_FUNCTION(
       isolate(),
-      isolate()->heap()->AllocateJSObjectFromMap(*map, NOT_TENURED),
+      isolate()->heap()->AllocateJSObjectFromMap(*map,
+                                                 NOT_TENURED,
+                                                 allocate_properties),
       JSObject);
 }
 
@@ -1375,19 +1402,163 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
 
 
 
+// Instances of a function template are configured by copying the map and
+// the property backing store of a boilerplate instance, which is built once
+// per template and global context by the JavaScript code in apinatives.js.
+// This is only valid if configuring an instance has no observable effect
+// other than adding the template's properties, so templates with nested
+// object templates, indexed properties or interceptors are never cached.
+static int PropertyListLength(ObjectTemplateInfo* instance_template) {
+  FixedArray* properties = FixedArray::cast(
+      JSObject::cast(instance_template->property_list())->elements());
+  return Smi::cast(properties->get(0))->value();
+}
+
+
+static bool CanCacheInstanceBoilerplate(ObjectTemplateInfo* instance_template,
+                                        JSObject* boilerplate) {
+  Map* map = boilerplate->map();
+  if (map->has_named_interceptor() || map->has_indexed_interceptor()) {
+    return false;
+  }
+  if (!boilerplate->HasFastProperties() ||
+      map->inobject_properties() != 0 ||
+      boilerplate->elements()->length() != 0) {
+    return false;
+  }
+  FixedArray* properties = FixedArray::cast(
+      JSObject::cast(instance_template->property_list())->elements());
+  int length = PropertyListLength(instance_template);
+  for (int i = 0; i < length; i += 3) {
+    String* name = String::cast(properties->get(i + 1));
+    if (properties->get(i + 2)->IsObjectTemplateInfo()) return false;
+    LookupResult result(boilerplate->GetIsolate());
+    boilerplate->LocalLookupRealNamedProperty(name, &result);
+    if (!result.IsFound()) return false;
+    if (result.type() != FIELD && result.type() != CONSTANT_FUNCTION) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+static const int kBoilerplateMapIndex = 0;
+static const int kBoilerplatePropertiesIndex = 1;
+static const int kBoilerplateIndex = 2;
+static const int kBoilerplateEntrySize = 3;
+
+
+// Returns the boilerplate for instances of 'desc' with the given initial
+// map, or a null handle if instances have to be configured in JavaScript.
+static Handle<JSObject> InstanceBoilerplate(
+    Isolate* isolate,
+    Handle<FunctionTemplateInfo> desc,
+    Handle<Map> initial_map,
+    bool* pending_exception) {
+  Factory* factory = isolate->factory();
+  Handle<Context> global_context(isolate->context()->global_context());
+  uint32_t serial_number =
+      static_cast<uint32_t>(Smi::cast(desc->serial_number())->value());
+  Handle<ObjectTemplateInfo> instance_template(
+      ObjectTemplateInfo::cast(desc->instance_template()));
+  // Template::Set appends to the property list, so its length tells
+  // whether properties were added since the boilerplate was built.
+  Smi* property_list_length =
+      Smi::FromInt(PropertyListLength(*instance_template));
+
+  Handle<UnseededNumberDictionary> cache;
+  if (global_context->instance_boilerplate_cache()->IsUndefined()) {
+    cache = factory->NewUnseededNumberDictionary(16);
+  } else {
+    cache = Handle<UnseededNumberDictionary>(UnseededNumberDictionary::cast(
+        global_context->instance_boilerplate_cache()));
+    int entry = cache->FindEntry(serial_number);
+    if (entry != UnseededNumberDictionary::kNotFound) {
+      // Entries hold the initial map, the property list length and the
+      // boilerplate, which is undefined if the template cannot be cached.
+      FixedArray* entry_value = FixedArray::cast(cache->ValueAt(entry));
+      if (entry_value->get(kBoilerplateMapIndex) == *initial_map &&
+          entry_value->get(kBoilerplatePropertiesIndex) ==
+              property_list_length) {
+        *pending_exception = false;
+        Object* cached = entry_value->get(kBoilerplateIndex);
+        if (cached->IsUndefined()) return Handle<JSObject>::null();
+        return Handle<JSObject>(JSObject::cast(cached));
+      }
+    }
+  }
+
+  Handle<JSObject> boilerplate = factory->NewJSObjectFromMap(initial_map);
+  Execution::ConfigureInstance(boilerplate,
+                               instance_template,
+                               pending_exception);
+  if (*pending_exception) return Handle<JSObject>::null();
+  if (!CanCacheInstanceBoilerplate(*instance_template, *boilerplate)) {
+    boilerplate = Handle<JSObject>::null();
+  }
+
+  Handle<FixedArray> entry_value =
+      factory->NewFixedArray(kBoilerplateEntrySize, TENURED);
+  entry_value->set(kBoilerplateMapIndex, *initial_map);
+  entry_value->set(kBoilerplatePropertiesIndex, property_list_length);
+  if (!boilerplate.is_null()) {
+    entry_value->set(kBoilerplateIndex, *boilerplate);
+  }
+  cache = factory->DictionaryAtNumberPut(cache, serial_number, entry_value);
+  global_context->set_instance_boilerplate_cache(*cache);
+  return boilerplate;
+}
+
+
 void Factory::ConfigureInstance(Handle<FunctionTemplateInfo> desc,
                                 Handle<JSObject> instance,
                                 bool* pending_exception) {
   // Configure the instance by adding the properties specified by the
   // instance template.
+  *pending_exception = false;
   Handle<Object> instance_template = Handle<Object>(desc->instance_template());
-  if (!instance_template->IsUndefined()) {
+  if (instance_template->IsUndefined() ||
+      ObjectTemplateInfo::cast(*instance_template)->property_list()->
+          IsUndefined()) {
+    return;
+  }
+
+  // The boilerplate replaces all fields of the instance, so it can only be
+  // used for instances that do not have any yet.
+  Handle<JSObject> boilerplate;
+  if (instance->HasFastProperties() &&
+      instance->map()->NextFreePropertyIndex() == 0) {
+    boilerplate = InstanceBoilerplate(isolate(),
+                                      desc,
+                                      Handle<Map>(instance->map()),
+                                      pending_exception);
+    if (*pending_exception) return;
+  }
+  if (boilerplate.is_null()) {
     Execution::ConfigureInstance(instance,
                                  instance_template,
                                  pending_exception);
-  } else {
-    *pending_exception = false;
+    return;
+  }
+
+  // Copy the boilerplate's properties in bulk.  The instance has no
+  // properties of its own yet as it still has the initial map.
+  Handle<FixedArray> properties =
+      CopyFixedArray(Handle<FixedArray>(boilerplate->properties()));
+  // Every instance gets its own boxes for double fields.  Boilerplates
+  // have no in-object properties, so field indices index the store.
+  Handle<DescriptorArray> descs(boilerplate->map()->instance_descriptors());
+  for (int i = 0; i < descs->number_of_descriptors(); i++) {
+    PropertyDetails details = descs->GetDetails(i);
+    if (details.type() != FIELD || !details.IsDoubleField()) continue;
+    int index = descs->GetFieldIndex(i);
+    Handle<HeapNumber> number =
+        NewHeapNumber(HeapNumber::cast(properties->get(index))->value());
+    properties->set(index, *number);
   }
+  instance->set_properties(*properties);
+  instance->set_map(boilerplate->map());
 }
 
 
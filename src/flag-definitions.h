@@ -200,8 +200,16 @@ DEFINE_bool(polymorphic_inlining, true, "polymorphic inlining")
 DEFINE_bool(use_osr, true, "use on-stack replacement")
 DEFINE_bool(array_bounds_checks_elimination, true,
             "perform array bounds checks elimination")
+DEFINE_bool(check_elimination, false,
+            "eliminate map checks implied by earlier checks on all paths")
+DEFINE_bool(trace_check_elimination, false, "trace map check elimination")
 DEFINE_bool(array_index_dehoisting, true,
             "perform array index dehoisting")
+DEFINE_bool(forward_field_stores, false,
+            "forward stored field values to loads of the same field")
+DEFINE_bool(escape_analysis, false,
+            "replace non-escaping object literals by their field values")
+DEFINE_bool(trace_escape_analysis, false, "trace escape analysis")
 
 DEFINE_bool(trace_osr, false, "trace on-stack replacement")
 DEFINE_int(stress_runs, 0, "number of stress runs")
@@ -214,6 +222,8 @@ DEFINE_bool(cache_optimized_code, true,
 DEFINE_bool(inline_construct, true, "inline constructor calls")
 DEFINE_bool(inline_arguments, true, "inline functions with arguments object")
 DEFINE_bool(inline_accessors, false, "inline JavaScript accessors")
+DEFINE_bool(fast_api_calls, true,
+            "call fast API callbacks directly from optimized code")
 DEFINE_int(loop_weight, 1, "loop weight for representation inference")
 
 DEFINE_bool(optimize_for_in, true,
@@ -293,6 +303,8 @@ DEFINE_int(stack_trace_limit, 10, "number of stack frames to capture")
 DEFINE_bool(builtins_in_stack_traces, false,
             "show built-in functions in stack traces")
 DEFINE_bool(disable_native_files, false, "disable builtin natives files")
+DEFINE_bool(lazy_natives, true,
+            "parse natives lazily using preparse data shared by all isolates")
 
 // builtins-ia32.cc
 DEFINE_bool(inline_new, true, "use fast inline allocation")
@@ -350,6 +362,9 @@ DEFINE_int(max_stack_trace_source_length, 300,
 // full-codegen.cc
 DEFINE_bool(always_inline_smi_code, false,
             "always inline smi code in non-opt code")
+DEFINE_bool(optimize_for_size, false,
+            "keep non-opt code small and flush it early, trading execution "
+            "speed for less code space")
 
 // heap.cc
 DEFINE_int(max_new_space_size, 0, "max size of the new generation (in kBytes)")
@@ -368,6 +383,9 @@ DEFINE_bool(print_cumulative_gc_stat, false,
             "print cumulative GC statistics in name=value format on exit")
 DEFINE_bool(trace_gc_verbose, false,
             "print more details following each garbage collection")
+DEFINE_bool(record_gc_events, false,
+            "record a structured event for each garbage collection that "
+            "the embedder can poll through the API")
 DEFINE_bool(trace_fragmentation, false,
             "report fragmentation for old pointer and data pages")
 DEFINE_bool(trace_external_memory, false,
@@ -377,6 +395,9 @@ DEFINE_bool(collect_maps, true,
             "garbage collect maps from which no objects can be reached")
 DEFINE_bool(flush_code, true,
             "flush code that we expect not to use again before full gc")
+DEFINE_int(flush_code_age, 5,
+           "number of full gcs during which a function must not run "
+           "before its code is flushed (at most 7)")
 DEFINE_bool(incremental_marking, true, "use incremental marking")
 DEFINE_bool(incremental_marking_steps, true, "do incremental marking steps")
 DEFINE_bool(trace_incremental_marking, false,
@@ -420,6 +441,8 @@ DEFINE_int(random_seed, 0,
 
 // objects.cc
 DEFINE_bool(use_verbose_printer, true, "allows verbose printing")
+DEFINE_bool(track_double_fields, false,
+            "store double properties in heap numbers updated in place")
 
 // parser.cc
 DEFINE_bool(allow_natives_syntax, false, "allow natives syntax")
@@ -867,6 +867,12 @@ void OptimizedFrame::Summarize(List<FrameSummary>* frames) {
   it.Next();  // Drop frame count.
   int jsframe_count = it.Next();
 
+  // Receivers that escape analysis replaced by their fields are
+  // materialized once the translation has been read, since allocating
+  // may move the translation byte array.
+  List<int> captured_receiver_indices;
+  List<SlotRef> captured_receivers;
+
   // We create the summary in reverse order because the frames
   // in the deoptimization translation are ordered bottom-to-top.
   bool is_constructor = IsConstructor();
@@ -881,17 +887,24 @@ void OptimizedFrame::Summarize(List<FrameSummary>* frames) {
 
       // The translation commands are ordered and the receiver is always
       // at the first position. Since we are always at a call when we need
-      // to construct a stack trace, the receiver is always in a stack slot.
+      // to construct a stack trace, the receiver is always in a stack slot
+      // or, for a captured object literal, its fields are.
       opcode = static_cast<Translation::Opcode>(it.Next());
       ASSERT(opcode == Translation::STACK_SLOT ||
-             opcode == Translation::LITERAL);
-      int index = it.Next();
+             opcode == Translation::LITERAL ||
+             opcode == Translation::CAPTURED_OBJECT);
 
       // Get the correct receiver in the optimized frame.
       Object* receiver = NULL;
-      if (opcode == Translation::LITERAL) {
-        receiver = data->LiteralArray()->get(index);
+      if (opcode == Translation::CAPTURED_OBJECT) {
+        captured_receiver_indices.Add(frames->length());
+        captured_receivers.Add(
+            SlotRef::ComputeSlotForCapturedObject(&it, data, this));
+        receiver = isolate()->heap()->undefined_value();
+      } else if (opcode == Translation::LITERAL) {
+        receiver = data->LiteralArray()->get(it.Next());
       } else {
+        int index = it.Next();
         // Positive index means the value is spilled to the locals
         // area. Negative means it is stored in the incoming parameter
         // area.
@@ -933,6 +946,17 @@ void OptimizedFrame::Summarize(List<FrameSummary>* frames) {
     }
   }
   ASSERT(!is_constructor);
+
+  // Each summary gets its own copy of a captured receiver.
+  for (int i = 0; i < captured_receivers.length(); i++) {
+    Handle<Object> receiver = captured_receivers[i].GetValue();
+    FrameSummary& summary = frames->at(captured_receiver_indices[i]);
+    summary = FrameSummary(*receiver,
+                           *summary.function(),
+                           *summary.code(),
+                           summary.offset(),
+                           summary.is_constructor());
+  }
 }
 
 
@@ -327,6 +327,10 @@ bool FullCodeGenerator::MakeCode(CompilationInfo* info) {
       info->isolate()->debugger()->IsDebuggerActive());
   code->set_compiled_optimizable(info->IsOptimizable());
 #endif  // ENABLE_DEBUGGER_SUPPORT
+  // The prologue starts with the code age sequence unless something, like
+  // the function entry hook, was emitted before the frame setup.
+  code->set_has_code_age_sequence(
+      Code::IsYoungSequence(code->instruction_start()));
   code->set_allow_osr_at_loop_nesting_level(0);
   code->set_profiler_ticks(0);
   code->set_stack_check_table_offset(table_offset);
@@ -480,6 +484,7 @@ bool FullCodeGenerator::ShouldInlineSmiCase(Token::Value op) {
   // are too complicated and take up too much space.
   if (op == Token::DIV ||op == Token::MOD) return false;
   if (FLAG_always_inline_smi_code) return true;
+  if (FLAG_optimize_for_size) return false;
   return loop_depth_ > 0;
 }
 
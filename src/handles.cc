@@ -364,18 +364,24 @@ static void ClearWrapperCache(Persistent<v8::Value> handle, void*) {
 
 
 Handle<JSValue> GetScriptWrapper(Handle<Script> script) {
-  if (script->wrapper()->foreign_address() != NULL) {
-    // Return the script wrapper directly from the cache.
-    return Handle<JSValue>(
+  Isolate* isolate = Isolate::Current();
+  Handle<JSFunction> constructor = isolate->script_function();
+  bool cached = script->wrapper()->foreign_address() != NULL;
+  if (cached) {
+    Handle<JSValue> wrapper(
         reinterpret_cast<JSValue**>(script->wrapper()->foreign_address()));
+    // Return the script wrapper directly from the cache, unless it was made
+    // in another context: contexts copied by Context::Clone share their
+    // scripts with the original.
+    if (wrapper->map()->constructor() == *constructor) return wrapper;
   }
-  Isolate* isolate = Isolate::Current();
   // Construct a new script wrapper.
   isolate->counters()->script_wrappers()->Increment();
-  Handle<JSFunction> constructor = isolate->script_function();
   Handle<JSValue> result =
       Handle<JSValue>::cast(isolate->factory()->NewJSObject(constructor));
   result->set_value(*script);
+  // The cache keeps the wrapper of the context that asked first.
+  if (cached) return result;
 
   // Create a new weak global handle and use it to cache the wrapper
   // for future use. The cache will automatically be cleared by the
@@ -800,6 +806,31 @@ Handle<ObjectHashTable> PutIntoObjectHashTable(Handle<ObjectHashTable> table,
 }
 
 
+Handle<OrderedHashSet> OrderedHashSetAdd(Handle<OrderedHashSet> table,
+                                         Handle<Object> key) {
+  CALL_HEAP_FUNCTION(table->GetIsolate(),
+                     table->Add(*key),
+                     OrderedHashSet);
+}
+
+
+Handle<OrderedHashSet> OrderedHashSetRemove(Handle<OrderedHashSet> table,
+                                            Handle<Object> key) {
+  CALL_HEAP_FUNCTION(table->GetIsolate(),
+                     table->Remove(*key),
+                     OrderedHashSet);
+}
+
+
+Handle<OrderedHashMap> PutIntoOrderedHashMap(Handle<OrderedHashMap> table,
+                                             Handle<Object> key,
+                                             Handle<Object> value) {
+  CALL_HEAP_FUNCTION(table->GetIsolate(),
+                     table->Put(*key, *value),
+                     OrderedHashMap);
+}
+
+
 // This method determines the type of string involved and then gets the UTF8
 // length of the string.  It doesn't flatten the string and has log(n) recursion
 // for a string of length n.  If the failure flag gets set, then we have to
@@ -317,6 +317,16 @@ Handle<ObjectHashTable> PutIntoObjectHashTable(Handle<ObjectHashTable> table,
                                                Handle<Object> key,
                                                Handle<Object> value);
 
+Handle<OrderedHashSet> OrderedHashSetAdd(Handle<OrderedHashSet> table,
+                                         Handle<Object> key);
+
+Handle<OrderedHashSet> OrderedHashSetRemove(Handle<OrderedHashSet> table,
+                                            Handle<Object> key);
+
+Handle<OrderedHashMap> PutIntoOrderedHashMap(Handle<OrderedHashMap> table,
+                                             Handle<Object> key,
+                                             Handle<Object> value);
+
 class NoHandleAllocation BASE_EMBEDDED {
  public:
 #ifndef DEBUG
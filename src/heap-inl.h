@@ -221,7 +221,12 @@ MaybeObject* Heap::AllocateRaw(int size_in_bytes,
     ASSERT(MAP_SPACE == space);
     result = map_space_->AllocateRaw(size_in_bytes);
   }
-  if (result->IsFailure()) old_gen_exhausted_ = true;
+  if (result->IsFailure()) {
+    old_gen_exhausted_ = true;
+  } else if (new_space_.allocation_sample_step() != 0) {
+    SampleOldSpaceAllocation(HeapObject::cast(result->ToObjectUnchecked()),
+                             size_in_bytes);
+  }
   return result;
 }
 
@@ -27,19 +27,203 @@
 
 #include "v8.h"
 
+#include "frames-inl.h"
+#include "global-handles.h"
 #include "heap-profiler.h"
-#include "profile-generator.h"
+#include "profile-generator-inl.h"
 
 namespace v8 {
 namespace internal {
 
+struct SamplingHeapProfiler::Sample : public Malloced {
+  Sample(SamplingHeapProfiler* profiler, Node* node, int size)
+      : profiler(profiler),
+        node(node),
+        size(size),
+        location(NULL),
+        prev(NULL),
+        next(NULL) { }
+
+  SamplingHeapProfiler* profiler;
+  Node* node;
+  int size;
+  Object** location;
+  Sample* prev;
+  Sample* next;
+};
+
+
+SamplingHeapProfiler::Node::~Node() {
+  for (int i = 0; i < children_.length(); i++) delete children_[i];
+}
+
+
+SamplingHeapProfiler::Node* SamplingHeapProfiler::Node::FindOrAddChild(
+    const char* name,
+    const char* resource_name,
+    int start_position,
+    Script* script) {
+  // Names are interned by StringsStorage, so pointers can be compared.
+  for (int i = 0; i < children_.length(); i++) {
+    Node* child = children_[i];
+    if (child->name_ == name &&
+        child->resource_name_ == resource_name &&
+        child->start_position_ == start_position) {
+      return child;
+    }
+  }
+  int line_number = v8::CpuProfileNode::kNoLineNumberInfo;
+  if (script != NULL) {
+    line_number =
+        GetScriptLineNumberSafe(Handle<Script>(script), start_position) + 1;
+  }
+  Node* child = new Node(name, resource_name, line_number, start_position);
+  children_.Add(child);
+  return child;
+}
+
+
+SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, int sample_interval)
+    : heap_(heap),
+      sample_interval_(sample_interval),
+      bytes_until_sample_(0),
+      names_(new StringsStorage()),
+      root_(new Node(ProfileGenerator::kProgramEntryName, "",
+                     v8::CpuProfileNode::kNoLineNumberInfo, 0)),
+      samples_(NULL) {
+  bytes_until_sample_ = NextSampleInterval();
+  heap_->new_space()->SetAllocationSampleStep(bytes_until_sample_);
+}
+
+
+SamplingHeapProfiler::~SamplingHeapProfiler() {
+  heap_->new_space()->SetAllocationSampleStep(0);
+  GlobalHandles* global_handles = heap_->isolate()->global_handles();
+  while (samples_ != NULL) {
+    Sample* sample = samples_;
+    samples_ = sample->next;
+    global_handles->Destroy(sample->location);
+    delete sample;
+  }
+  delete root_;
+  delete names_;
+}
+
+
+void SamplingHeapProfiler::NewSpaceAllocationStep(intptr_t bytes,
+                                                  HeapObject* object,
+                                                  int size) {
+  // Objects copied by the scavenger are not allocations of the mutator.
+  if (heap_->gc_state() == Heap::NOT_IN_GC) Step(bytes, object, size);
+  heap_->new_space()->SetAllocationSampleStep(bytes_until_sample_);
+}
+
+
+void SamplingHeapProfiler::OldSpaceAllocation(HeapObject* object, int size) {
+  if (Step(size, object, size)) {
+    // Sampling intervals are memoryless, so it is fine to drop the bytes
+    // allocated in new space since its last step.
+    heap_->new_space()->SetAllocationSampleStep(bytes_until_sample_);
+  }
+}
+
+
+bool SamplingHeapProfiler::Step(intptr_t bytes, HeapObject* object, int size) {
+  bytes_until_sample_ -= bytes;
+  if (bytes_until_sample_ > 0) return false;
+  SampleObject(object, size);
+  bytes_until_sample_ = NextSampleInterval();
+  return true;
+}
+
+
+intptr_t SamplingHeapProfiler::NextSampleInterval() {
+  // Exponentially distributed intervals make the sampled allocations a
+  // Poisson process over the allocated bytes.
+  double u = (V8::RandomPrivate(heap_->isolate()) + 1.0) / 4294967297.0;
+  double interval = -log(u) * sample_interval_;
+  return Max(static_cast<intptr_t>(interval),
+             static_cast<intptr_t>(kPointerSize));
+}
+
+
+void SamplingHeapProfiler::SampleObject(HeapObject* object, int size) {
+  Isolate* isolate = heap_->isolate();
+  HandleScope scope(isolate);
+  AssertNoAllocation no_allocation;
+
+  // Collect the stack from the innermost frame outwards. Deeper stacks are
+  // truncated at the outermost frames.
+  JSFunction* functions[kMaxStackDepth];
+  int depth = 0;
+  for (JavaScriptFrameIterator it(isolate);
+       !it.done() && depth < kMaxStackDepth;
+       it.Advance()) {
+    functions[depth++] = JSFunction::cast(it.frame()->function());
+  }
+
+  Node* node = root_;
+  for (int i = depth - 1; i >= 0; i--) {
+    SharedFunctionInfo* shared = functions[i]->shared();
+    const char* resource_name = "";
+    Script* script = NULL;
+    if (shared->script()->IsScript()) {
+      script = Script::cast(shared->script());
+      if (script->name()->IsString()) {
+        resource_name = names_->GetName(String::cast(script->name()));
+      }
+    }
+    node = node->FindOrAddChild(names_->GetFunctionName(shared->DebugName()),
+                                resource_name,
+                                shared->start_position(),
+                                script);
+  }
+  node->samples_count_++;
+  node->size_ += size;
+  node->live_samples_count_++;
+  node->live_size_ += size;
+
+  // The object is sampled before the allocator initializes it.  Make it
+  // a filler until then, so that its map can be read.
+  heap_->CreateFillerObjectAt(object->address(), size);
+  Sample* sample = new Sample(this, node, size);
+  GlobalHandles* global_handles = isolate->global_handles();
+  sample->location = global_handles->Create(object).location();
+  global_handles->MakeWeak(sample->location, sample, &OnSampleDied);
+  // Let scavenges clear the handle of a dead sample, too.
+  global_handles->MarkIndependent(sample->location);
+  sample->next = samples_;
+  if (samples_ != NULL) samples_->prev = sample;
+  samples_ = sample;
+}
+
+
+void SamplingHeapProfiler::OnSampleDied(v8::Persistent<v8::Value> handle,
+                                        void* parameter) {
+  Sample* sample = reinterpret_cast<Sample*>(parameter);
+  sample->node->live_samples_count_--;
+  sample->node->live_size_ -= sample->size;
+  SamplingHeapProfiler* profiler = sample->profiler;
+  if (sample->prev != NULL) {
+    sample->prev->next = sample->next;
+  } else {
+    profiler->samples_ = sample->next;
+  }
+  if (sample->next != NULL) sample->next->prev = sample->prev;
+  profiler->heap_->isolate()->global_handles()->Destroy(sample->location);
+  delete sample;
+}
+
+
 HeapProfiler::HeapProfiler()
     : snapshots_(new HeapSnapshotsCollection()),
+      sampling_heap_profiler_(NULL),
       next_snapshot_uid_(1) {
 }
 
 
 HeapProfiler::~HeapProfiler() {
+  delete sampling_heap_profiler_;
   delete snapshots_;
 }
 
@@ -85,6 +269,14 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(String* name,
 }
 
 
+bool HeapProfiler::StreamSnapshot(v8::OutputStream* stream,
+                                  v8::ActivityControl* control) {
+  ASSERT(Isolate::Current()->heap_profiler() != NULL);
+  return Isolate::Current()->heap_profiler()->StreamSnapshotImpl(stream,
+                                                                 control);
+}
+
+
 void HeapProfiler::StartHeapObjectsTracking() {
   ASSERT(Isolate::Current()->heap_profiler() != NULL);
   Isolate::Current()->heap_profiler()->StartHeapObjectsTrackingImpl();
@@ -153,6 +345,22 @@ HeapSnapshot* HeapProfiler::TakeSnapshotImpl(String* name,
   return TakeSnapshotImpl(snapshots_->names()->GetName(name), type, control);
 }
 
+bool HeapProfiler::StreamSnapshotImpl(v8::OutputStream* stream,
+                                      v8::ActivityControl* control) {
+  // Names collected during the traversal are only needed until the stream
+  // is complete, so they live in a collection of their own. Like the
+  // writer's string table, it only keeps a bounded number of them.
+  HeapSnapshotsCollection scratch;
+  scratch.names()->set_max_stored_strings(
+      HeapSnapshotStreamWriter::kMaxStringTableSize);
+  HeapSnapshot snapshot(&scratch, HeapSnapshot::kFull, "", 0);
+  HeapSnapshotStreamWriter writer(stream);
+  snapshot.set_stream_writer(&writer);
+  HeapSnapshotGenerator generator(&snapshot, control);
+  return generator.GenerateSnapshot();
+}
+
+
 void HeapProfiler::StartHeapObjectsTrackingImpl() {
   snapshots_->StartHeapObjectsTracking();
 }
@@ -213,6 +421,33 @@ void HeapProfiler::DeleteAllSnapshots() {
 }
 
 
+bool HeapProfiler::StartSamplingHeapProfiler(int sample_interval) {
+  Isolate* isolate = Isolate::Current();
+  HeapProfiler* profiler = isolate->heap_profiler();
+  ASSERT(profiler != NULL);
+  if (profiler->sampling_heap_profiler_ != NULL) return false;
+  profiler->sampling_heap_profiler_ =
+      new SamplingHeapProfiler(isolate->heap(), sample_interval);
+  return true;
+}
+
+
+void HeapProfiler::StopSamplingHeapProfiler() {
+  HeapProfiler* profiler = Isolate::Current()->heap_profiler();
+  ASSERT(profiler != NULL);
+  delete profiler->sampling_heap_profiler_;
+  profiler->sampling_heap_profiler_ = NULL;
+}
+
+
+SamplingHeapProfiler::Node* HeapProfiler::GetAllocationProfileRoot() {
+  HeapProfiler* profiler = Isolate::Current()->heap_profiler();
+  ASSERT(profiler != NULL);
+  if (profiler->sampling_heap_profiler_ == NULL) return NULL;
+  return profiler->sampling_heap_profiler_->root();
+}
+
+
 void HeapProfiler::ObjectMoveEvent(Address from, Address to) {
   snapshots_->ObjectMoveEvent(from, to);
 }
@@ -35,6 +35,7 @@ namespace internal {
 
 class HeapSnapshot;
 class HeapSnapshotsCollection;
+class StringsStorage;
 
 #define HEAP_PROFILE(heap, call)                                             \
   do {                                                                       \
@@ -44,6 +45,98 @@ class HeapSnapshotsCollection;
     }                                                                        \
   } while (false)
 
+// Samples allocations at Poisson distributed intervals of allocated bytes
+// and aggregates them into a tree by the JavaScript stack at the allocation
+// site. New space allocations are observed by lowering the inline allocation
+// limit, so allocations from generated code are sampled as well. Sampled
+// objects are held through weak handles, which lets the tree account for how
+// much of the sampled memory is still alive after each GC.
+class SamplingHeapProfiler {
+ public:
+  class Node : public Malloced {
+   public:
+    Node(const char* name,
+         const char* resource_name,
+         int line_number,
+         int start_position)
+        : name_(name),
+          resource_name_(resource_name),
+          line_number_(line_number),
+          start_position_(start_position),
+          samples_count_(0),
+          size_(0),
+          live_samples_count_(0),
+          live_size_(0),
+          children_(4) { }
+    ~Node();
+
+    const char* name() const { return name_; }
+    const char* resource_name() const { return resource_name_; }
+    int line_number() const { return line_number_; }
+    int samples_count() const { return samples_count_; }
+    intptr_t size() const { return size_; }
+    int live_samples_count() const { return live_samples_count_; }
+    intptr_t live_size() const { return live_size_; }
+    const List<Node*>* children() const { return &children_; }
+
+   private:
+    Node* FindOrAddChild(const char* name,
+                         const char* resource_name,
+                         int start_position,
+                         Script* script);
+
+    const char* name_;
+    const char* resource_name_;
+    int line_number_;
+    int start_position_;
+    int samples_count_;
+    intptr_t size_;
+    int live_samples_count_;
+    intptr_t live_size_;
+    List<Node*> children_;
+
+    friend class SamplingHeapProfiler;
+    DISALLOW_COPY_AND_ASSIGN(Node);
+  };
+
+  SamplingHeapProfiler(Heap* heap, int sample_interval);
+  ~SamplingHeapProfiler();
+
+  // Called from new space when |bytes| have been allocated since the
+  // previous step. |object| of |size| bytes is the allocation that hit the
+  // lowered inline allocation limit.
+  void NewSpaceAllocationStep(intptr_t bytes, HeapObject* object, int size);
+
+  // Called for each allocation in the old generation.
+  void OldSpaceAllocation(HeapObject* object, int size);
+
+  Node* root() { return root_; }
+
+ private:
+  struct Sample;
+
+  static void OnSampleDied(v8::Persistent<v8::Value> handle, void* parameter);
+
+  // Accounts for |bytes| of allocation and samples |object| if the current
+  // sampling interval is exhausted. Returns true if a new interval started.
+  bool Step(intptr_t bytes, HeapObject* object, int size);
+  intptr_t NextSampleInterval();
+  void SampleObject(HeapObject* object, int size);
+
+  static const int kMaxStackDepth = 64;
+
+  Heap* heap_;
+  int sample_interval_;
+  intptr_t bytes_until_sample_;
+  StringsStorage* names_;
+  Node* root_;
+  // Doubly linked list of samples that are still alive.
+  Sample* samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingHeapProfiler);
+};
+
+
 class HeapProfiler {
  public:
   static void SetUp();
@@ -58,6 +151,9 @@ class HeapProfiler {
                                     int type,
                                     v8::ActivityControl* control);
 
+  static bool StreamSnapshot(v8::OutputStream* stream,
+                             v8::ActivityControl* control);
+
   static void StartHeapObjectsTracking();
   static void StopHeapObjectsTracking();
   static SnapshotObjectId PushHeapObjectsStats(OutputStream* stream);
@@ -67,6 +163,10 @@ class HeapProfiler {
   static SnapshotObjectId GetSnapshotObjectId(Handle<Object> obj);
   static void DeleteAllSnapshots();
 
+  static bool StartSamplingHeapProfiler(int sample_interval);
+  static void StopSamplingHeapProfiler();
+  static SamplingHeapProfiler::Node* GetAllocationProfileRoot();
+
   void ObjectMoveEvent(Address from, Address to);
 
   void DefineWrapperClass(
@@ -78,6 +178,10 @@ class HeapProfiler {
     return snapshots_->is_tracking_objects();
   }
 
+  SamplingHeapProfiler* sampling_heap_profiler() {
+    return sampling_heap_profiler_;
+  }
+
  private:
   HeapProfiler();
   ~HeapProfiler();
@@ -87,6 +191,8 @@ class HeapProfiler {
   HeapSnapshot* TakeSnapshotImpl(String* name,
                                  int type,
                                  v8::ActivityControl* control);
+  bool StreamSnapshotImpl(v8::OutputStream* stream,
+                          v8::ActivityControl* control);
   void ResetSnapshots();
 
   void StartHeapObjectsTrackingImpl();
@@ -94,6 +200,7 @@ class HeapProfiler {
   SnapshotObjectId PushHeapObjectsStatsImpl(OutputStream* stream);
 
   HeapSnapshotsCollection* snapshots_;
+  SamplingHeapProfiler* sampling_heap_profiler_;
   unsigned next_snapshot_uid_;
   List<v8::HeapProfiler::WrapperInfoCallback> wrapper_callbacks_;
 };
@@ -132,6 +132,7 @@ Heap::Heap()
       gc_safe_size_of_old_object_(NULL),
       total_regexp_code_generated_(0),
       tracer_(NULL),
+      gc_events_(NULL),
       young_survivors_after_last_gc_(0),
       high_survival_rate_period_length_(0),
       survival_rate_(0),
@@ -603,9 +604,12 @@ bool Heap::CollectGarbage(AllocationSpace space,
 
 void Heap::PerformScavenge() {
   GCTracer tracer(this, NULL, NULL);
+  tracer.set_gc_count(gc_count_);
   if (incremental_marking()->IsStopped()) {
+    tracer.set_collector(SCAVENGER);
     PerformGarbageCollection(SCAVENGER, &tracer);
   } else {
+    tracer.set_collector(MARK_COMPACTOR);
     PerformGarbageCollection(MARK_COMPACTOR, &tracer);
   }
 }
@@ -2744,7 +2748,9 @@ bool Heap::CreateInitialObjects() {
   set_string_split_cache(FixedArray::cast(obj));
 
   // Allocate cache for external strings pointing to native source code.
-  { MaybeObject* maybe_obj = AllocateFixedArray(Natives::GetBuiltinsCount());
+  // Experimental natives are numbered after the natives.
+  { MaybeObject* maybe_obj = AllocateFixedArray(
+        Natives::GetBuiltinsCount() + ExperimentalNatives::GetBuiltinsCount());
     if (!maybe_obj->ToObject(&obj)) return false;
   }
   set_natives_source_cache(FixedArray::cast(obj));
@@ -3557,6 +3563,13 @@ MaybeObject* Heap::CreateCode(const CodeDesc& desc,
   if (code->is_call_stub() || code->is_keyed_call_stub()) {
     code->set_check_type(RECEIVER_MAP_CHECK);
   }
+  // The garbage collector reads the code aging state before the code
+  // generator has filled in the rest of the flags.
+  if (code->kind() == Code::FUNCTION) {
+    code->set_has_code_age_sequence(false);
+  } else if (code->kind() == Code::OPTIMIZED_FUNCTION) {
+    code->set_optimized_code_age(0);
+  }
   code->set_deoptimization_data(empty_fixed_array(), SKIP_WRITE_BARRIER);
   code->set_type_feedback_info(undefined_value(), SKIP_WRITE_BARRIER);
   code->set_handler_table(empty_fixed_array(), SKIP_WRITE_BARRIER);
@@ -3920,7 +3933,9 @@ void Heap::InitializeJSObjectFromMap(JSObject* obj,
 }
 
 
-MaybeObject* Heap::AllocateJSObjectFromMap(Map* map, PretenureFlag pretenure) {
+MaybeObject* Heap::AllocateJSObjectFromMap(Map* map,
+                                           PretenureFlag pretenure,
+                                           bool allocate_properties) {
   // JSFunctions should be allocated using AllocateFunction to be
   // properly initialized.
   ASSERT(map->instance_type() != JS_FUNCTION_TYPE);
@@ -3931,13 +3946,14 @@ MaybeObject* Heap::AllocateJSObjectFromMap(Map* map, PretenureFlag pretenure) {
   ASSERT(map->instance_type() != JS_BUILTINS_OBJECT_TYPE);
 
   // Allocate the backing storage for the properties.
-  int prop_size =
-      map->pre_allocated_property_fields() +
-      map->unused_property_fields() -
-      map->inobject_properties();
-  ASSERT(prop_size >= 0);
-  Object* properties;
-  { MaybeObject* maybe_properties = AllocateFixedArray(prop_size, pretenure);
+  Object* properties = empty_fixed_array();
+  if (allocate_properties) {
+    int prop_size =
+        map->pre_allocated_property_fields() +
+        map->unused_property_fields() -
+        map->inobject_properties();
+    ASSERT(prop_size >= 0);
+    MaybeObject* maybe_properties = AllocateFixedArray(prop_size, pretenure);
     if (!maybe_properties->ToObject(&properties)) return maybe_properties;
   }
 
@@ -4238,6 +4254,21 @@ MaybeObject* Heap::CopyJSObject(JSObject* source) {
     }
     JSObject::cast(clone)->set_properties(FixedArray::cast(prop), wb_mode);
   }
+  // Double fields own their heap numbers, so the clone needs copies.
+  if (source->HasFastProperties()) {
+    DescriptorArray* descs = map->instance_descriptors();
+    for (int i = 0; i < descs->number_of_descriptors(); i++) {
+      PropertyDetails details = descs->GetDetails(i);
+      if (details.type() != FIELD || !details.IsDoubleField()) continue;
+      int index = descs->GetFieldIndex(i);
+      double value = HeapNumber::cast(source->FastPropertyAt(index))->value();
+      Object* number;
+      { MaybeObject* maybe_number = AllocateHeapNumber(value);
+        if (!maybe_number->ToObject(&number)) return maybe_number;
+      }
+      JSObject::cast(clone)->FastPropertyAtPut(index, number);
+    }
+  }
   // Return the new clone.
   return clone;
 }
@@ -6153,6 +6184,8 @@ bool Heap::SetUp(bool create_heap_objects) {
 
   if (FLAG_parallel_recompilation) relocation_mutex_ = OS::CreateMutex();
 
+  if (FLAG_record_gc_events) gc_events_ = new GCEventRing();
+
   return true;
 }
 
@@ -6241,6 +6274,9 @@ void Heap::TearDown() {
 
   delete relocation_mutex_;
 
+  delete gc_events_;
+  gc_events_ = NULL;
+
 #ifdef DEBUG
   delete debug_utils_;
   debug_utils_ = NULL;
@@ -6248,6 +6284,14 @@ void Heap::TearDown() {
 }
 
 
+void Heap::SampleOldSpaceAllocation(HeapObject* object, int size_in_bytes) {
+  SamplingHeapProfiler* sampler =
+      isolate_->heap_profiler()->sampling_heap_profiler();
+  ASSERT(sampler != NULL);
+  sampler->OldSpaceAllocation(object, size_in_bytes);
+}
+
+
 void Heap::Shrink() {
   // Try to shrink all paged spaces.
   PagedSpaces spaces;
@@ -6826,7 +6870,11 @@ GCTracer::GCTracer(Heap* heap,
       heap_(heap),
       gc_reason_(gc_reason),
       collector_reason_(collector_reason) {
-  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+  if (!FLAG_trace_gc &&
+      !FLAG_print_cumulative_gc_stat &&
+      heap_->gc_events() == NULL) {
+    return;
+  }
   start_time_ = OS::TimeCurrentMillis();
   start_object_size_ = heap_->SizeOfObjects();
   start_memory_size_ = heap_->isolate()->memory_allocator()->Size();
@@ -6835,6 +6883,14 @@ GCTracer::GCTracer(Heap* heap,
     scopes_[i] = 0;
   }
 
+  if (heap_->gc_events() != NULL) {
+    AllSpaces spaces;
+    int i = FIRST_SPACE;
+    for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
+      start_space_sizes_[i++] = space->SizeOfObjects();
+    }
+  }
+
   in_free_list_or_wasted_before_gc_ = CountTotalHolesSize();
 
   allocated_since_last_gc_ =
@@ -6855,14 +6911,24 @@ GCTracer::GCTracer(Heap* heap,
 
 
 GCTracer::~GCTracer() {
-  // Printf ONE line iff flag is set.
-  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+  if (!FLAG_trace_gc &&
+      !FLAG_print_cumulative_gc_stat &&
+      heap_->gc_events() == NULL) {
+    return;
+  }
 
   bool first_gc = (heap_->last_gc_end_timestamp_ == 0);
 
   heap_->alive_after_last_gc_ = heap_->SizeOfObjects();
   heap_->last_gc_end_timestamp_ = OS::TimeCurrentMillis();
 
+  if (heap_->gc_events() != NULL) {
+    RecordEvent(heap_->last_gc_end_timestamp_ - start_time_);
+  }
+
+  // Printf ONE line iff flag is set.
+  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+
   int time = static_cast<int>(heap_->last_gc_end_timestamp_ - start_time_);
 
   // Update cumulative GC statistics if required.
@@ -6990,6 +7056,61 @@ const char* GCTracer::CollectorString() {
 }
 
 
+void GCTracer::RecordEvent(double pause_time) {
+  GCEventRecord record;
+  record.collector = collector_;
+  record.gc_count = gc_count_;
+  record.start_time = start_time_ - heap_->isolate()->time_millis_at_init();
+  record.pause_time = pause_time;
+  if (collector_ == SCAVENGER) {
+    record.incremental_time = steps_took_since_last_gc_;
+    record.incremental_steps = steps_count_since_last_gc_;
+  } else {
+    record.incremental_time = steps_took_;
+    record.incremental_steps = steps_count_;
+  }
+  for (int i = 0; i < Scope::kNumberOfScopes; i++) {
+    record.scopes[i] = scopes_[i];
+  }
+  record.promoted_size = promoted_objects_size_;
+  record.freed_size = Max(start_object_size_ - heap_->SizeOfObjects(),
+                          static_cast<intptr_t>(0));
+  AllSpaces spaces;
+  int i = FIRST_SPACE;
+  for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
+    record.space_sizes_before[i] = start_space_sizes_[i];
+    record.space_sizes_after[i] = space->SizeOfObjects();
+    i++;
+  }
+  heap_->gc_events()->Push(record);
+}
+
+
+void GCEventRing::Push(const GCEventRecord& record) {
+  Atomic32 head = NoBarrier_Load(&head_);
+  Atomic32 next = (head + 1) % kCapacity;
+  if (next == Acquire_Load(&tail_)) {
+    // The consumer has not caught up, drop the record rather than
+    // overwriting one that may be read concurrently.
+    dropped_++;
+    return;
+  }
+  records_[head] = record;
+  records_[head].dropped_before = dropped_;
+  dropped_ = 0;
+  Release_Store(&head_, next);
+}
+
+
+bool GCEventRing::Pop(GCEventRecord* record) {
+  Atomic32 tail = NoBarrier_Load(&tail_);
+  if (tail == Acquire_Load(&head_)) return false;
+  *record = records_[tail];
+  Release_Store(&tail_, (tail + 1) % kCapacity);
+  return true;
+}
+
+
 int KeyedLookupCache::Hash(Map* map, String* name) {
   // Uses only lower 32 bits if pointers are larger.
   uintptr_t addr_hash =
@@ -244,9 +244,12 @@ namespace internal {
   V(infinity_symbol, "Infinity")                                         \
   V(minus_infinity_symbol, "-Infinity")                                  \
   V(hidden_stack_trace_symbol, "v8::hidden_stack_trace")                 \
+  V(raw_stack_trace_symbol, "v8::raw_stack_trace")                       \
+  V(formatted_stack_trace_symbol, "v8::formatted_stack_trace")           \
   V(query_colon_symbol, "(?:)")
 
 // Forward declarations.
+class GCEventRing;
 class GCTracer;
 class HeapStats;
 class Isolate;
@@ -603,11 +606,16 @@ class Heap {
       JSFunction* constructor, JSGlobalProxy* global);
 
   // Allocates and initializes a new JavaScript object based on a map.
+  // Without allocate_properties the object gets the empty fixed array as
+  // its properties, which is only valid for maps that keep all their
+  // fields in-object.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
   // failed.
   // Please note this does not perform a garbage collection.
   MUST_USE_RESULT MaybeObject* AllocateJSObjectFromMap(
-      Map* map, PretenureFlag pretenure = NOT_TENURED);
+      Map* map,
+      PretenureFlag pretenure = NOT_TENURED,
+      bool allocate_properties = true);
 
   // Allocates a heap object based on the map.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
@@ -1489,6 +1497,13 @@ class Heap {
 
   GCTracer* tracer() { return tracer_; }
 
+  // Reports an old generation allocation to the sampling heap profiler.
+  void SampleOldSpaceAllocation(HeapObject* object, int size_in_bytes);
+
+  // Ring of structured GC event records, or NULL unless the heap was set up
+  // with --record_gc_events.
+  GCEventRing* gc_events() { return gc_events_; }
+
   // Returns the size of objects residing in non new spaces.
   intptr_t PromotedSpaceSizeOfObjects();
 
@@ -1931,6 +1946,7 @@ class Heap {
 
   GCTracer* tracer_;
 
+  GCEventRing* gc_events_;
 
   // Allocates a small number to string cache.
   MUST_USE_RESULT MaybeObject* AllocateInitialNumberStringCache();
@@ -2512,6 +2528,10 @@ class GCTracer BASE_EMBEDDED {
   // Returns a string matching the collector.
   const char* CollectorString();
 
+  // Pushes a structured record of this collection to the heap's GC event
+  // ring.
+  void RecordEvent(double pause_time);
+
   // Returns size of object in heap (in MB).
   inline double SizeOfHeapObjects();
 
@@ -2521,6 +2541,10 @@ class GCTracer BASE_EMBEDDED {
   // Size of objects in heap set in constructor.
   intptr_t start_object_size_;
 
+  // Size of objects in each space set in constructor when GC events are
+  // recorded.
+  intptr_t start_space_sizes_[LAST_SPACE + 1];
+
   // Size of memory allocated from OS set in constructor.
   intptr_t start_memory_size_;
 
@@ -2566,6 +2590,55 @@ class GCTracer BASE_EMBEDDED {
 };
 
 
+// Structured description of a single garbage collection. Times are in
+// milliseconds, sizes in bytes.
+struct GCEventRecord {
+  GarbageCollector collector;
+  unsigned int gc_count;
+  // Number of records dropped because the ring was full just before this
+  // record was pushed.
+  int dropped_before;
+  double start_time;
+  double pause_time;
+  double incremental_time;
+  int incremental_steps;
+  double scopes[GCTracer::Scope::kNumberOfScopes];
+  intptr_t promoted_size;
+  intptr_t freed_size;
+  intptr_t space_sizes_before[LAST_SPACE + 1];
+  intptr_t space_sizes_after[LAST_SPACE + 1];
+};
+
+
+// Lock-free ring of GC event records for a single producer (the heap) and a
+// single consumer (the embedder polling through the API). The producer never
+// overwrites unread records; when the ring is full new records are dropped
+// and the count of dropped records is reported with the next pushed one.
+class GCEventRing {
+ public:
+  static const int kCapacity = 64;
+
+  GCEventRing() : head_(0), tail_(0), dropped_(0) { }
+
+  // Executed on the isolate thread during GC.
+  void Push(const GCEventRecord& record);
+
+  // Executed on the consumer thread. Returns false if the ring is empty.
+  bool Pop(GCEventRecord* record);
+
+ private:
+  GCEventRecord records_[kCapacity];
+  // Index of the next record to be written. Only written by the producer.
+  Atomic32 head_;
+  // Index of the next record to be read. Only written by the consumer.
+  Atomic32 tail_;
+  // Records dropped since the last successful push. Producer only.
+  int dropped_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCEventRing);
+};
+
+
 class StringSplitCache {
  public:
   static Object* Lookup(FixedArray* cache, String* string, String* pattern);
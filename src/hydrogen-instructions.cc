@@ -694,6 +694,30 @@ void HCallConstantFunction::PrintDataTo(StringStream* stream) {
 }
 
 
+void HOrderedHashTableLookup::PrintDataTo(StringStream* stream) {
+  switch (op()) {
+    case kMapGet: stream->Add("Map.get "); break;
+    case kMapHas: stream->Add("Map.has "); break;
+    case kSetHas: stream->Add("Set.has "); break;
+    default: UNREACHABLE();
+  }
+  receiver()->PrintNameTo(stream);
+  stream->Add(" ");
+  table()->PrintNameTo(stream);
+  stream->Add(" ");
+  key()->PrintNameTo(stream);
+}
+
+
+void HCallFastApiFunction::PrintDataTo(StringStream* stream) {
+  stream->Add("%o ", function()->shared()->DebugName());
+  for (int i = 0; i < OperandCount(); i++) {
+    if (i > 0) stream->Add(", ");
+    OperandAt(i)->PrintNameTo(stream);
+  }
+}
+
+
 void HCallNamed::PrintDataTo(StringStream* stream) {
   stream->Add("%o ", *name());
   HUnaryCall::PrintDataTo(stream);
@@ -1401,6 +1425,16 @@ void HSimulate::PrintDataTo(StringStream* stream) {
 }
 
 
+void HCapturedObject::PrintDataTo(StringStream* stream) {
+  stream->Add("map=%p", *map());
+  for (int i = 0; i < values_.length(); ++i) {
+    stream->Add(i == 0 ? " [" : ", ");
+    values_[i]->PrintNameTo(stream);
+  }
+  if (values_.length() > 0) stream->Add("]");
+}
+
+
 void HDeoptimize::PrintDataTo(StringStream* stream) {
   if (OperandCount() == 0) return;
   OperandAt(0)->PrintNameTo(stream);
@@ -1701,6 +1735,12 @@ void HLoadNamedField::PrintDataTo(StringStream* stream) {
 }
 
 
+void HLoadNamedDoubleField::PrintDataTo(StringStream* stream) {
+  object()->PrintNameTo(stream);
+  stream->Add(" @%d%s", offset(), is_in_object() ? "[in-object]" : "");
+}
+
+
 // Returns true if an instance of this map can never find a property with this
 // name in its prototype chain.  This means all prototypes up to the top are
 // fast and don't have the name in them.  It would be good if we could optimize
@@ -1753,6 +1793,8 @@ HLoadNamedFieldPolymorphic::HLoadNamedFieldPolymorphic(HValue* context,
     if (lookup.IsFound()) {
       switch (lookup.type()) {
         case FIELD: {
+          // Double fields are left to the generic load.
+          if (lookup.GetPropertyDetails().IsDoubleField()) break;
           int index = lookup.GetLocalFieldIndexFromMap(*map);
           if (index < 0) {
             SetGVNFlag(kDependsOnInobjectFields);
@@ -1989,6 +2031,16 @@ void HStoreNamedField::PrintDataTo(StringStream* stream) {
 }
 
 
+void HStoreNamedDoubleField::PrintDataTo(StringStream* stream) {
+  object()->PrintNameTo(stream);
+  stream->Add(".");
+  stream->Add(*String::cast(*name())->ToCString());
+  stream->Add(" = ");
+  value()->PrintNameTo(stream);
+  stream->Add(" @%d%s", offset(), is_in_object() ? "[in-object]" : "");
+}
+
+
 void HStoreKeyedFastElement::PrintDataTo(StringStream* stream) {
   object()->PrintNameTo(stream);
   stream->Add("[");
@@ -2242,6 +2294,17 @@ HType HFastLiteral::CalculateInferredType() {
 }
 
 
+void HFastLiteral::RecordInObjectValues(Zone* zone) {
+  boilerplate_map_ = Handle<Map>(boilerplate_->map());
+  int count = boilerplate_map_->inobject_properties();
+  in_object_values_ = new(zone) ZoneList<Handle<Object> >(count, zone);
+  for (int i = 0; i < count; i++) {
+    in_object_values_->Add(
+        Handle<Object>(boilerplate_->InObjectPropertyAt(i)), zone);
+  }
+}
+
+
 HType HArrayLiteral::CalculateInferredType() {
   return HType::JSArray();
 }
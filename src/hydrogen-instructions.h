@@ -74,6 +74,7 @@ class LChunkBuilder;
   V(BoundsCheck)                               \
   V(Branch)                                    \
   V(CallConstantFunction)                      \
+  V(CallFastApiFunction)                       \
   V(CallFunction)                              \
   V(CallGlobal)                                \
   V(CallKeyed)                                 \
@@ -82,6 +83,7 @@ class LChunkBuilder;
   V(CallNew)                                   \
   V(CallRuntime)                               \
   V(CallStub)                                  \
+  V(CapturedObject)                            \
   V(Change)                                    \
   V(CheckFunction)                             \
   V(CheckInstanceType)                         \
@@ -136,6 +138,7 @@ class LChunkBuilder;
   V(LoadKeyedFastElement)                      \
   V(LoadKeyedGeneric)                          \
   V(LoadKeyedSpecializedArrayElement)          \
+  V(LoadNamedDoubleField)                      \
   V(LoadNamedField)                            \
   V(LoadNamedFieldPolymorphic)                 \
   V(LoadNamedGeneric)                          \
@@ -144,6 +147,7 @@ class LChunkBuilder;
   V(Mod)                                       \
   V(Mul)                                       \
   V(ObjectLiteral)                             \
+  V(OrderedHashTableLookup)                    \
   V(OsrEntry)                                  \
   V(OuterContext)                              \
   V(Parameter)                                 \
@@ -165,6 +169,7 @@ class LChunkBuilder;
   V(StoreKeyedFastElement)                     \
   V(StoreKeyedGeneric)                         \
   V(StoreKeyedSpecializedArrayElement)         \
+  V(StoreNamedDoubleField)                     \
   V(StoreNamedField)                           \
   V(StoreNamedGeneric)                         \
   V(StringAdd)                                 \
@@ -1713,6 +1718,84 @@ class HCallConstantFunction: public HCall<0> {
 };
 
 
+// Calls the fast call handler of an API function. The operands are the
+// parameters passed to the C function: the receiver's first internal field
+// if the handler takes the receiver, followed by the arguments.
+class HCallFastApiFunction: public HTemplateInstruction<
+    FunctionTemplateInfo::kMaxFastCallParameters> {
+ public:
+  HCallFastApiFunction(Handle<JSFunction> function,
+                       Address callback,
+                       int signature,
+                       int parameter_count)
+      : function_(function),
+        callback_(callback),
+        signature_(signature),
+        parameter_count_(parameter_count) {
+    ASSERT(parameter_count <= FunctionTemplateInfo::kMaxFastCallParameters);
+    switch (return_type()) {
+      case FAST_CALL_INT32:
+        set_representation(Representation::Integer32());
+        break;
+      case FAST_CALL_DOUBLE:
+        set_representation(Representation::Double());
+        break;
+      default:
+        set_representation(Representation::Tagged());
+        break;
+    }
+    SetAllSideEffects();
+  }
+
+  Handle<JSFunction> function() const { return function_; }
+  Address callback() const { return callback_; }
+
+  FastCallType return_type() const {
+    return FunctionTemplateInfo::FastCallReturnTypeField::decode(signature_);
+  }
+
+  bool passes_receiver() const {
+    return FunctionTemplateInfo::FastCallReceiverTypeField::decode(
+        signature_) == FAST_CALL_EXTERNAL;
+  }
+
+  FastCallType ParameterTypeAt(int index) const {
+    if (passes_receiver()) {
+      if (index == 0) return FAST_CALL_EXTERNAL;
+      index--;
+    }
+    return FunctionTemplateInfo::FastCallArgumentType(signature_, index);
+  }
+
+  virtual int OperandCount() { return parameter_count_; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    switch (ParameterTypeAt(index)) {
+      case FAST_CALL_INT32:
+        return Representation::Integer32();
+      case FAST_CALL_DOUBLE:
+        return Representation::Double();
+      default:
+        return Representation::Tagged();
+    }
+  }
+
+  virtual HType CalculateInferredType() {
+    return return_type() == FAST_CALL_BOOL ? HType::Boolean() : HType::Tagged();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(CallFastApiFunction)
+
+ private:
+  Handle<JSFunction> function_;
+  Address callback_;
+  int signature_;
+  int parameter_count_;
+};
+
+
 class HCallKeyed: public HBinaryCall {
  public:
   HCallKeyed(HValue* context, HValue* key, int argument_count)
@@ -2469,6 +2552,56 @@ class HArgumentsObject: public HTemplateInstruction<0> {
 };
 
 
+// The state of an object literal whose allocation was removed by escape
+// analysis.  Captured objects only appear in deoptimization environments,
+// where the deoptimizer materializes them from the map and the values of the
+// in-object fields.  Every store to the object creates a new state that
+// replaces the previous one in the environment.
+class HCapturedObject: public HInstruction {
+ public:
+  HCapturedObject(Handle<Map> map,
+                  HCapturedObject* previous_state,
+                  Zone* zone)
+      : map_(map),
+        previous_state_(previous_state),
+        values_(map->inobject_properties(), zone),
+        zone_(zone) {
+    set_representation(Representation::Tagged());
+  }
+
+  Handle<Map> map() const { return map_; }
+  HCapturedObject* previous_state() const { return previous_state_; }
+
+  void AddField(HValue* value) {
+    values_.Add(NULL, zone_);
+    SetOperandAt(values_.length() - 1, value);
+  }
+  HValue* FieldAt(int index) { return values_[index]; }
+  int field_count() const { return values_.length(); }
+
+  virtual int OperandCount() { return values_.length(); }
+  virtual HValue* OperandAt(int index) { return values_[index]; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(CapturedObject)
+
+ protected:
+  virtual void InternalSetOperandAt(int index, HValue* value) {
+    values_[index] = value;
+  }
+
+ private:
+  Handle<Map> map_;
+  HCapturedObject* previous_state_;
+  ZoneList<HValue*> values_;
+  Zone* zone_;
+};
+
+
 class HConstant: public HTemplateInstruction<0> {
  public:
   HConstant(Handle<Object> handle, Representation r);
@@ -3330,6 +3463,67 @@ class HRandom: public HTemplateInstruction<1> {
 };
 
 
+// Inlined Map.prototype.get, Map.prototype.has and Set.prototype.has on
+// the backing OrderedHashTable of the receiver.  Smi and symbol keys are
+// looked up inline, other keys are passed to the runtime.
+class HOrderedHashTableLookup: public HTemplateInstruction<4> {
+ public:
+  HOrderedHashTableLookup(HValue* context,
+                          HValue* receiver,
+                          HValue* table,
+                          HValue* key,
+                          BuiltinFunctionId op)
+      : op_(op) {
+    ASSERT(op == kMapGet || op == kMapHas || op == kSetHas);
+    SetOperandAt(0, context);
+    SetOperandAt(1, receiver);
+    SetOperandAt(2, table);
+    SetOperandAt(3, key);
+    set_representation(Representation::Tagged());
+  }
+
+  HValue* context() { return OperandAt(0); }
+  HValue* receiver() { return OperandAt(1); }
+  HValue* table() { return OperandAt(2); }
+  HValue* key() { return OperandAt(3); }
+  BuiltinFunctionId op() const { return op_; }
+
+  // Returns whether the value of the entry is loaded, as opposed to
+  // whether the key is present.
+  bool loads_value() const { return op_ == kMapGet; }
+  int entry_size() const {
+    return op_ == kSetHas ? OrderedHashSet::kEntrySize
+                          : OrderedHashMap::kEntrySize;
+  }
+  int chain_offset() const {
+    return op_ == kSetHas ? OrderedHashSet::kChainOffset
+                          : OrderedHashMap::kChainOffset;
+  }
+  Runtime::FunctionId runtime_function() const {
+    switch (op_) {
+      case kMapGet: return Runtime::kMapGet;
+      case kMapHas: return Runtime::kMapHas;
+      default: return Runtime::kSetHas;
+    }
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::Tagged();
+  }
+
+  virtual HType CalculateInferredType() {
+    return loads_value() ? HType::Tagged() : HType::Boolean();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(OrderedHashTableLookup)
+
+ private:
+  BuiltinFunctionId op_;
+};
+
+
 class HAdd: public HArithmeticBinaryOperation {
  public:
   HAdd(HValue* context, HValue* left, HValue* right)
@@ -4015,6 +4209,47 @@ class HLoadNamedField: public HUnaryOperation {
 };
 
 
+// Loads the value of a double field. The field's heap number is updated in
+// place, so its value is read out instead of the heap number itself.
+class HLoadNamedDoubleField: public HUnaryOperation {
+ public:
+  HLoadNamedDoubleField(HValue* object, bool is_in_object, int offset)
+      : HUnaryOperation(object),
+        is_in_object_(is_in_object),
+        offset_(offset) {
+    set_representation(Representation::Double());
+    SetFlag(kUseGVN);
+    SetGVNFlag(kDependsOnMaps);
+    if (is_in_object) {
+      SetGVNFlag(kDependsOnInobjectFields);
+    } else {
+      SetGVNFlag(kDependsOnBackingStoreFields);
+    }
+  }
+
+  HValue* object() { return OperandAt(0); }
+  bool is_in_object() const { return is_in_object_; }
+  int offset() const { return offset_; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::Tagged();
+  }
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(LoadNamedDoubleField)
+
+ protected:
+  virtual bool DataEquals(HValue* other) {
+    HLoadNamedDoubleField* b = HLoadNamedDoubleField::cast(other);
+    return is_in_object_ == b->is_in_object_ && offset_ == b->offset_;
+  }
+
+ private:
+  bool is_in_object_;
+  int offset_;
+};
+
+
 class HLoadNamedFieldPolymorphic: public HTemplateInstruction<2> {
  public:
   HLoadNamedFieldPolymorphic(HValue* context,
@@ -4390,6 +4625,49 @@ class HStoreNamedField: public HTemplateInstruction<2> {
 };
 
 
+// Stores into an existing double field by overwriting the value of the
+// field's heap number, which needs neither an allocation nor a write barrier.
+class HStoreNamedDoubleField: public HTemplateInstruction<2> {
+ public:
+  HStoreNamedDoubleField(HValue* obj,
+                         Handle<String> name,
+                         HValue* val,
+                         bool in_object,
+                         int offset)
+      : name_(name),
+        is_in_object_(in_object),
+        offset_(offset) {
+    SetOperandAt(0, obj);
+    SetOperandAt(1, val);
+    SetFlag(kDeoptimizeOnUndefined);
+    if (is_in_object_) {
+      SetGVNFlag(kChangesInobjectFields);
+    } else {
+      SetGVNFlag(kChangesBackingStoreFields);
+    }
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreNamedDoubleField)
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return index == 1 ? Representation::Double() : Representation::Tagged();
+  }
+  virtual void PrintDataTo(StringStream* stream);
+
+  HValue* object() { return OperandAt(0); }
+  HValue* value() { return OperandAt(1); }
+
+  Handle<String> name() const { return name_; }
+  bool is_in_object() const { return is_in_object_; }
+  int offset() const { return offset_; }
+
+ private:
+  Handle<String> name_;
+  bool is_in_object_;
+  int offset_;
+};
+
+
 class HStoreNamedGeneric: public HTemplateInstruction<3> {
  public:
   HStoreNamedGeneric(HValue* context,
@@ -4825,7 +5103,8 @@ class HFastLiteral: public HMaterializedLiteral<1> {
                int depth)
       : HMaterializedLiteral<1>(literal_index, depth),
         boilerplate_(boilerplate),
-        total_size_(total_size) {
+        total_size_(total_size),
+        in_object_values_(NULL) {
     SetOperandAt(0, context);
     SetGVNFlag(kChangesNewSpacePromotion);
   }
@@ -4839,6 +5118,16 @@ class HFastLiteral: public HMaterializedLiteral<1> {
   Handle<JSObject> boilerplate() const { return boilerplate_; }
   int total_size() const { return total_size_; }
 
+  // Escape analysis runs when handles can no longer be created, so the
+  // map and in-object values of the boilerplate are recorded while the
+  // graph is built.
+  void RecordInObjectValues(Zone* zone);
+  bool has_in_object_values() const { return in_object_values_ != NULL; }
+  Handle<Map> boilerplate_map() const { return boilerplate_map_; }
+  Handle<Object> InObjectValueAt(int index) const {
+    return in_object_values_->at(index);
+  }
+
   virtual Representation RequiredInputRepresentation(int index) {
     return Representation::Tagged();
   }
@@ -4849,6 +5138,8 @@ class HFastLiteral: public HMaterializedLiteral<1> {
  private:
   Handle<JSObject> boilerplate_;
   int total_size_;
+  Handle<Map> boilerplate_map_;
+  ZoneList<Handle<Object> >* in_object_values_;
 };
 
 
@@ -3128,6 +3128,8 @@ bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
 
   InitializeInferredTypes();
   Canonicalize();
+  ForwardStoredFieldValues();
+  ReplaceNonEscapingLiterals();
 
   // Perform common subexpression elimination and loop-invariant code motion.
   if (FLAG_use_gvn) {
@@ -3153,6 +3155,7 @@ bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
   HStackCheckEliminator sce(this);
   sce.Process();
 
+  EliminateRedundantMapChecks();
   EliminateRedundantBoundsChecks();
   DehoistSimpleArrayIndexComputations();
 
@@ -3490,6 +3493,265 @@ void HGraph::EliminateRedundantBoundsChecks() {
 }
 
 
+typedef ZoneList<Handle<Map> > MapSet;
+
+
+static bool MapSetContains(MapSet* set, Handle<Map> map) {
+  for (int i = 0; i < set->length(); i++) {
+    if (set->at(i).is_identical_to(map)) return true;
+  }
+  return false;
+}
+
+
+static bool MapSetIsCoveredBy(MapSet* set, SmallMapList* maps) {
+  for (int i = 0; i < set->length(); i++) {
+    bool found = false;
+    for (int j = 0; j < maps->length() && !found; j++) {
+      found = maps->at(j).is_identical_to(set->at(i));
+    }
+    if (!found) return false;
+  }
+  return true;
+}
+
+
+// Maps each checked object to the set of maps it is known to have at a
+// program point.  Map sets are never mutated once inserted, so copies of
+// a table share them.
+class HCheckTable: public ZoneObject {
+ public:
+  explicit HCheckTable(Zone* zone) : objects_(4, zone), maps_(4, zone) { }
+
+  HCheckTable* Copy(Zone* zone) const {
+    HCheckTable* copy = new(zone) HCheckTable(zone);
+    copy->objects_.AddAll(objects_, zone);
+    copy->maps_.AddAll(maps_, zone);
+    return copy;
+  }
+
+  MapSet* Lookup(HValue* object) const {
+    for (int i = 0; i < objects_.length(); i++) {
+      if (objects_[i] == object) return maps_[i];
+    }
+    return NULL;
+  }
+
+  void Insert(HValue* object, MapSet* maps, Zone* zone) {
+    for (int i = 0; i < objects_.length(); i++) {
+      if (objects_[i] == object) {
+        maps_[i] = maps;
+        return;
+      }
+    }
+    objects_.Add(object, zone);
+    maps_.Add(maps, zone);
+  }
+
+  void Insert(HValue* object, Handle<Map> map, Zone* zone) {
+    MapSet* maps = new(zone) MapSet(1, zone);
+    maps->Add(map, zone);
+    Insert(object, maps, zone);
+  }
+
+  void Kill() {
+    objects_.Rewind(0);
+    maps_.Rewind(0);
+  }
+
+  // Keeps only what is known on both paths: objects present in both tables,
+  // with the union of their map sets.
+  void Merge(HCheckTable* other, Zone* zone) {
+    int i = 0;
+    while (i < objects_.length()) {
+      MapSet* other_maps = other->Lookup(objects_[i]);
+      if (other_maps == NULL) {
+        objects_.Remove(i);
+        maps_.Remove(i);
+        continue;
+      }
+      MapSet* maps = maps_[i];
+      for (int j = 0; j < other_maps->length(); j++) {
+        if (MapSetContains(maps, other_maps->at(j))) continue;
+        if (maps == maps_[i]) {
+          maps = new(zone) MapSet(maps_[i]->length() + 1, zone);
+          maps->AddAll(*maps_[i], zone);
+        }
+        maps->Add(other_maps->at(j), zone);
+      }
+      maps_[i] = maps;
+      i++;
+    }
+  }
+
+ private:
+  ZoneList<HValue*> objects_;
+  ZoneList<MapSet*> maps_;
+};
+
+
+static bool LoopChangesMaps(HLoopInformation* loop) {
+  for (int i = 0; i < loop->blocks()->length(); i++) {
+    for (HInstruction* instr = loop->blocks()->at(i)->first();
+         instr != NULL;
+         instr = instr->next()) {
+      if (instr->CheckGVNFlag(kChangesMaps) ||
+          instr->CheckGVNFlag(kChangesElementsKind)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+
+static bool InstanceTypeCheckIsCoveredBy(HCheckInstanceType* check,
+                                         MapSet* maps) {
+  for (int i = 0; i < maps->length(); i++) {
+    InstanceType type = maps->at(i)->instance_type();
+    if (check->is_interval_check()) {
+      InstanceType first;
+      InstanceType last;
+      check->GetCheckInterval(&first, &last);
+      if (type < first || type > last) return false;
+    } else {
+      uint8_t mask;
+      uint8_t tag;
+      check->GetCheckMaskAndTag(&mask, &tag);
+      if ((type & mask) != tag) return false;
+    }
+  }
+  return true;
+}
+
+
+static void RemoveRedundantCheck(HInstruction* check, HValue* object) {
+  if (FLAG_trace_check_elimination) {
+    PrintF("Removing redundant %s %d of value %d\n",
+           check->Mnemonic(), check->id(), object->id());
+  }
+  check->DeleteAndReplaceWith(object);
+}
+
+
+HCheckTable* HGraph::ComputeEntryCheckTable(HBasicBlock* block,
+                                            ZoneList<HCheckTable*>* tables) {
+  const ZoneList<HBasicBlock*>* predecessors = block->predecessors();
+  if (predecessors->is_empty()) return new(zone()) HCheckTable(zone());
+
+  if (block->IsLoopHeader()) {
+    // Only the loop entry edge has been visited.  What holds there survives
+    // the back edges unless an instruction in the loop can change maps.
+    HCheckTable* entry = tables->at(predecessors->at(0)->block_id());
+    if (entry == NULL || LoopChangesMaps(block->loop_information())) {
+      return new(zone()) HCheckTable(zone());
+    }
+    return entry->Copy(zone());
+  }
+
+  HCheckTable* table = NULL;
+  for (int i = 0; i < predecessors->length(); i++) {
+    HCheckTable* incoming = tables->at(predecessors->at(i)->block_id());
+    if (incoming == NULL) return new(zone()) HCheckTable(zone());
+    if (table == NULL) {
+      table = incoming->Copy(zone());
+    } else {
+      table->Merge(incoming, zone());
+    }
+  }
+
+  // The true branch of a map compare knows the compared map.
+  if (predecessors->length() == 1) {
+    HControlInstruction* end = predecessors->at(0)->end();
+    if (end->IsCompareMap() && end->SuccessorAt(0) == block) {
+      HCompareMap* compare = HCompareMap::cast(end);
+      table->Insert(compare->value(), compare->map(), zone());
+    }
+  }
+  return table;
+}
+
+
+// Removes map checks, instance type checks and smi checks whose outcome is
+// already implied by the maps a value is known to have.  Unlike GVN this
+// follows control flow: knowledge from both arms of a diamond is merged,
+// survives loops that cannot change maps, and is refined by map compares
+// and transitioning stores.  Stores that keep the map do not kill anything.
+// No code motion happens after GVN, so a removed check's uses can be
+// redirected to the checked value.
+void HGraph::EliminateRedundantMapChecks() {
+  if (!FLAG_check_elimination) return;
+
+  HPhase phase("H_Eliminate map checks", this);
+  ZoneList<HCheckTable*> tables(blocks()->length(), zone());
+  tables.AddBlock(NULL, blocks()->length(), zone());
+  for (int i = 0; i < blocks()->length(); ++i) {
+    HBasicBlock* block = blocks()->at(i);
+    HCheckTable* table = ComputeEntryCheckTable(block, &tables);
+    HInstruction* instr = block->first();
+    while (instr != NULL) {
+      HInstruction* next = instr->next();
+      if (instr->IsCheckMaps()) {
+        HCheckMaps* check = HCheckMaps::cast(instr);
+        MapSet* known = table->Lookup(check->value());
+        if (known != NULL && MapSetIsCoveredBy(known, check->map_set())) {
+          RemoveRedundantCheck(check, check->value());
+        } else {
+          SmallMapList* checked = check->map_set();
+          MapSet* maps = new(zone()) MapSet(checked->length(), zone());
+          for (int j = 0; j < checked->length(); j++) {
+            if (known == NULL || MapSetContains(known, checked->at(j))) {
+              maps->Add(checked->at(j), zone());
+            }
+          }
+          if (!maps->is_empty()) table->Insert(check->value(), maps, zone());
+        }
+      } else if (instr->IsCheckInstanceType()) {
+        HCheckInstanceType* check = HCheckInstanceType::cast(instr);
+        MapSet* known = table->Lookup(check->value());
+        if (known != NULL && InstanceTypeCheckIsCoveredBy(check, known)) {
+          RemoveRedundantCheck(check, check->value());
+        }
+      } else if (instr->IsCheckNonSmi()) {
+        HCheckNonSmi* check = HCheckNonSmi::cast(instr);
+        if (table->Lookup(check->value()) != NULL) {
+          RemoveRedundantCheck(check, check->value());
+        }
+      } else if (instr->IsStoreNamedField() &&
+                 !HStoreNamedField::cast(instr)->transition().is_null()) {
+        HStoreNamedField* store = HStoreNamedField::cast(instr);
+        table->Kill();
+        table->Insert(store->object(), store->transition(), zone());
+      } else if (instr->IsTransitionElementsKind()) {
+        HTransitionElementsKind* transition =
+            HTransitionElementsKind::cast(instr);
+        // The transition leaves objects that do not have the original map
+        // alone, so the object's map is only known afterwards if it was
+        // already known to be one of the two maps.
+        MapSet* known = table->Lookup(transition->object());
+        bool knows_result = known != NULL;
+        for (int j = 0; knows_result && j < known->length(); j++) {
+          knows_result =
+              known->at(j).is_identical_to(transition->original_map()) ||
+              known->at(j).is_identical_to(transition->transitioned_map());
+        }
+        table->Kill();
+        if (knows_result) {
+          table->Insert(transition->object(),
+                        transition->transitioned_map(),
+                        zone());
+        }
+      } else if (instr->CheckGVNFlag(kChangesMaps) ||
+                 instr->CheckGVNFlag(kChangesElementsKind)) {
+        table->Kill();
+      }
+      instr = next;
+    }
+    tables[block->block_id()] = table;
+  }
+}
+
+
 static void DehoistArrayIndex(ArrayInstructionInterface* array_operation) {
   HValue* index = array_operation->GetKey();
 
@@ -3577,6 +3839,253 @@ void HGraph::DehoistSimpleArrayIndexComputations() {
 }
 
 
+// Replaces a field load by the value stored to the field before.  If that
+// value was boxed for the store, uses that unbox the loaded value take the
+// unboxed value directly, so doubles stay in registers instead of being read
+// back from the heap number.
+static void ForwardStoredValue(HLoadNamedField* load, HValue* value) {
+  if (value->IsChange()) {
+    HValue* unboxed = HChange::cast(value)->value();
+    Representation representation = unboxed->representation();
+    ZoneList<HValue*> unboxing_uses(2, load->block()->zone());
+    for (HUseIterator it(load->uses()); !it.Done(); it.Advance()) {
+      HValue* use = it.value();
+      if (use->IsChange() &&
+          HChange::cast(use)->to().Equals(representation)) {
+        unboxing_uses.Add(use, load->block()->zone());
+      }
+    }
+    for (int i = 0; i < unboxing_uses.length(); i++) {
+      unboxing_uses[i]->DeleteAndReplaceWith(unboxed);
+    }
+  }
+  load->DeleteAndReplaceWith(value);
+}
+
+
+void HGraph::ForwardStoredFieldValues() {
+  if (!FLAG_forward_field_stores) return;
+
+  HPhase phase("H_Forward stored field values", this);
+  ZoneList<HStoreNamedField*> stores(4, zone());
+  ZoneList<HLoadNamedField*> forwarded_loads(4, zone());
+  ZoneList<HStoreNamedField*> forwarding_stores(4, zone());
+  for (int i = 0; i < blocks()->length(); ++i) {
+    stores.Rewind(0);
+    forwarded_loads.Rewind(0);
+    forwarding_stores.Rewind(0);
+    for (HInstruction* instr = blocks()->at(i)->first();
+         instr != NULL;
+         instr = instr->next()) {
+      if (instr->IsStoreNamedField()) {
+        HStoreNamedField* store = HStoreNamedField::cast(instr);
+        // Other objects may alias the object stored to.
+        int j = 0;
+        while (j < stores.length()) {
+          if (stores[j]->is_in_object() == store->is_in_object() &&
+              stores[j]->offset() == store->offset()) {
+            stores.Remove(j);
+          } else {
+            j++;
+          }
+        }
+        stores.Add(store, zone());
+      } else if (instr->IsLoadNamedField()) {
+        HLoadNamedField* load = HLoadNamedField::cast(instr);
+        for (int j = 0; j < stores.length(); j++) {
+          if (stores[j]->object() == load->object() &&
+              stores[j]->is_in_object() == load->is_in_object() &&
+              stores[j]->offset() == load->offset()) {
+            forwarded_loads.Add(load, zone());
+            forwarding_stores.Add(stores[j], zone());
+            break;
+          }
+        }
+      } else if (instr->CheckGVNFlag(kChangesInobjectFields) ||
+                 instr->CheckGVNFlag(kChangesBackingStoreFields)) {
+        stores.Rewind(0);
+      }
+    }
+
+    // Rewrite in program order, so a stored value that was itself a
+    // forwarded load has already been replaced.
+    for (int j = 0; j < forwarded_loads.length(); j++) {
+      ForwardStoredValue(forwarded_loads[j], forwarding_stores[j]->value());
+    }
+  }
+}
+
+
+// Returns the index of the in-object field at |offset| in objects with the
+// given map, or -1 if the access does not hit an in-object field.
+static int CapturedFieldIndex(Handle<Map> map, bool is_in_object, int offset) {
+  if (!is_in_object || offset < JSObject::kHeaderSize) return -1;
+  int index = (offset - JSObject::kHeaderSize) / kPointerSize;
+  return index < map->inobject_properties() ? index : -1;
+}
+
+
+// Only plain object literals without out-of-object storage or nested
+// literals are candidates for scalar replacement.
+static bool IsCapturableLiteral(HFastLiteral* literal) {
+  if (!literal->has_in_object_values()) return false;
+  Handle<JSObject> boilerplate = literal->boilerplate();
+  Handle<Map> map = literal->boilerplate_map();
+  if (boilerplate->map() != *map) return false;
+  if (map->instance_type() != JS_OBJECT_TYPE) return false;
+  if (literal->total_size() != map->instance_size()) return false;
+  if (map->instance_size() != JSObject::kHeaderSize +
+      map->inobject_properties() * kPointerSize) {
+    return false;
+  }
+  if (boilerplate->elements()->length() > 0) return false;
+  if (boilerplate->properties()->length() > 0) return false;
+  for (int i = 0; i < map->inobject_properties(); i++) {
+    if (literal->InObjectValueAt(i)->IsJSObject()) return false;
+  }
+  return true;
+}
+
+
+// A literal does not escape if it is only used by deoptimization
+// environments, map and smi checks, in-object field loads and in-object
+// field stores without map transitions in the block that allocates it.
+static bool IsNonEscapingLiteral(HFastLiteral* literal) {
+  Handle<Map> map = literal->boilerplate_map();
+  for (HUseIterator it(literal->uses()); !it.Done(); it.Advance()) {
+    HValue* use = it.value();
+    if (use->IsSimulate() || use->IsDeoptimize()) continue;
+    if (use->IsCheckNonSmi() && use->HasNoUses()) continue;
+    if (use->IsCheckMaps() && use->HasNoUses()) {
+      HCheckMaps* check = HCheckMaps::cast(use);
+      if (check->value() != literal) return false;
+      bool found = false;
+      for (int i = 0; i < check->map_set()->length(); i++) {
+        if (check->map_set()->at(i).is_identical_to(map)) found = true;
+      }
+      if (found) continue;
+      return false;
+    }
+    if (use->IsLoadNamedField()) {
+      HLoadNamedField* load = HLoadNamedField::cast(use);
+      if (CapturedFieldIndex(map, load->is_in_object(), load->offset()) < 0) {
+        return false;
+      }
+      continue;
+    }
+    if (use->IsStoreNamedField()) {
+      HStoreNamedField* store = HStoreNamedField::cast(use);
+      if (it.index() != 0 ||
+          store->value() == literal ||
+          store->value()->IsArgumentsObject() ||
+          store->block() != literal->block() ||
+          !store->transition().is_null() ||
+          CapturedFieldIndex(map, store->is_in_object(), store->offset()) < 0) {
+        return false;
+      }
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+
+// Replaces the allocation of a non-escaping literal by a chain of captured
+// object states, one per store, and forwards field loads to the stored
+// values.  Returns the initial state, which takes the place of the literal.
+static HCapturedObject* ReplaceNonEscapingLiteral(HFastLiteral* literal,
+                                                  Zone* zone) {
+  Handle<Map> map = literal->boilerplate_map();
+  HCapturedObject* initial_state = new(zone) HCapturedObject(map, NULL, zone);
+  for (int i = 0; i < map->inobject_properties(); i++) {
+    HConstant* constant = new(zone) HConstant(literal->InObjectValueAt(i),
+                                              Representation::Tagged());
+    constant->InsertBefore(literal);
+    initial_state->AddField(constant);
+  }
+  initial_state->InsertBefore(literal);
+
+  // Within the allocating block the state changes with every store.
+  HCapturedObject* state = initial_state;
+  HInstruction* instr = literal->next();
+  while (instr != NULL) {
+    HInstruction* next = instr->next();
+    if (instr->IsStoreNamedField() &&
+        HStoreNamedField::cast(instr)->object() == literal) {
+      HStoreNamedField* store = HStoreNamedField::cast(instr);
+      int index =
+          CapturedFieldIndex(map, store->is_in_object(), store->offset());
+      HCapturedObject* new_state = new(zone) HCapturedObject(map, state, zone);
+      for (int i = 0; i < state->field_count(); i++) {
+        new_state->AddField(i == index ? store->value() : state->FieldAt(i));
+      }
+      new_state->InsertBefore(store);
+      store->DeleteAndReplaceWith(NULL);
+      state = new_state;
+    } else if (instr->IsLoadNamedField() &&
+               HLoadNamedField::cast(instr)->object() == literal) {
+      HLoadNamedField* load = HLoadNamedField::cast(instr);
+      int index =
+          CapturedFieldIndex(map, load->is_in_object(), load->offset());
+      load->DeleteAndReplaceWith(state->FieldAt(index));
+    } else if ((instr->IsCheckNonSmi() || instr->IsCheckMaps()) &&
+               instr->OperandAt(0) == literal) {
+      instr->DeleteAndReplaceWith(NULL);
+    } else if (instr->IsSimulate() || instr->IsDeoptimize()) {
+      for (int i = 0; i < instr->OperandCount(); i++) {
+        if (instr->OperandAt(i) == literal) instr->SetOperandAt(i, state);
+      }
+    }
+    instr = next;
+  }
+
+  // All remaining uses are dominated by the allocating block and observe
+  // the final state of the object.
+  while (!literal->HasNoUses()) {
+    HUseIterator it(literal->uses());
+    HValue* use = it.value();
+    if (use->IsSimulate() || use->IsDeoptimize()) {
+      use->SetOperandAt(it.index(), state);
+    } else if (use->IsLoadNamedField()) {
+      HLoadNamedField* load = HLoadNamedField::cast(use);
+      int index =
+          CapturedFieldIndex(map, load->is_in_object(), load->offset());
+      load->DeleteAndReplaceWith(state->FieldAt(index));
+    } else {
+      ASSERT(use->IsCheckNonSmi() || use->IsCheckMaps());
+      use->DeleteAndReplaceWith(NULL);
+    }
+  }
+  literal->DeleteAndReplaceWith(NULL);
+  return initial_state;
+}
+
+
+void HGraph::ReplaceNonEscapingLiterals() {
+  if (!FLAG_escape_analysis) return;
+
+  HPhase phase("H_Escape analysis", this);
+  for (int i = 0; i < blocks()->length(); ++i) {
+    HInstruction* instr = blocks()->at(i)->first();
+    while (instr != NULL) {
+      if (instr->IsFastLiteral()) {
+        HFastLiteral* literal = HFastLiteral::cast(instr);
+        if (IsCapturableLiteral(literal) && IsNonEscapingLiteral(literal)) {
+          if (FLAG_trace_escape_analysis) {
+            PrintF("Scalar replacing literal %d in block B%d\n",
+                   literal->id(),
+                   literal->block()->block_id());
+          }
+          instr = ReplaceNonEscapingLiteral(literal, zone());
+        }
+      }
+      instr = instr->next();
+    }
+  }
+}
+
+
 HInstruction* HGraphBuilder::AddInstruction(HInstruction* instr) {
   ASSERT(current_block() != NULL);
   current_block()->AddInstruction(instr);
@@ -4732,11 +5241,13 @@ void HGraphBuilder::VisitObjectLiteral(ObjectLiteral* expr) {
                     &max_properties,
                     &total_size)) {
     Handle<JSObject> boilerplate_object = Handle<JSObject>::cast(boilerplate);
-    literal = new(zone()) HFastLiteral(context,
-                                       boilerplate_object,
-                                       total_size,
-                                       expr->literal_index(),
-                                       expr->depth());
+    HFastLiteral* fast_literal = new(zone()) HFastLiteral(context,
+                                                          boilerplate_object,
+                                                          total_size,
+                                                          expr->literal_index(),
+                                                          expr->depth());
+    if (FLAG_escape_analysis) fast_literal->RecordInObjectValues(zone());
+    literal = fast_literal;
   } else {
     literal = new(zone()) HObjectLiteral(context,
                                          expr->constant_properties(),
@@ -4933,9 +5444,11 @@ static bool ComputeLoadStoreField(Handle<Map> type,
   if (!is_store) return false;
 
   // 2nd chance: A store into a non-existent field can still be inlined if we
-  // have a matching transition and some room left in the object.
+  // have a matching transition and some room left in the object. New double
+  // fields need a heap number of their own, which the generic store makes.
   type->LookupTransition(NULL, *name, lookup);
   return lookup->IsTransitionToField(*type) &&
+      !lookup->GetTransitionDetails(*type).IsDoubleField() &&
       (type->unused_property_fields() > 0);
 }
 
@@ -5002,6 +5515,10 @@ HInstruction* HGraphBuilder::BuildStoreNamedField(HValue* object,
   } else {
     offset += FixedArray::kHeaderSize;
   }
+  if (lookup->IsField() && lookup->GetPropertyDetails().IsDoubleField()) {
+    return new(zone()) HStoreNamedDoubleField(
+        object, name, value, is_in_object, offset);
+  }
   HStoreNamedField* instr =
       new(zone()) HStoreNamedField(object, name, value, is_in_object, offset);
   if (lookup->IsTransitionToField(*map)) {
@@ -5078,6 +5595,7 @@ void HGraphBuilder::HandlePolymorphicLoadNamedField(Property* expr,
   int count = 0;
   int previous_field_offset = 0;
   bool previous_field_is_in_object = false;
+  bool previous_field_is_double = false;
   bool is_monomorphic_field = true;
   Handle<Map> map;
   LookupResult lookup(isolate());
@@ -5094,12 +5612,15 @@ void HGraphBuilder::HandlePolymorphicLoadNamedField(Property* expr,
       } else {
         offset += FixedArray::kHeaderSize;
       }
+      bool is_double = lookup.GetPropertyDetails().IsDoubleField();
       if (count == 0) {
         previous_field_offset = offset;
         previous_field_is_in_object = is_in_object;
+        previous_field_is_double = is_double;
       } else if (is_monomorphic_field) {
         is_monomorphic_field = (offset == previous_field_offset) &&
-                               (is_in_object == previous_field_is_in_object);
+                               (is_in_object == previous_field_is_in_object) &&
+                               (is_double == previous_field_is_double);
       }
       ++count;
     }
@@ -5648,26 +6169,30 @@ void HGraphBuilder::VisitThrow(Throw* expr) {
 }
 
 
-HLoadNamedField* HGraphBuilder::BuildLoadNamedField(HValue* object,
-                                                    Handle<Map> map,
-                                                    LookupResult* lookup,
-                                                    bool smi_and_map_check) {
+HInstruction* HGraphBuilder::BuildLoadNamedField(HValue* object,
+                                                 Handle<Map> map,
+                                                 LookupResult* lookup,
+                                                 bool smi_and_map_check) {
   if (smi_and_map_check) {
     AddInstruction(new(zone()) HCheckNonSmi(object));
     AddInstruction(HCheckMaps::NewWithTransitions(object, map, zone()));
   }
 
   int index = lookup->GetLocalFieldIndexFromMap(*map);
-  if (index < 0) {
+  bool is_in_object = index < 0;
+  int offset = index * kPointerSize;
+  if (is_in_object) {
     // Negative property indices are in-object properties, indexed
     // from the end of the fixed part of the object.
-    int offset = (index * kPointerSize) + map->instance_size();
-    return new(zone()) HLoadNamedField(object, true, offset);
+    offset += map->instance_size();
   } else {
     // Non-negative property indices are in the properties array.
-    int offset = (index * kPointerSize) + FixedArray::kHeaderSize;
-    return new(zone()) HLoadNamedField(object, false, offset);
+    offset += FixedArray::kHeaderSize;
+  }
+  if (lookup->GetPropertyDetails().IsDoubleField()) {
+    return new(zone()) HLoadNamedDoubleField(object, is_in_object, offset);
   }
+  return new(zone()) HLoadNamedField(object, is_in_object, offset);
 }
 
 
@@ -6499,7 +7024,12 @@ void HGraphBuilder::HandlePolymorphicCallNamed(Call* expr,
         sizeof(order[0]),
         &CompareHotness);
 
+  // Receiver maps that resolve to the same target (e.g. instances of
+  // different subclasses calling an inherited method) share one dispatch
+  // arm, so the target is inlined at most once per call site.
+  bool dispatched[kMaxCallPolymorphism] = { false };
   for (int fn = 0; fn < ordered_functions; ++fn) {
+    if (dispatched[fn]) continue;
     int i = order[fn].index();
     Handle<Map> map = types->at(i);
     if (fn == 0) {
@@ -6507,22 +7037,55 @@ void HGraphBuilder::HandlePolymorphicCallNamed(Call* expr,
       AddInstruction(new(zone()) HCheckNonSmi(receiver));
       join = graph()->CreateBasicBlock();
     }
-    HBasicBlock* if_true = graph()->CreateBasicBlock();
-    HBasicBlock* if_false = graph()->CreateBasicBlock();
-    HCompareMap* compare =
-        new(zone()) HCompareMap(receiver, map, if_true, if_false);
-    current_block()->Finish(compare);
+    expr->ComputeTarget(map, name);
+    Handle<JSFunction> target = expr->target();
+    bool in_arm[kMaxCallPolymorphism] = { false };
+    int arm_maps = 0;
+    for (int other = fn; other < ordered_functions; ++other) {
+      if (dispatched[other]) continue;
+      expr->ComputeTarget(types->at(order[other].index()), name);
+      if (expr->target().is_identical_to(target)) {
+        dispatched[other] = in_arm[other] = true;
+        arm_maps++;
+      }
+    }
+
+    // Prototype checks differ per map, so each map is compared on its own;
+    // with several maps the compares then meet in a single body block.
+    HBasicBlock* body = arm_maps > 1 ? graph()->CreateBasicBlock() : NULL;
+    for (int other = fn; other < ordered_functions; ++other) {
+      if (!in_arm[other]) continue;
+      Handle<Map> other_map = types->at(order[other].index());
+      HBasicBlock* if_true = graph()->CreateBasicBlock();
+      HBasicBlock* if_false = graph()->CreateBasicBlock();
+      HCompareMap* compare =
+          new(zone()) HCompareMap(receiver, other_map, if_true, if_false);
+      current_block()->Finish(compare);
+
+      set_current_block(if_true);
+      expr->ComputeTarget(other_map, name);
+      AddCheckConstantFunction(expr->holder(), receiver, other_map, false);
+      if (body == NULL) {
+        body = if_true;
+      } else {
+        current_block()->Goto(body);
+      }
+      set_current_block(if_false);
+    }
+    HBasicBlock* next = current_block();
 
-    set_current_block(if_true);
+    if (arm_maps > 1) body->SetJoinId(expr->id());
+    set_current_block(body);
     expr->ComputeTarget(map, name);
-    AddCheckConstantFunction(expr->holder(), receiver, map, false);
     if (FLAG_trace_inlining && FLAG_polymorphic_inlining) {
       Handle<JSFunction> caller = info()->closure();
       SmartArrayPointer<char> caller_name =
           caller->shared()->DebugName()->ToCString();
-      PrintF("Trying to inline the polymorphic call to %s from %s\n",
+      PrintF("Trying to inline the polymorphic call to %s from %s "
+             "(%d receiver maps)\n",
              *name->ToCString(),
-             *caller_name);
+             *caller_name,
+             arm_maps);
     }
     if (FLAG_polymorphic_inlining && TryInlineCall(expr)) {
       // Trying to inline will signal that we should bailout from the
@@ -6538,7 +7101,7 @@ void HGraphBuilder::HandlePolymorphicCallNamed(Call* expr,
     }
 
     if (current_block() != NULL) current_block()->Goto(join);
-    set_current_block(if_false);
+    set_current_block(next);
   }
 
   // Finish up.  Unconditionally deoptimize if we've handled all the maps we
@@ -6992,6 +7555,64 @@ bool HGraphBuilder::TryInlineBuiltinFunctionCall(Call* expr, bool drop_extra) {
 }
 
 
+bool HGraphBuilder::TryCallFastApiFunction(Call* expr,
+                                           HValue* receiver,
+                                           Handle<Map> receiver_map) {
+#if defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64)
+  if (!FLAG_fast_api_calls || receiver_map.is_null()) return false;
+  Handle<JSFunction> target = expr->target();
+  if (!target->shared()->IsApiFunction()) return false;
+  FunctionTemplateInfo* info = target->shared()->get_api_func_data();
+  if (info->fast_call_function()->IsUndefined()) return false;
+  // The call handler checks the receiver against the signature, which
+  // is not done for fast calls.
+  if (!info->signature()->IsUndefined()) return false;
+
+  int signature = Smi::cast(info->fast_call_signature())->value();
+  int argument_count = expr->arguments()->length();
+  if (argument_count !=
+      FunctionTemplateInfo::FastCallArgumentCountField::decode(signature)) {
+    return false;
+  }
+  bool passes_receiver =
+      FunctionTemplateInfo::FastCallReceiverTypeField::decode(signature) ==
+          FAST_CALL_EXTERNAL;
+  if (passes_receiver) {
+    // The receiver is an API object with at least one internal field.
+    if (receiver_map->instance_type() != JS_OBJECT_TYPE) return false;
+    int internal_field_count =
+        (receiver_map->instance_size() - JSObject::kHeaderSize) /
+            kPointerSize - receiver_map->inobject_properties();
+    if (internal_field_count < 1) return false;
+  }
+
+  AddCheckConstantFunction(expr->holder(), receiver, receiver_map, true);
+  Address callback =
+      Foreign::cast(info->fast_call_function())->foreign_address();
+  HCallFastApiFunction* call =
+      new(zone()) HCallFastApiFunction(target,
+                                       callback,
+                                       signature,
+                                       argument_count + passes_receiver);
+  int index = 0;
+  if (passes_receiver) {
+    HInstruction* field = AddInstruction(
+        new(zone()) HLoadNamedField(receiver, true, JSObject::kHeaderSize));
+    call->SetOperandAt(index++, field);
+  }
+  for (int i = argument_count - 1; i >= 0; i--) {
+    call->SetOperandAt(index++, environment()->ExpressionStackAt(i));
+  }
+  call->set_position(expr->position());
+  Drop(argument_count + 1);  // Arguments and receiver.
+  ast_context()->ReturnInstruction(call, expr->id());
+  return true;
+#else
+  return false;
+#endif
+}
+
+
 bool HGraphBuilder::TryInlineBuiltinMethodCall(Call* expr,
                                                HValue* receiver,
                                                Handle<Map> receiver_map,
@@ -7114,6 +7735,29 @@ bool HGraphBuilder::TryInlineBuiltinMethodCall(Call* expr,
         return true;
       }
       break;
+#if defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64)
+    case kMapGet:
+    case kMapHas:
+    case kSetHas: {
+      InstanceType type = (id == kSetHas) ? JS_SET_TYPE : JS_MAP_TYPE;
+      if (argument_count == 2 && check_type == RECEIVER_MAP_CHECK &&
+          receiver_map->instance_type() == type) {
+        AddCheckConstantFunction(expr->holder(), receiver, receiver_map, true);
+        HValue* key = Pop();
+        Drop(1);  // Receiver.
+        int offset = (id == kSetHas) ? JSSet::kTableOffset
+                                     : JSMap::kTableOffset;
+        HInstruction* table =
+            AddInstruction(new(zone()) HLoadNamedField(receiver, true, offset));
+        HValue* context = environment()->LookupContext();
+        HOrderedHashTableLookup* result = new(zone()) HOrderedHashTableLookup(
+            context, receiver, table, key, id);
+        ast_context()->ReturnInstruction(result, expr->id());
+        return true;
+      }
+      break;
+    }
+#endif
     default:
       // Not yet supported for inlining.
       break;
@@ -7261,6 +7905,11 @@ void HGraphBuilder::VisitCall(Call* expr) {
         return;
       }
 
+      if (expr->check_type() == RECEIVER_MAP_CHECK &&
+          TryCallFastApiFunction(expr, receiver, receiver_map)) {
+        return;
+      }
+
       if (CallStubCompiler::HasCustomCallGenerator(expr->target()) ||
           expr->check_type() != RECEIVER_MAP_CHECK) {
         // When the target has a custom call IC generator, use the IC,
@@ -9181,6 +9830,15 @@ void HEnvironment::SetExpressionStackAt(int index_from_top, HValue* value) {
 }
 
 
+void HEnvironment::ReplaceValue(HValue* old_value, HValue* new_value) {
+  for (HEnvironment* env = this; env != NULL; env = env->outer()) {
+    for (int i = 0; i < env->length(); ++i) {
+      if (env->values_[i] == old_value) env->values_[i] = new_value;
+    }
+  }
+}
+
+
 void HEnvironment::Drop(int count) {
   for (int i = 0; i < count; ++i) {
     Pop();
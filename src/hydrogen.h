@@ -242,6 +242,7 @@ class HLoopInformation: public ZoneObject {
 };
 
 class BoundsCheckTable;
+class HCheckTable;
 class HGraph: public ZoneObject {
  public:
   explicit HGraph(CompilationInfo* info);
@@ -267,6 +268,9 @@ class HGraph: public ZoneObject {
   void OrderBlocks();
   void AssignDominators();
   void ReplaceCheckedValues();
+  void ForwardStoredFieldValues();
+  void ReplaceNonEscapingLiterals();
+  void EliminateRedundantMapChecks();
   void EliminateRedundantBoundsChecks();
   void DehoistSimpleArrayIndexComputations();
   void PropagateDeoptimizingMark();
@@ -364,6 +368,8 @@ class HGraph: public ZoneObject {
   void InitializeInferredTypes(int from_inclusive, int to_inclusive);
   void CheckForBackEdge(HBasicBlock* block, HBasicBlock* successor);
   void EliminateRedundantBoundsChecks(HBasicBlock* bb, BoundsCheckTable* table);
+  HCheckTable* ComputeEntryCheckTable(HBasicBlock* block,
+                                      ZoneList<HCheckTable*>* tables);
 
   Isolate* isolate_;
   int next_block_id_;
@@ -525,6 +531,10 @@ class HEnvironment: public ZoneObject {
     values_[index] = value;
   }
 
+  // Replace every occurrence of |old_value| in this environment and its
+  // outer environments with |new_value|.
+  void ReplaceValue(HValue* old_value, HValue* new_value);
+
   void PrintTo(StringStream* stream);
   void PrintToStd();
 
@@ -1046,6 +1056,10 @@ class HGraphBuilder: public AstVisitor {
                                   Handle<Map> receiver_map,
                                   CheckType check_type);
   bool TryInlineBuiltinFunctionCall(Call* expr, bool drop_extra);
+  // Try to call the fast call handler of an API method directly.
+  bool TryCallFastApiFunction(Call* expr,
+                              HValue* receiver,
+                              Handle<Map> receiver_map);
 
   // If --trace-inlining, print a line of the inlining trace.  Inlining
   // succeeded if the reason string is NULL and failed if there is a
@@ -1142,10 +1156,10 @@ class HGraphBuilder: public AstVisitor {
                           Handle<AccessorPair>* accessors,
                           Handle<JSObject>* holder);
 
-  HLoadNamedField* BuildLoadNamedField(HValue* object,
-                                       Handle<Map> map,
-                                       LookupResult* result,
-                                       bool smi_and_map_check);
+  HInstruction* BuildLoadNamedField(HValue* object,
+                                    Handle<Map> map,
+                                    LookupResult* result,
+                                    bool smi_and_map_check);
   HInstruction* BuildLoadNamedGeneric(HValue* object,
                                       Handle<String> name,
                                       Property* expr);
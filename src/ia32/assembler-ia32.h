@@ -630,6 +630,9 @@ class Assembler : public AssemblerBase {
 
   static const int kCallInstructionLength = 5;
   static const int kJSReturnSequenceLength = 6;
+  // Length of the frame setup that starts a full codegen function.  It is
+  // patched into a call for code aging.
+  static const int kCodeAgeSequenceLength = 5;
 
   // The debug break slot must be able to contain a call instruction.
   static const int kDebugBreakSlotLength = kCallInstructionLength;
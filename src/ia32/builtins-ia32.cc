@@ -598,6 +598,26 @@ void Builtins::Generate_NotifyOSR(MacroAssembler* masm) {
 }
 
 
+void Builtins::Generate_MakeCodeYoungAgain(MacroAssembler* masm) {
+  // Called from the old code age sequence at the start of a function, with
+  // the function's arguments in place.  Restoring the young sequence does
+  // not allocate, so the registers can be saved without a frame, and we
+  // return to the start of the function to run the restored sequence.
+  __ sub(Operand(esp, 0), Immediate(Assembler::kCallInstructionLength));
+  __ pushad();
+  __ mov(eax, Operand(esp, 8 * kPointerSize));
+  {
+    AllowExternalCallThatCantCauseGC scope(masm);
+    __ PrepareCallCFunction(1, ebx);
+    __ mov(Operand(esp, 0), eax);
+    __ CallCFunction(
+        ExternalReference::make_code_young_function(masm->isolate()), 1);
+  }
+  __ popad();
+  __ ret(0);
+}
+
+
 void Builtins::Generate_FunctionCall(MacroAssembler* masm) {
   Factory* factory = masm->isolate()->factory();
 
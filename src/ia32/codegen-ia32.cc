@@ -757,6 +757,37 @@ void StringCharLoadGenerator::Generate(MacroAssembler* masm,
 
 #undef __
 
+
+// -------------------------------------------------------------------------
+// Code aging
+
+// The frame setup at the start of a full codegen function.
+static const byte kYoungSequence[Assembler::kCodeAgeSequenceLength] = {
+  0x55,              // push ebp
+  0x89, 0xe5,        // mov ebp, esp
+  0x56,              // push esi
+  0x57               // push edi
+};
+
+
+bool Code::IsYoungSequence(byte* sequence) {
+  return memcmp(sequence,
+                kYoungSequence,
+                Assembler::kCodeAgeSequenceLength) == 0;
+}
+
+
+bool Code::PatchPlatformCodeAge(byte* sequence, Code* stub) {
+  if (stub == NULL) {
+    memcpy(sequence, kYoungSequence, Assembler::kCodeAgeSequenceLength);
+    CPU::FlushICache(sequence, Assembler::kCodeAgeSequenceLength);
+  } else {
+    CodePatcher patcher(sequence, Assembler::kCodeAgeSequenceLength);
+    patcher.masm()->call(stub->instruction_start(), RelocInfo::NONE);
+  }
+  return true;
+}
+
 } }  // namespace v8::internal
 
 #endif  // V8_TARGET_ARCH_IA32
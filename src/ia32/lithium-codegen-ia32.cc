@@ -417,7 +417,7 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   if (environment == NULL) return;
 
   // The translation includes one command per value in the environment.
-  int translation_size = environment->values()->length();
+  int translation_size = environment->translation_size();
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
@@ -440,6 +440,21 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   }
   for (int i = 0; i < translation_size; ++i) {
     LOperand* value = environment->values()->at(i);
+    const LEnvironment::CapturedObject* captured =
+        environment->CapturedObjectAt(i);
+    if (captured != NULL) {
+      translation->StoreCapturedObject(
+          DefineDeoptimizationLiteral(captured->map),
+          captured->id,
+          captured->field_count);
+      for (int j = 0; j < captured->field_count; ++j) {
+        int field = captured->first_field + j;
+        AddToTranslation(translation,
+                         environment->values()->at(field),
+                         environment->HasTaggedValueAt(field));
+      }
+      continue;
+    }
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
     if (environment->spilled_registers() != NULL && value != NULL) {
@@ -2455,6 +2470,20 @@ void LCodeGen::DoStoreContextSlot(LStoreContextSlot* instr) {
 }
 
 
+void LCodeGen::DoLoadNamedDoubleField(LLoadNamedDoubleField* instr) {
+  Register object = ToRegister(instr->object());
+  Register temp = ToRegister(instr->temp());
+  XMMRegister result = ToDoubleRegister(instr->result());
+  if (instr->hydrogen()->is_in_object()) {
+    __ mov(temp, FieldOperand(object, instr->hydrogen()->offset()));
+  } else {
+    __ mov(temp, FieldOperand(object, JSObject::kPropertiesOffset));
+    __ mov(temp, FieldOperand(temp, instr->hydrogen()->offset()));
+  }
+  __ movdbl(result, FieldOperand(temp, HeapNumber::kValueOffset));
+}
+
+
 void LCodeGen::DoLoadNamedField(LLoadNamedField* instr) {
   Register object = ToRegister(instr->object());
   Register result = ToRegister(instr->result());
@@ -3368,6 +3397,105 @@ void LCodeGen::DoMathPowHalf(LMathPowHalf* instr) {
 }
 
 
+void LCodeGen::DoCallFastApiFunction(LCallFastApiFunction* instr) {
+  HCallFastApiFunction* hinstr = instr->hydrogen();
+  int parameter_count = instr->InputCount();
+  // Having marked this as a call, we can use edi as a scratch register.
+  Register scratch = edi;
+
+  // Check all tagged parameters before any of them is converted so that
+  // the deoptimization environment still sees the original values.
+  for (int i = 0; i < parameter_count; i++) {
+    FastCallType type = hinstr->ParameterTypeAt(i);
+    if (type == FAST_CALL_EXTERNAL) {
+      Register reg = ToRegister(instr->InputAt(i));
+      Label done;
+      __ JumpIfSmi(reg, &done);
+      __ CmpObjectType(reg, FOREIGN_TYPE, scratch);
+      DeoptimizeIf(not_equal, instr->environment());
+      __ bind(&done);
+    } else if (type == FAST_CALL_BOOL) {
+      Register reg = ToRegister(instr->InputAt(i));
+      Label done;
+      __ cmp(reg, factory()->true_value());
+      __ j(equal, &done, Label::kNear);
+      __ cmp(reg, factory()->false_value());
+      DeoptimizeIf(not_equal, instr->environment());
+      __ bind(&done);
+    }
+  }
+
+  // Convert the tagged parameters to their C representation and pass
+  // everything on the stack. Doubles take up two words.
+  int word_count = 0;
+  for (int i = 0; i < parameter_count; i++) {
+    word_count += hinstr->ParameterTypeAt(i) == FAST_CALL_DOUBLE ? 2 : 1;
+  }
+  __ PrepareCallCFunction(word_count, scratch);
+  int offset = 0;
+  for (int i = 0; i < parameter_count; i++) {
+    FastCallType type = hinstr->ParameterTypeAt(i);
+    if (type == FAST_CALL_DOUBLE) {
+      __ movdbl(Operand(esp, offset), ToDoubleRegister(instr->InputAt(i)));
+      offset += kDoubleSize;
+      continue;
+    }
+    Register reg = ToRegister(instr->InputAt(i));
+    if (type == FAST_CALL_EXTERNAL) {
+      // Aligned pointers are stored as smis, see v8::External.
+      STATIC_ASSERT(kPointerToSmiShift == 0);
+      Label done;
+      __ JumpIfSmi(reg, &done, Label::kNear);
+      __ mov(reg, FieldOperand(reg, Foreign::kForeignAddressOffset));
+      __ bind(&done);
+    } else if (type == FAST_CALL_BOOL) {
+      Label done;
+      __ cmp(reg, factory()->true_value());
+      __ mov(reg, Immediate(1));
+      __ j(equal, &done, Label::kNear);
+      __ mov(reg, Immediate(0));
+      __ bind(&done);
+    }
+    __ mov(Operand(esp, offset), reg);
+    offset += kPointerSize;
+  }
+
+  ApiFunction function(hinstr->callback());
+  __ CallCFunction(ExternalReference(&function,
+                                     ExternalReference::BUILTIN_CALL,
+                                     isolate()),
+                   word_count);
+
+  switch (hinstr->return_type()) {
+    case FAST_CALL_INT32:
+      ASSERT(ToRegister(instr->result()).is(eax));
+      break;
+    case FAST_CALL_DOUBLE:
+      // Return value is in st(0) on ia32.
+      ASSERT(ToDoubleRegister(instr->result()).is(xmm1));
+      __ sub(Operand(esp), Immediate(kDoubleSize));
+      __ fstp_d(Operand(esp, 0));
+      __ movdbl(xmm1, Operand(esp, 0));
+      __ add(Operand(esp), Immediate(kDoubleSize));
+      break;
+    case FAST_CALL_BOOL: {
+      Label done;
+      __ test_b(eax, 0xFF);
+      __ mov(eax, factory()->true_value());
+      __ j(not_zero, &done, Label::kNear);
+      __ mov(eax, factory()->false_value());
+      __ bind(&done);
+      break;
+    }
+    case FAST_CALL_VOID:
+      __ mov(eax, factory()->undefined_value());
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+
 void LCodeGen::DoPower(LPower* instr) {
   Representation exponent_type = instr->hydrogen()->right()->representation();
   // Having marked this as a call, we can use any registers.
@@ -3477,6 +3605,117 @@ void LCodeGen::DoDeferredRandom(LRandom* instr) {
 }
 
 
+void LCodeGen::DoOrderedHashTableLookup(LOrderedHashTableLookup* instr) {
+  class DeferredOrderedHashTableLookup: public LDeferredCode {
+   public:
+    DeferredOrderedHashTableLookup(LCodeGen* codegen,
+                                   LOrderedHashTableLookup* instr)
+        : LDeferredCode(codegen), instr_(instr) { }
+    virtual void Generate() {
+      codegen()->DoDeferredOrderedHashTableLookup(instr_);
+    }
+    virtual LInstruction* instr() { return instr_; }
+   private:
+    LOrderedHashTableLookup* instr_;
+  };
+
+  DeferredOrderedHashTableLookup* deferred =
+      new(zone()) DeferredOrderedHashTableLookup(this, instr);
+  HOrderedHashTableLookup* hinstr = instr->hydrogen();
+  Register table = ToRegister(instr->table());
+  Register key = ToRegister(instr->key());
+  Register result = ToRegister(instr->result());
+  Register temp = ToRegister(instr->temp());
+  // Both tables share the header layout.
+  const int kBucketsOffset = FixedArray::OffsetOfElementAt(
+      OrderedHashSet::kNumberOfBucketsIndex);
+  const int kStartOffset = FixedArray::OffsetOfElementAt(
+      OrderedHashSet::kHashTableStartIndex);
+
+  // The table is undefined until the collection has been initialized.
+  __ cmp(FieldOperand(table, HeapObject::kMapOffset),
+         Immediate(factory()->fixed_array_map()));
+  DeoptimizeIf(not_equal, instr->environment());
+
+  // Compute the hash of the key into result.  Only smis and symbols are
+  // handled here, other keys need to be normalized by the runtime first.
+  Label symbol_key, compute_bucket;
+  __ JumpIfNotSmi(key, &symbol_key, Label::kNear);
+  __ mov(result, key);
+  __ SmiUntag(result);
+  __ GetNumberHash(result, temp);
+  __ jmp(&compute_bucket, Label::kNear);
+
+  __ bind(&symbol_key);
+  __ mov(result, FieldOperand(key, HeapObject::kMapOffset));
+  __ movzx_b(result, FieldOperand(result, Map::kInstanceTypeOffset));
+  __ and_(result, kIsSymbolMask | kIsNotStringMask);
+  __ cmp(result, kSymbolTag | kStringTag);
+  __ j(not_equal, deferred->entry());
+  __ mov(result, FieldOperand(key, String::kHashFieldOffset));
+  __ shr(result, String::kHashShift);
+
+  // Load the first entry of the bucket chain.  temp holds the number of
+  // buckets, which is the offset of the entries from the bucket heads.
+  __ bind(&compute_bucket);
+  __ mov(temp, FieldOperand(table, kBucketsOffset));
+  __ SmiUntag(temp);
+  __ dec(temp);
+  __ and_(result, temp);
+  __ inc(temp);
+  __ mov(result, FieldOperand(table, result, times_pointer_size, kStartOffset));
+
+  // Walk the chain.  Table keys are normalized, so smis and symbols can be
+  // compared by identity.
+  Label loop, found, not_found, done;
+  __ bind(&loop);
+  __ cmp(result, Immediate(Smi::FromInt(OrderedHashSet::kNotFound)));
+  __ j(equal, &not_found, Label::kNear);
+  __ SmiUntag(result);
+  __ imul(result, result, hinstr->entry_size());
+  __ add(result, temp);
+  __ cmp(key, FieldOperand(table, result, times_pointer_size, kStartOffset));
+  __ j(equal, &found, Label::kNear);
+  __ mov(result,
+         FieldOperand(table, result, times_pointer_size,
+                      kStartOffset + hinstr->chain_offset() * kPointerSize));
+  __ jmp(&loop);
+
+  __ bind(&found);
+  if (hinstr->loads_value()) {
+    __ mov(result,
+           FieldOperand(table, result, times_pointer_size,
+                        kStartOffset +
+                        OrderedHashMap::kValueOffset * kPointerSize));
+  } else {
+    __ mov(result, factory()->true_value());
+  }
+  __ jmp(&done, Label::kNear);
+
+  __ bind(&not_found);
+  __ mov(result, hinstr->loads_value() ? factory()->undefined_value()
+                                       : factory()->false_value());
+  __ bind(&done);
+  __ bind(deferred->exit());
+}
+
+
+void LCodeGen::DoDeferredOrderedHashTableLookup(
+    LOrderedHashTableLookup* instr) {
+  Register result = ToRegister(instr->result());
+
+  // The result register is in the pointer map but holds a hash here.
+  __ Set(result, Immediate(0));
+
+  PushSafepointRegistersScope scope(this);
+  __ push(ToRegister(instr->receiver()));
+  __ push(ToRegister(instr->key()));
+  CallRuntimeFromDeferred(instr->hydrogen()->runtime_function(), 2,
+                          instr, instr->context());
+  __ StoreToSafepointRegisterSlot(result, eax);
+}
+
+
 void LCodeGen::DoMathLog(LUnaryMathOperation* instr) {
   ASSERT(instr->value()->Equals(instr->result()));
   XMMRegister input_reg = ToDoubleRegister(instr->value());
@@ -3662,6 +3901,20 @@ void LCodeGen::DoCallRuntime(LCallRuntime* instr) {
 }
 
 
+void LCodeGen::DoStoreNamedDoubleField(LStoreNamedDoubleField* instr) {
+  Register object = ToRegister(instr->object());
+  XMMRegister value = ToDoubleRegister(instr->value());
+  Register temp = ToRegister(instr->temp());
+  if (instr->is_in_object()) {
+    __ mov(temp, FieldOperand(object, instr->offset()));
+  } else {
+    __ mov(temp, FieldOperand(object, JSObject::kPropertiesOffset));
+    __ mov(temp, FieldOperand(temp, instr->offset()));
+  }
+  __ movdbl(FieldOperand(temp, HeapNumber::kValueOffset), value);
+}
+
+
 void LCodeGen::DoStoreNamedField(LStoreNamedField* instr) {
   Register object = ToRegister(instr->object());
   Register value = ToRegister(instr->value());
@@ -387,6 +387,15 @@ LOperand* LPlatformChunk::GetNextSpillSlot(bool is_double) {
 }
 
 
+void LStoreNamedDoubleField::PrintDataTo(StringStream* stream) {
+  object()->PrintTo(stream);
+  stream->Add(".");
+  stream->Add(*String::cast(*name())->ToCString());
+  stream->Add(" <- ");
+  value()->PrintTo(stream);
+}
+
+
 void LStoreNamedField::PrintDataTo(StringStream* stream) {
   object()->PrintTo(stream);
   stream->Add(".");
@@ -884,13 +893,20 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
   ASSERT(!ast_id.IsNone() ||
          hydrogen_env->frame_type() != JS_FUNCTION);
   int value_count = hydrogen_env->length();
+  int field_count = 0;
+  for (int i = 0; i < value_count; ++i) {
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      field_count += HCapturedObject::cast(value)->field_count();
+    }
+  }
   LEnvironment* result =
       new(zone()) LEnvironment(hydrogen_env->closure(),
                                hydrogen_env->frame_type(),
                                ast_id,
                                hydrogen_env->parameter_count(),
                                argument_count_,
-                               value_count,
+                               value_count + field_count,
                                outer,
                                zone());
   int argument_index = *argument_index_accumulator;
@@ -899,7 +915,7 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
 
     HValue* value = hydrogen_env->values()->at(i);
     LOperand* op = NULL;
-    if (value->IsArgumentsObject()) {
+    if (value->IsArgumentsObject() || value->IsCapturedObject()) {
       op = NULL;
     } else if (value->IsPushArgument()) {
       op = new(zone()) LArgument(argument_index++);
@@ -909,6 +925,26 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
     result->AddValue(op, value->representation());
   }
 
+  // The fields of captured objects follow the values of the frame.
+  int index = 0;
+  for (int i = 0; i < value_count; ++i) {
+    if (hydrogen_env->is_special_index(i)) continue;
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      HCapturedObject* object = HCapturedObject::cast(value);
+      result->AddCapturedObject(index,
+                                object->map(),
+                                object->id(),
+                                object->field_count());
+      for (int j = 0; j < object->field_count(); ++j) {
+        HValue* field = object->FieldAt(j);
+        ASSERT(field->representation().IsTagged());
+        result->AddValue(UseAny(field), field->representation());
+      }
+    }
+    ++index;
+  }
+
   if (hydrogen_env->frame_type() == JS_FUNCTION) {
     *argument_index_accumulator = argument_index;
   }
@@ -1061,6 +1097,40 @@ LInstruction* LChunkBuilder::DoCallConstantFunction(
 }
 
 
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  // All parameters are passed on the stack. They are fixed to registers
+  // the code generator does not need for the call itself.
+  static const Register kIntegerRegisters[] = { eax, ecx, edx, ebx };
+  int input_count = instr->OperandCount();
+  LCallFastApiFunction* result =
+      new(zone()) LCallFastApiFunction(input_count);
+  int integer_count = 0;
+  int double_count = 0;
+  for (int i = 0; i < input_count; i++) {
+    LOperand* operand;
+    if (instr->ParameterTypeAt(i) == FAST_CALL_DOUBLE) {
+      operand = UseFixedDouble(instr->OperandAt(i),
+                               XMMRegister::from_code(++double_count));
+    } else {
+      operand = UseFixed(instr->OperandAt(i),
+                         kIntegerRegisters[integer_count++]);
+    }
+    result->set_input(i, operand);
+  }
+  LInstruction* call;
+  switch (instr->return_type()) {
+    case FAST_CALL_DOUBLE:
+      call = DefineFixedDouble(result, xmm1);
+      break;
+    default:
+      call = DefineFixed(result, eax);
+      break;
+  }
+  return MarkAsCall(call, instr, CAN_DEOPTIMIZE_EAGERLY);
+}
+
+
 LInstruction* LChunkBuilder::DoInvokeFunction(HInvokeFunction* instr) {
   LOperand* context = UseFixed(instr->context(), esi);
   LOperand* function = UseFixed(instr->function(), edi);
@@ -1440,6 +1510,19 @@ LInstruction* LChunkBuilder::DoRandom(HRandom* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoOrderedHashTableLookup(
+    HOrderedHashTableLookup* instr) {
+  LOperand* context = UseAny(instr->context());
+  LOperand* receiver = UseRegister(instr->receiver());
+  LOperand* table = UseRegister(instr->table());
+  LOperand* key = UseRegister(instr->key());
+  LOperand* temp = TempRegister();
+  LOrderedHashTableLookup* result = new(zone()) LOrderedHashTableLookup(
+      context, receiver, table, key, temp);
+  return AssignEnvironment(AssignPointerMap(DefineAsRegister(result)));
+}
+
+
 LInstruction* LChunkBuilder::DoCompareGeneric(HCompareGeneric* instr) {
   ASSERT(instr->left()->representation().IsTagged());
   ASSERT(instr->right()->representation().IsTagged());
@@ -1862,6 +1945,14 @@ LInstruction* LChunkBuilder::DoStoreContextSlot(HStoreContextSlot* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoLoadNamedDoubleField(
+    HLoadNamedDoubleField* instr) {
+  LOperand* obj = UseRegisterAtStart(instr->object());
+  LOperand* temp = TempRegister();
+  return DefineAsRegister(new(zone()) LLoadNamedDoubleField(obj, temp));
+}
+
+
 LInstruction* LChunkBuilder::DoLoadNamedField(HLoadNamedField* instr) {
   ASSERT(instr->representation().IsTagged());
   LOperand* obj = UseRegisterAtStart(instr->object());
@@ -2093,6 +2184,15 @@ LInstruction* LChunkBuilder::DoTransitionElementsKind(
 }
 
 
+LInstruction* LChunkBuilder::DoStoreNamedDoubleField(
+    HStoreNamedDoubleField* instr) {
+  LOperand* obj = UseRegister(instr->object());
+  LOperand* val = UseRegister(instr->value());
+  LOperand* temp = TempRegister();
+  return new(zone()) LStoreNamedDoubleField(obj, val, temp);
+}
+
+
 LInstruction* LChunkBuilder::DoStoreNamedField(HStoreNamedField* instr) {
   bool needs_write_barrier = instr->NeedsWriteBarrier();
   bool needs_write_barrier_for_map = !instr->transition().is_null() &&
@@ -2262,6 +2362,17 @@ LInstruction* LChunkBuilder::DoArgumentsObject(HArgumentsObject* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoCapturedObject(HCapturedObject* instr) {
+  // Captured objects only exist in deoptimization environments, where each
+  // new state of the object replaces the previous one.
+  if (instr->previous_state() != NULL) {
+    current_block_->last_environment()->ReplaceValue(instr->previous_state(),
+                                                     instr);
+  }
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoAccessArgumentsAt(HAccessArgumentsAt* instr) {
   LOperand* arguments = UseRegister(instr->arguments());
   LOperand* length = UseTempRegister(instr->length());
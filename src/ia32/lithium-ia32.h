@@ -55,6 +55,7 @@ class LCodeGen;
   V(BoundsCheck)                                \
   V(Branch)                                     \
   V(CallConstantFunction)                       \
+  V(CallFastApiFunction)                        \
   V(CallFunction)                               \
   V(CallGlobal)                                 \
   V(CallKeyed)                                  \
@@ -122,6 +123,7 @@ class LCodeGen;
   V(LoadKeyedFastDoubleElement)                 \
   V(LoadKeyedGeneric)                           \
   V(LoadKeyedSpecializedArrayElement)           \
+  V(LoadNamedDoubleField)                       \
   V(LoadNamedField)                             \
   V(LoadNamedFieldPolymorphic)                  \
   V(LoadNamedGeneric)                           \
@@ -134,6 +136,7 @@ class LCodeGen;
   V(NumberTagI)                                 \
   V(NumberUntagD)                               \
   V(ObjectLiteral)                              \
+  V(OrderedHashTableLookup)                     \
   V(OsrEntry)                                   \
   V(OuterContext)                               \
   V(Parameter)                                  \
@@ -153,6 +156,7 @@ class LCodeGen;
   V(StoreKeyedFastElement)                      \
   V(StoreKeyedGeneric)                          \
   V(StoreKeyedSpecializedArrayElement)          \
+  V(StoreNamedDoubleField)                      \
   V(StoreNamedField)                            \
   V(StoreNamedGeneric)                          \
   V(StringAdd)                                  \
@@ -1124,6 +1128,32 @@ class LRandom: public LTemplateInstruction<1, 1, 0> {
 };
 
 
+class LOrderedHashTableLookup: public LTemplateInstruction<1, 4, 1> {
+ public:
+  LOrderedHashTableLookup(LOperand* context,
+                          LOperand* receiver,
+                          LOperand* table,
+                          LOperand* key,
+                          LOperand* temp) {
+    inputs_[0] = context;
+    inputs_[1] = receiver;
+    inputs_[2] = table;
+    inputs_[3] = key;
+    temps_[0] = temp;
+  }
+
+  LOperand* context() { return inputs_[0]; }
+  LOperand* receiver() { return inputs_[1]; }
+  LOperand* table() { return inputs_[2]; }
+  LOperand* key() { return inputs_[3]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(OrderedHashTableLookup,
+                               "ordered-hash-table-lookup")
+  DECLARE_HYDROGEN_ACCESSOR(OrderedHashTableLookup)
+};
+
+
 class LArithmeticD: public LTemplateInstruction<1, 2, 0> {
  public:
   LArithmeticD(Token::Value op, LOperand* left, LOperand* right)
@@ -1179,6 +1209,21 @@ class LReturn: public LTemplateInstruction<0, 1, 0> {
 };
 
 
+class LLoadNamedDoubleField: public LTemplateInstruction<1, 1, 1> {
+ public:
+  LLoadNamedDoubleField(LOperand* object, LOperand* temp) {
+    inputs_[0] = object;
+    temps_[0] = temp;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LoadNamedDoubleField, "load-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(LoadNamedDoubleField)
+
+  LOperand* object() { return inputs_[0]; }
+  LOperand* temp() { return temps_[0]; }
+};
+
+
 class LLoadNamedField: public LTemplateInstruction<1, 1, 0> {
  public:
   explicit LLoadNamedField(LOperand* object) {
@@ -1528,6 +1573,23 @@ class LCallConstantFunction: public LTemplateInstruction<1, 0, 0> {
 };
 
 
+class LCallFastApiFunction: public LTemplateInstruction<
+    1, FunctionTemplateInfo::kMaxFastCallParameters, 0> {
+ public:
+  explicit LCallFastApiFunction(int input_count)
+      : input_count_(input_count) { }
+
+  int InputCount() { return input_count_; }
+  void set_input(int index, LOperand* operand) { inputs_[index] = operand; }
+
+  DECLARE_CONCRETE_INSTRUCTION(CallFastApiFunction, "call-fast-api-function")
+  DECLARE_HYDROGEN_ACCESSOR(CallFastApiFunction)
+
+ private:
+  int input_count_;
+};
+
+
 class LInvokeFunction: public LTemplateInstruction<1, 2, 0> {
  public:
   LInvokeFunction(LOperand* context, LOperand* function) {
@@ -1787,6 +1849,30 @@ class LStoreNamedField: public LTemplateInstruction<0, 2, 2> {
 };
 
 
+class LStoreNamedDoubleField: public LTemplateInstruction<0, 2, 1> {
+ public:
+  LStoreNamedDoubleField(LOperand* obj, LOperand* val, LOperand* temp) {
+    inputs_[0] = obj;
+    inputs_[1] = val;
+    temps_[0] = temp;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreNamedDoubleField,
+                               "store-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(StoreNamedDoubleField)
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  LOperand* object() { return inputs_[0]; }
+  LOperand* value() { return inputs_[1]; }
+  LOperand* temp() { return temps_[0]; }
+
+  Handle<Object> name() const { return hydrogen()->name(); }
+  bool is_in_object() { return hydrogen()->is_in_object(); }
+  int offset() { return hydrogen()->offset(); }
+};
+
+
 class LStoreNamedGeneric: public LTemplateInstruction<0, 3, 0> {
  public:
   LStoreNamedGeneric(LOperand* context, LOperand* object, LOperand* value) {
@@ -392,6 +392,19 @@ void StubCompiler::GenerateFastPropertyLoad(MacroAssembler* masm,
 }
 
 
+// Copy the value of the heap number in |source| into the heap number in
+// |target|.
+static void GenerateCopyHeapNumberValue(MacroAssembler* masm,
+                                        Register source,
+                                        Register target,
+                                        Register scratch) {
+  __ mov(scratch, FieldOperand(source, HeapNumber::kMantissaOffset));
+  __ mov(FieldOperand(target, HeapNumber::kMantissaOffset), scratch);
+  __ mov(scratch, FieldOperand(source, HeapNumber::kExponentOffset));
+  __ mov(FieldOperand(target, HeapNumber::kExponentOffset), scratch);
+}
+
+
 static void PushInterceptorArguments(MacroAssembler* masm,
                                      Register receiver,
                                      Register holder,
@@ -801,6 +814,13 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
   // checks.
   ASSERT(object->IsJSGlobalProxy() || !object->IsAccessCheckNeeded());
 
+  // Double fields only hold heap numbers, anything else goes to the runtime.
+  bool is_double_field = IsDoubleField(object, name, transition);
+  if (is_double_field) {
+    __ CheckMap(eax, masm->isolate()->factory()->heap_number_map(),
+                miss_label, DO_SMI_CHECK);
+  }
+
   // Perform map transition for the receiver if necessary.
   if (!transition.is_null() && (object->map()->unused_property_fields() == 0)) {
     // The properties must be extended before we can store the value.
@@ -818,6 +838,14 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
     return;
   }
 
+  // The value written to the field; a new double field gets its own copy.
+  Register value_reg = eax;
+  if (is_double_field && !transition.is_null()) {
+    __ AllocateHeapNumber(scratch2, scratch1, no_reg, miss_label);
+    GenerateCopyHeapNumberValue(masm, eax, scratch2, scratch1);
+    value_reg = scratch2;
+  }
+
   if (!transition.is_null()) {
     // Update the map of the object.
     __ mov(scratch1, Immediate(transition));
@@ -834,6 +862,14 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
                         OMIT_SMI_CHECK);
   }
 
+  if (is_double_field && transition.is_null()) {
+    // Update the field's heap number in place; no write barrier needed.
+    GenerateFastPropertyLoad(masm, scratch1, receiver_reg, object, index);
+    GenerateCopyHeapNumberValue(masm, eax, scratch1, scratch2);
+    __ ret(0);
+    return;
+  }
+
   // Adjust for the number of properties stored in the object. Even in the
   // face of a transition we can use the old map here because the size of the
   // object and the number of in-object properties is not going to change.
@@ -842,11 +878,11 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
   if (index < 0) {
     // Set the property straight into the object.
     int offset = object->map()->instance_size() + (index * kPointerSize);
-    __ mov(FieldOperand(receiver_reg, offset), eax);
+    __ mov(FieldOperand(receiver_reg, offset), value_reg);
 
     // Update the write barrier for the array address.
     // Pass the value being stored in the now unused name_reg.
-    __ mov(name_reg, eax);
+    __ mov(name_reg, value_reg);
     __ RecordWriteField(receiver_reg,
                         offset,
                         name_reg,
@@ -857,11 +893,11 @@ void StubCompiler::GenerateStoreField(MacroAssembler* masm,
     int offset = index * kPointerSize + FixedArray::kHeaderSize;
     // Get the properties array (optimistically).
     __ mov(scratch1, FieldOperand(receiver_reg, JSObject::kPropertiesOffset));
-    __ mov(FieldOperand(scratch1, offset), eax);
+    __ mov(FieldOperand(scratch1, offset), value_reg);
 
     // Update the write barrier for the array address.
     // Pass the value being stored in the now unused name_reg.
-    __ mov(name_reg, eax);
+    __ mov(name_reg, value_reg);
     __ RecordWriteField(scratch1,
                         offset,
                         name_reg,
@@ -1046,6 +1082,18 @@ void StubCompiler::GenerateLoadField(Handle<JSObject> object,
   Register reg = CheckPrototypes(
       object, receiver, holder, scratch1, scratch2, scratch3, name, miss);
 
+  if (IsDoubleField(holder, name, Handle<Map>::null())) {
+    // The heap number of a double field is updated in place, so hand out a
+    // copy. The IC only compiles these loads for own fields.
+    ASSERT(holder.is_identical_to(object));
+    __ AllocateHeapNumber(scratch3, scratch1, no_reg, miss);
+    GenerateFastPropertyLoad(masm(), scratch1, reg, holder, index);
+    GenerateCopyHeapNumberValue(masm(), scratch1, scratch3, scratch2);
+    __ mov(eax, scratch3);
+    __ ret(0);
+    return;
+  }
+
   // Get the value from the properties.
   GenerateFastPropertyLoad(masm(), eax, reg, holder, index);
   __ ret(0);
@@ -1199,7 +1247,7 @@ void StubCompiler::GenerateLoadInterceptor(Handle<JSObject> object,
   bool compile_followup_inline = false;
   if (lookup->IsFound() && lookup->IsCacheable()) {
     if (lookup->IsField()) {
-      compile_followup_inline = true;
+      compile_followup_inline = !lookup->GetPropertyDetails().IsDoubleField();
     } else if (lookup->type() == CALLBACKS &&
                lookup->GetCallbackObject()->IsAccessorInfo()) {
       AccessorInfo* callback = AccessorInfo::cast(lookup->GetCallbackObject());
@@ -960,6 +960,11 @@ void LoadIC::UpdateCaches(LookupResult* lookup,
     Handle<JSObject> holder(lookup->holder());
     switch (lookup->type()) {
       case FIELD:
+        // The stubs only copy double fields of the receiver itself.
+        if (lookup->GetPropertyDetails().IsDoubleField() &&
+            !holder.is_identical_to(receiver)) {
+          return;
+        }
         code = isolate()->stub_cache()->ComputeLoadField(
             name, receiver, holder, lookup->GetFieldIndex());
         break;
@@ -1249,6 +1254,11 @@ void KeyedLoadIC::UpdateCaches(LookupResult* lookup,
     Handle<JSObject> holder(lookup->holder());
     switch (lookup->type()) {
       case FIELD:
+        // The stubs only copy double fields of the receiver itself.
+        if (lookup->GetPropertyDetails().IsDoubleField() &&
+            !holder.is_identical_to(receiver)) {
+          return;
+        }
         code = isolate()->stub_cache()->ComputeKeyedLoadField(
             name, receiver, holder, lookup->GetFieldIndex());
         break;
@@ -2167,6 +2177,16 @@ RUNTIME_FUNCTION(MaybeObject*, SharedStoreIC_ExtendStorage) {
   ASSERT(object->HasFastProperties());
   ASSERT(object->map()->unused_property_fields() == 0);
 
+  // A double field gets its own heap number.  The stub has checked that
+  // the value is one.
+  Object* field_value = value;
+  DescriptorArray* descriptors = transition->instance_descriptors();
+  if (descriptors->GetDetails(transition->LastAdded()).IsDoubleField()) {
+    MaybeObject* maybe_number =
+        isolate->heap()->AllocateHeapNumber(value->Number());
+    if (!maybe_number->ToObject(&field_value)) return maybe_number;
+  }
+
   // Expand the properties array.
   FixedArray* old_storage = object->properties();
   int new_unused = transition->unused_property_fields();
@@ -2176,7 +2196,7 @@ RUNTIME_FUNCTION(MaybeObject*, SharedStoreIC_ExtendStorage) {
     if (!maybe_result->ToObject(&result)) return maybe_result;
   }
   FixedArray* new_storage = FixedArray::cast(result);
-  new_storage->set(old_storage->length(), value);
+  new_storage->set(old_storage->length(), field_value);
 
   // Set the new property value and do the map transition.
   object->set_properties(new_storage);
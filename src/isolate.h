@@ -1041,6 +1041,8 @@ class Isolate {
     context_exit_happened_ = context_exit_happened;
   }
 
+  double time_millis_at_init() { return time_millis_at_init_; }
+
   double time_millis_since_init() {
     return OS::TimeCurrentMillis() - time_millis_at_init_;
   }
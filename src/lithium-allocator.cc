@@ -139,7 +139,8 @@ LiveRange::LiveRange(int id, Zone* zone)
       current_interval_(NULL),
       last_processed_use_(NULL),
       spill_operand_(new(zone) LOperand()),
-      spill_start_index_(kMaxInt) { }
+      spill_start_index_(kMaxInt),
+      next_live_position_(LifetimePosition::Invalid()) { }
 
 
 void LiveRange::set_assigned_register(int reg,
@@ -530,6 +531,20 @@ LifetimePosition LiveRange::FirstIntersection(LiveRange* other) {
 }
 
 
+LifetimePosition LiveRange::NextLivePosition(LifetimePosition position) const {
+  for (UseInterval* interval = FirstSearchIntervalForPosition(position);
+       interval != NULL;
+       interval = interval->next()) {
+    if (interval->end().Value() > position.Value()) {
+      return interval->start().Value() > position.Value()
+          ? interval->start()
+          : position;
+    }
+  }
+  return LifetimePosition::Invalid();
+}
+
+
 LAllocator::LAllocator(int num_values, HGraph* graph)
     : zone_(graph->zone()),
       chunk_(NULL),
@@ -1065,18 +1080,27 @@ void LAllocator::ResolvePhis(HBasicBlock* block) {
 bool LAllocator::Allocate(LChunk* chunk) {
   ASSERT(chunk_ == NULL);
   chunk_ = static_cast<LPlatformChunk*>(chunk);
-  MeetRegisterConstraints();
-  if (!AllocationOk()) return false;
-  ResolvePhis();
-  BuildLiveRanges();
-  AllocateGeneralRegisters();
-  if (!AllocationOk()) return false;
-  AllocateDoubleRegisters();
-  if (!AllocationOk()) return false;
-  PopulatePointerMaps();
-  if (has_osr_entry_) ProcessOsrEntry();
-  ConnectRanges();
-  ResolveControlFlow();
+  Counters* counters = graph_->isolate()->counters();
+  { HistogramTimerScope timer(counters->regalloc_build_live_ranges());
+    MeetRegisterConstraints();
+    if (!AllocationOk()) return false;
+    ResolvePhis();
+    BuildLiveRanges();
+  }
+  { HistogramTimerScope timer(counters->regalloc_allocate());
+    AllocateGeneralRegisters();
+    if (!AllocationOk()) return false;
+    AllocateDoubleRegisters();
+    if (!AllocationOk()) return false;
+  }
+  { HistogramTimerScope timer(counters->regalloc_pointer_maps());
+    PopulatePointerMaps();
+  }
+  { HistogramTimerScope timer(counters->regalloc_resolve());
+    if (has_osr_entry_) ProcessOsrEntry();
+    ConnectRanges();
+    ResolveControlFlow();
+  }
   return true;
 }
 
@@ -1505,14 +1529,14 @@ void LAllocator::AllocateRegisters() {
     for (int i = 0; i < fixed_double_live_ranges_.length(); ++i) {
       LiveRange* current = fixed_double_live_ranges_.at(i);
       if (current != NULL) {
-        AddToInactive(current);
+        AddToInactive(current, LifetimePosition::FromInstructionIndex(0));
       }
     }
   } else {
     for (int i = 0; i < fixed_live_ranges_.length(); ++i) {
       LiveRange* current = fixed_live_ranges_.at(i);
       if (current != NULL) {
-        AddToInactive(current);
+        AddToInactive(current, LifetimePosition::FromInstructionIndex(0));
       }
     }
   }
@@ -1555,19 +1579,24 @@ void LAllocator::AllocateRegisters() {
         ActiveToHandled(cur_active);
         --i;  // The live range was removed from the list of active live ranges.
       } else if (!cur_active->Covers(position)) {
-        ActiveToInactive(cur_active);
+        ActiveToInactive(cur_active, position);
         --i;  // The live range was removed from the list of active live ranges.
       }
     }
 
-    for (int i = 0; i < inactive_live_ranges_.length(); ++i) {
-      LiveRange* cur_inactive = inactive_live_ranges_.at(i);
+    // Only inactive ranges that become live again at or before the current
+    // position can change state; they are at the end of the list.
+    while (!inactive_live_ranges_.is_empty()) {
+      LiveRange* cur_inactive = inactive_live_ranges_.last();
+      if (cur_inactive->next_live_position().Value() > position.Value()) break;
       if (cur_inactive->End().Value() <= position.Value()) {
         InactiveToHandled(cur_inactive);
-        --i;  // Live range was removed from the list of inactive live ranges.
       } else if (cur_inactive->Covers(position)) {
         InactiveToActive(cur_inactive);
-        --i;  // Live range was removed from the list of inactive live ranges.
+      } else {
+        // The range has a hole at the current position.
+        RemoveFromInactive(cur_inactive);
+        AddToInactive(cur_inactive, position);
       }
     }
 
@@ -1637,16 +1666,53 @@ void LAllocator::AddToActive(LiveRange* range) {
 }
 
 
-void LAllocator::AddToInactive(LiveRange* range) {
+// Inactive live ranges are kept sorted by decreasing next live position, so
+// the ranges that become live first are at the end of the list.
+void LAllocator::AddToInactive(LiveRange* range, LifetimePosition position) {
   TraceAlloc("Add live range %d to inactive\n", range->id());
-  inactive_live_ranges_.Add(range, zone());
+  range->set_next_live_position(range->NextLivePosition(position));
+  int value = range->next_live_position().Value();
+  int low = 0;
+  int high = inactive_live_ranges_.length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (inactive_live_ranges_[mid]->next_live_position().Value() > value) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  inactive_live_ranges_.InsertAt(low, range, zone());
+}
+
+
+void LAllocator::RemoveFromInactive(LiveRange* range) {
+  ASSERT(inactive_live_ranges_.Contains(range));
+  if (inactive_live_ranges_.last() == range) {
+    inactive_live_ranges_.RemoveLast();
+  } else {
+    inactive_live_ranges_.RemoveElement(range);
+  }
 }
 
 
 void LAllocator::AddToUnhandledSorted(LiveRange* range) {
   if (range == NULL || range->IsEmpty()) return;
   ASSERT(!range->HasRegisterAssigned() && !range->IsSpilled());
-  for (int i = unhandled_live_ranges_.length() - 1; i >= 0; --i) {
+  // Binary search past the ranges that start later; only ranges with the same
+  // start need the tie breaker in ShouldBeAllocatedBefore.
+  int start = range->Start().Value();
+  int low = 0;
+  int high = unhandled_live_ranges_.length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (unhandled_live_ranges_[mid]->Start().Value() >= start) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  for (int i = low - 1; i >= 0; --i) {
     LiveRange* cur_range = unhandled_live_ranges_.at(i);
     if (range->ShouldBeAllocatedBefore(cur_range)) {
       TraceAlloc("Add live range %d to unhandled at %d\n", range->id(), i + 1);
@@ -1731,25 +1797,24 @@ void LAllocator::ActiveToHandled(LiveRange* range) {
 }
 
 
-void LAllocator::ActiveToInactive(LiveRange* range) {
+void LAllocator::ActiveToInactive(LiveRange* range,
+                                  LifetimePosition position) {
   ASSERT(active_live_ranges_.Contains(range));
   active_live_ranges_.RemoveElement(range);
-  inactive_live_ranges_.Add(range, zone());
+  AddToInactive(range, position);
   TraceAlloc("Moving live range %d from active to inactive\n", range->id());
 }
 
 
 void LAllocator::InactiveToHandled(LiveRange* range) {
-  ASSERT(inactive_live_ranges_.Contains(range));
-  inactive_live_ranges_.RemoveElement(range);
+  RemoveFromInactive(range);
   TraceAlloc("Moving live range %d from inactive to handled\n", range->id());
   FreeSpillSlot(range);
 }
 
 
 void LAllocator::InactiveToActive(LiveRange* range) {
-  ASSERT(inactive_live_ranges_.Contains(range));
-  inactive_live_ranges_.RemoveElement(range);
+  RemoveFromInactive(range);
   active_live_ranges_.Add(range, zone());
   TraceAlloc("Moving live range %d from inactive to active\n", range->id());
 }
@@ -1774,13 +1839,18 @@ bool LAllocator::TryAllocateFreeReg(LiveRange* current) {
         LifetimePosition::FromInstructionIndex(0);
   }
 
-  for (int i = 0; i < inactive_live_ranges_.length(); ++i) {
+  // An inactive range cannot intersect current before it becomes live again,
+  // so the scan stops at the first one that stays inactive past current.
+  for (int i = inactive_live_ranges_.length() - 1; i >= 0; --i) {
     LiveRange* cur_inactive = inactive_live_ranges_.at(i);
     ASSERT(cur_inactive->End().Value() > current->Start().Value());
+    LifetimePosition next_live = cur_inactive->next_live_position();
+    if (next_live.Value() >= current->End().Value()) break;
+    int cur_reg = cur_inactive->assigned_register();
+    if (free_until_pos[cur_reg].Value() <= next_live.Value()) continue;
     LifetimePosition next_intersection =
         cur_inactive->FirstIntersection(current);
     if (!next_intersection.IsValid()) continue;
-    int cur_reg = cur_inactive->assigned_register();
     free_until_pos[cur_reg] = Min(free_until_pos[cur_reg], next_intersection);
   }
 
@@ -1877,9 +1947,10 @@ void LAllocator::AllocateBlockedReg(LiveRange* current) {
     }
   }
 
-  for (int i = 0; i < inactive_live_ranges_.length(); ++i) {
+  for (int i = inactive_live_ranges_.length() - 1; i >= 0; --i) {
     LiveRange* range = inactive_live_ranges_.at(i);
     ASSERT(range->End().Value() > current->Start().Value());
+    if (range->next_live_position().Value() >= current->End().Value()) break;
     LifetimePosition next_intersection = range->FirstIntersection(current);
     if (!next_intersection.IsValid()) continue;
     int cur_reg = range->assigned_register();
@@ -1957,7 +2028,8 @@ void LAllocator::SplitAndSpillIntersecting(LiveRange* current) {
   for (int i = 0; i < inactive_live_ranges_.length(); ++i) {
     LiveRange* range = inactive_live_ranges_[i];
     ASSERT(range->End().Value() > current->Start().Value());
-    if (range->assigned_register() == reg && !range->IsFixed()) {
+    if (range->assigned_register() == reg && !range->IsFixed() &&
+        range->next_live_position().Value() < current->End().Value()) {
       LifetimePosition next_intersection = range->FirstIntersection(current);
       if (next_intersection.IsValid()) {
         UsePosition* next_pos = range->NextRegisterPosition(current->Start());
@@ -356,6 +356,17 @@ class LiveRange: public ZoneObject {
   bool Covers(LifetimePosition position);
   LifetimePosition FirstIntersection(LiveRange* other);
 
+  // Returns the first position at or after the given position that is covered
+  // by this live range, or an invalid position if there is none.
+  LifetimePosition NextLivePosition(LifetimePosition position) const;
+
+  // While the range is inactive the allocator caches the position where it
+  // becomes live again.
+  LifetimePosition next_live_position() const { return next_live_position_; }
+  void set_next_live_position(LifetimePosition position) {
+    next_live_position_ = position;
+  }
+
   // Add a new interval or a new use position to this live range.
   void EnsureInterval(LifetimePosition start,
                       LifetimePosition end,
@@ -396,6 +407,7 @@ class LiveRange: public ZoneObject {
   UsePosition* last_processed_use_;
   LOperand* spill_operand_;
   int spill_start_index_;
+  LifetimePosition next_live_position_;
 };
 
 
@@ -516,13 +528,14 @@ class LAllocator BASE_EMBEDDED {
 
   // Helper methods for updating the life range lists.
   void AddToActive(LiveRange* range);
-  void AddToInactive(LiveRange* range);
+  void AddToInactive(LiveRange* range, LifetimePosition position);
   void AddToUnhandledSorted(LiveRange* range);
   void AddToUnhandledUnsorted(LiveRange* range);
   void SortUnhandled();
   bool UnhandledIsSorted();
   void ActiveToHandled(LiveRange* range);
-  void ActiveToInactive(LiveRange* range);
+  void ActiveToInactive(LiveRange* range, LifetimePosition position);
+  void RemoveFromInactive(LiveRange* range);
   void InactiveToHandled(LiveRange* range);
   void InactiveToActive(LiveRange* range);
   void FreeSpillSlot(LiveRange* range);
@@ -471,6 +471,7 @@ class LEnvironment: public ZoneObject {
         pc_offset_(-1),
         values_(value_count, zone),
         is_tagged_(value_count, zone),
+        captured_objects_(0, zone),
         spilled_registers_(NULL),
         spilled_double_registers_(NULL),
         outer_(outer),
@@ -502,6 +503,41 @@ class LEnvironment: public ZoneObject {
     return is_tagged_.Contains(index);
   }
 
+  // Objects removed by escape analysis are described by their map and the
+  // values of their fields.  The field values are stored after the values of
+  // the frame and are not part of the frame translation themselves.  The id
+  // identifies slots that refer to the same object.
+  struct CapturedObject {
+    int index;
+    Handle<Map> map;
+    int id;
+    int first_field;
+    int field_count;
+  };
+
+  void AddCapturedObject(int index,
+                         Handle<Map> map,
+                         int id,
+                         int field_count) {
+    CapturedObject object = { index, map, id, values_.length(), field_count };
+    captured_objects_.Add(object, zone());
+  }
+
+  // Returns the captured object at a frame value index, or NULL.
+  const CapturedObject* CapturedObjectAt(int index) const {
+    for (int i = 0; i < captured_objects_.length(); ++i) {
+      if (captured_objects_[i].index == index) return &captured_objects_[i];
+    }
+    return NULL;
+  }
+
+  // The number of frame values, excluding the fields of captured objects.
+  int translation_size() const {
+    return captured_objects_.is_empty()
+        ? values_.length()
+        : captured_objects_[0].first_field;
+  }
+
   void Register(int deoptimization_index,
                 int translation_index,
                 int pc_offset) {
@@ -535,6 +571,7 @@ class LEnvironment: public ZoneObject {
   int pc_offset_;
   ZoneList<LOperand*> values_;
   BitVector is_tagged_;
+  ZoneList<CapturedObject> captured_objects_;
 
   // Allocation index indexed arrays of spill slot operands for registers
   // that are also in spill slots at an OSR entry.  NULL for environments
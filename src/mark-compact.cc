@@ -666,12 +666,22 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   int fragmentation = 0;
   Candidate* least = NULL;
 
+  // Old code age sequences call the MakeCodeYoungAgain builtin without
+  // relocation info, so it must not move.
+  Page* builtin_page = NULL;
+  Builtins* builtins = heap()->isolate()->builtins();
+  if (space->identity() == CODE_SPACE && builtins->is_initialized()) {
+    Code* builtin = builtins->builtin(Builtins::kMakeCodeYoungAgain);
+    builtin_page = Page::FromAddress(builtin->address());
+  }
+
   PageIterator it(space);
   if (it.has_next()) it.next();  // Never compact the first page.
 
   while (it.has_next()) {
     Page* p = it.next();
     p->ClearEvacuationCandidate();
+    if (p == builtin_page) continue;
 
     if (FLAG_stress_compaction) {
       unsigned int counter = space->heap()->ms_count();
@@ -856,6 +866,14 @@ void MarkCompactCollector::Finish() {
 // and continue with marking.  This process repeats until all reachable
 // objects have been marked.
 
+// How many collections a code object has to survive without being run
+// before it is flushed. Running the code resets its age.
+static int CodeAgeThreshold() {
+  if (FLAG_optimize_for_size) return 1;
+  return Min(FLAG_flush_code_age, SharedFunctionInfo::kCodeAgeMask);
+}
+
+
 class CodeFlusher {
  public:
   explicit CodeFlusher(Isolate* isolate)
@@ -875,12 +893,54 @@ class CodeFlusher {
     jsfunction_candidates_head_ = function;
   }
 
+  void AddOptimizedCodeMap(SharedFunctionInfo* shared_info) {
+    optimized_code_maps_.Add(shared_info);
+  }
+
+  // Marks the entries of the optimized code maps that stay alive, see
+  // MarkCompactMarkingVisitor::VisitOptimizedCodeMap.  Called until
+  // fix-point is reached, like the processing of weak maps.
+  void MarkOptimizedCodeMaps();
+
   void ProcessCandidates() {
+    ClearNonLiveOptimizedCodeMapEntries();
     ProcessSharedFunctionInfoCandidates();
     ProcessJSFunctionCandidates();
   }
 
  private:
+  // Entries whose context or code was not marked are cleared to undefined
+  // and reused when code is added to the map.  This runs before the code
+  // is flushed, which drops whole maps that are still marked.
+  void ClearNonLiveOptimizedCodeMapEntries() {
+    Heap* heap = isolate_->heap();
+    for (int i = 0; i < optimized_code_maps_.length(); i++) {
+      SharedFunctionInfo* shared = optimized_code_maps_[i];
+      Object* value = shared->optimized_code_map();
+      // The map is gone if an earlier visit of the same function emptied it.
+      if (value->IsSmi()) continue;
+
+      FixedArray* code_map = FixedArray::cast(value);
+      bool has_entries = false;
+      for (int j = 0;
+           j < code_map->length();
+           j += SharedFunctionInfo::kEntryLength) {
+        Object* context = code_map->get(j);
+        if (context->IsUndefined()) continue;
+        if (MarkCompactCollector::IsMarked(context) &&
+            MarkCompactCollector::IsMarked(code_map->get(j + 1))) {
+          has_entries = true;
+        } else {
+          code_map->set_undefined(heap, j);
+          code_map->set_undefined(heap, j + 1);
+          code_map->set_undefined(heap, j + 2);
+        }
+      }
+      if (!has_entries) shared->ClearOptimizedCodeMap();
+    }
+    optimized_code_maps_.Clear();
+  }
+
   void ProcessJSFunctionCandidates() {
     Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kLazyCompile);
 
@@ -894,8 +954,10 @@ class CodeFlusher {
       Code* code = shared->code();
       MarkBit code_mark = Marking::MarkBitFrom(code);
       if (!code_mark.Get()) {
+        isolate_->counters()->flushed_code_size()->Increment(code->Size());
         shared->set_code(lazy_compile);
         candidate->set_code(lazy_compile);
+        FlushOptimizedCodeMap(shared);
       } else {
         candidate->set_code(shared->code());
       }
@@ -928,7 +990,9 @@ class CodeFlusher {
       Code* code = candidate->code();
       MarkBit code_mark = Marking::MarkBitFrom(code);
       if (!code_mark.Get()) {
+        isolate_->counters()->flushed_code_size()->Increment(code->Size());
         candidate->set_code(lazy_compile);
+        FlushOptimizedCodeMap(candidate);
       }
 
       RecordSharedFunctionInfoCodeSlot(candidate);
@@ -946,6 +1010,26 @@ class CodeFlusher {
         RecordSlot(slot, slot, HeapObject::cast(*slot));
   }
 
+  // The optimized code cached for a function goes with its unoptimized
+  // code, which is needed to deoptimize.  It is recompiled if the function
+  // is used again.  A live optimized function keeps the unoptimized code
+  // alive, so its map is never dropped here.
+  void FlushOptimizedCodeMap(SharedFunctionInfo* shared) {
+    Object* value = shared->optimized_code_map();
+    if (value->IsSmi()) return;
+
+    FixedArray* code_map = FixedArray::cast(value);
+    for (int i = 1;
+         i < code_map->length();
+         i += SharedFunctionInfo::kEntryLength) {
+      if (code_map->get(i)->IsUndefined()) continue;
+      Code* code = Code::cast(code_map->get(i));
+      isolate_->counters()->flushed_optimized_code_size()->Increment(
+          code->Size());
+    }
+    shared->ClearOptimizedCodeMap();
+  }
+
   static JSFunction** GetNextCandidateField(JSFunction* candidate) {
     return reinterpret_cast<JSFunction**>(
         candidate->address() + JSFunction::kCodeEntryOffset);
@@ -980,6 +1064,7 @@ class CodeFlusher {
   Isolate* isolate_;
   JSFunction* jsfunction_candidates_head_;
   SharedFunctionInfo* shared_function_info_candidates_head_;
+  List<SharedFunctionInfo*> optimized_code_maps_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
@@ -1165,10 +1250,6 @@ class MarkCompactMarkingVisitor
 
   // Code flushing support.
 
-  // How many collections newly compiled code object will survive before being
-  // flushed.
-  static const int kCodeAgeThreshold = 5;
-
   static const int kRegExpCodeThreshold = 5;
 
   inline static bool HasSourceCode(Heap* heap, SharedFunctionInfo* info) {
@@ -1191,18 +1272,30 @@ class MarkCompactMarkingVisitor
   inline static bool IsFlushable(Heap* heap, JSFunction* function) {
     SharedFunctionInfo* shared_info = function->unchecked_shared();
 
+    // Optimized code does not run the prologue of the unoptimized code, so
+    // an optimized function counts as running for as long as it is
+    // optimized.  So does its entry in the optimized code map.
+    Code* code = function->code();
+    if (code->kind() == Code::OPTIMIZED_FUNCTION) {
+      shared_info->set_code_age(0);
+      code->set_optimized_code_age(0);
+      return false;
+    }
+
     // Code is either on stack, in compilation cache or referenced
-    // by optimized version of function.
-    MarkBit code_mark = Marking::MarkBitFrom(function->code());
+    // by optimized version of function.  A closure that was never
+    // called refers to the lazy compile stub, which says nothing about
+    // the age of the shared code.
+    MarkBit code_mark = Marking::MarkBitFrom(code);
     if (code_mark.Get()) {
-      if (!Marking::MarkBitFrom(shared_info).Get()) {
+      if (!Marking::MarkBitFrom(shared_info).Get() && IsCompiled(function)) {
         shared_info->set_code_age(0);
       }
       return false;
     }
 
     // We do not flush code for optimized functions.
-    if (function->code() != shared_info->code()) {
+    if (code != shared_info->code()) {
       return false;
     }
 
@@ -1245,13 +1338,23 @@ class MarkCompactMarkingVisitor
       return false;
     }
 
-    // Age this shared function info.
-    if (shared_info->code_age() < kCodeAgeThreshold) {
-      shared_info->set_code_age(shared_info->code_age() + 1);
+    // Code with a code age sequence that is still young ran since the
+    // last collection, or was compiled since.  Make it old again to find
+    // out whether it runs until the next one.
+    Code* code = shared_info->code();
+    if (code->has_code_age_sequence() &&
+        !code->IsOld() &&
+        code->MakeOlder()) {
+      shared_info->set_code_age(0);
       return false;
     }
 
-    return true;
+    // Age this shared function info.  The code is flushed at the
+    // collection that makes it CodeAgeThreshold() collections old.
+    if (shared_info->code_age() < CodeAgeThreshold()) {
+      shared_info->set_code_age(shared_info->code_age() + 1);
+    }
+    return shared_info->code_age() >= CodeAgeThreshold();
   }
 
 
@@ -1274,7 +1377,12 @@ class MarkCompactMarkingVisitor
 
 
   static void VisitSharedFunctionInfoGeneric(Map* map, HeapObject* object) {
-    SharedFunctionInfo::cast(object)->BeforeVisitingPointers();
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(object);
+    shared->BeforeVisitingPointers();
+
+    // Without code flushing nothing ages the optimized code map, so it is
+    // flushed on every major GC.
+    shared->ClearOptimizedCodeMap();
 
     FixedBodyVisitor<MarkCompactMarkingVisitor,
                      SharedFunctionInfo::BodyDescriptor,
@@ -1473,6 +1581,30 @@ class MarkCompactMarkingVisitor
   }
 
 
+  // Entries of the optimized code map are weak, so that optimized code no
+  // closure uses any more can go while the unoptimized code stays.  The
+  // map is marked without pushing it on the marking stack and its entries
+  // are marked by CodeFlusher::MarkOptimizedCodeMaps once the context of
+  // an entry is known to be alive.
+  static void VisitOptimizedCodeMap(Heap* heap, HeapObject* object) {
+    SharedFunctionInfo* shared = reinterpret_cast<SharedFunctionInfo*>(object);
+    Object* value = shared->optimized_code_map();
+    if (value->IsSmi()) return;
+
+    MarkCompactCollector* collector = heap->mark_compact_collector();
+    FixedArray* code_map = FixedArray::cast(value);
+    Object** slot =
+        SLOT_ADDR(object, SharedFunctionInfo::kOptimizedCodeMapOffset);
+    MarkBit code_map_mark = Marking::MarkBitFrom(code_map);
+    collector->RecordSlot(slot, slot, code_map);
+    if (!code_map_mark.Get()) collector->SetMark(code_map, code_map_mark);
+    // Recording the map slot can be skipped, because maps are not compacted.
+    collector->MarkObject(code_map->map(),
+                          Marking::MarkBitFrom(code_map->map()));
+    collector->code_flusher()->AddOptimizedCodeMap(shared);
+  }
+
+
   static void VisitSharedFunctionInfoFields(Heap* heap,
                                             HeapObject* object,
                                             bool flush_code_candidate) {
@@ -1482,8 +1614,10 @@ class MarkCompactMarkingVisitor
       VisitPointer(heap, SLOT_ADDR(object, SharedFunctionInfo::kCodeOffset));
     }
 
+    VisitOptimizedCodeMap(heap, object);
     VisitPointers(heap,
-        SLOT_ADDR(object, SharedFunctionInfo::kOptimizedCodeMapOffset),
+        SLOT_ADDR(object,
+                  SharedFunctionInfo::kOptimizedCodeMapOffset + kPointerSize),
         SLOT_ADDR(object, SharedFunctionInfo::kSize));
   }
 
@@ -1493,6 +1627,42 @@ class MarkCompactMarkingVisitor
 };
 
 
+// An entry of an optimized code map is alive as long as its context is.
+// Its code stays while something else uses it, or while the unoptimized
+// code of the function runs.  Otherwise the entry ages once per collection
+// in which only the map keeps it, until it reaches the threshold.  Closures
+// that use the code reset its age, see IsFlushable.
+void CodeFlusher::MarkOptimizedCodeMaps() {
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+  for (int i = 0; i < optimized_code_maps_.length(); i++) {
+    SharedFunctionInfo* shared = optimized_code_maps_[i];
+    FixedArray* code_map = FixedArray::cast(shared->optimized_code_map());
+    Object** anchor = reinterpret_cast<Object**>(code_map->address());
+    for (int j = 0;
+         j < code_map->length();
+         j += SharedFunctionInfo::kEntryLength) {
+      Object* context = code_map->get(j);
+      if (context->IsUndefined()) continue;
+      if (!MarkCompactCollector::IsMarked(context)) continue;
+
+      Code* code = Code::cast(code_map->get(j + 1));
+      if (!MarkCompactCollector::IsMarked(code) && shared->code_age() > 0) {
+        int age = code->optimized_code_age() + 1;
+        if (age >= CodeAgeThreshold()) continue;
+        code->set_optimized_code_age(age);
+      }
+
+      Object** context_slot = code_map->data_start() + j;
+      collector->RecordSlot(anchor, context_slot, context);
+      MarkCompactMarkingVisitor::MarkObjectByPointer(
+          collector, anchor, code_map->data_start() + j + 1);
+      MarkCompactMarkingVisitor::MarkObjectByPointer(
+          collector, anchor, code_map->data_start() + j + 2);
+    }
+  }
+}
+
+
 void MarkCompactMarkingVisitor::ObjectStatsCountFixedArray(
     FixedArrayBase* fixed_array,
     FixedArraySubInstanceType fast_type,
@@ -2275,6 +2445,7 @@ void MarkCompactCollector::EmptyMarkingDeque() {
     // Process encountered weak maps, mark objects only reachable by those
     // weak maps and repeat until fix-point is reached.
     ProcessWeakMaps();
+    if (is_code_flushing_enabled()) code_flusher_->MarkOptimizedCodeMaps();
   }
 }
 
@@ -1114,12 +1114,44 @@ function captureStackTrace(obj, cons_opt) {
   if (stackTraceLimit < 0 || stackTraceLimit > 10000) {
     stackTraceLimit = 10000;
   }
-  var raw_stack = %CollectStackTrace(obj,
-                                     cons_opt ? cons_opt : captureStackTrace,
-                                     stackTraceLimit);
-  DefineOneShotAccessor(obj, 'stack', function (obj) {
-    return FormatRawStackTrace(obj, raw_stack);
-  });
+  %CollectStackTrace(obj,
+                     cons_opt ? cons_opt : captureStackTrace,
+                     stackTraceLimit);
+  %DefineOrRedefineAccessorProperty(
+      obj, 'stack', StackTraceGetter, StackTraceSetter, DONT_ENUM);
+}
+
+
+// The 'stack' accessors are shared by all error objects so that they can
+// share maps.  %CollectStackTrace only records the raw frames in a hidden
+// property of the error.  They are formatted the first time the 'stack'
+// property is read and the result is kept in another hidden property.
+// Like the accessors of DefineOneShotAccessor these operate on the object
+// holding the property, not on 'this'.
+function StackTraceHolder(obj) {
+  while (IS_SPEC_OBJECT(obj)) {
+    if (%HasLocalProperty(obj, 'stack')) return obj;
+    obj = %GetPrototype(obj);
+  }
+  return void 0;
+}
+
+function StackTraceGetter() {
+  var holder = StackTraceHolder(this);
+  if (IS_UNDEFINED(holder)) return void 0;
+  var raw_stack = %GetAndClearRawStackTrace(holder);
+  if (!IS_UNDEFINED(raw_stack)) {
+    return %SetFormattedStackTrace(holder,
+                                   FormatRawStackTrace(holder, raw_stack));
+  }
+  return %GetFormattedStackTrace(holder);
+}
+
+function StackTraceSetter(v) {
+  var holder = StackTraceHolder(this);
+  if (IS_UNDEFINED(holder)) return;
+  %GetAndClearRawStackTrace(holder);
+  %SetFormattedStackTrace(holder, v);
 }
 
 
@@ -1157,7 +1189,8 @@ function SetUpError() {
         // Define all the expected properties directly on the error
         // object. This avoids going through getters and setters defined
         // on prototype objects.
-        %IgnoreAttributesAndSetProperty(this, 'stack', void 0, DONT_ENUM);
+        %DefineOrRedefineAccessorProperty(
+            this, 'stack', StackTraceGetter, StackTraceSetter, DONT_ENUM);
         %IgnoreAttributesAndSetProperty(this, 'arguments', void 0, DONT_ENUM);
         %IgnoreAttributesAndSetProperty(this, 'type', void 0, DONT_ENUM);
         if (m === kAddMessageAccessorsMarker) {
@@ -1312,6 +1312,13 @@ void Builtins::Generate_NotifyOSR(MacroAssembler* masm) {
 }
 
 
+void Builtins::Generate_MakeCodeYoungAgain(MacroAssembler* masm) {
+  // Full codegen does not emit a code age sequence on this architecture,
+  // so nothing calls this builtin.
+  __ stop("MakeCodeYoungAgain");
+}
+
+
 void Builtins::Generate_OnStackReplacement(MacroAssembler* masm) {
   CpuFeatures::TryForceFeatureScope scope(VFP3);
   if (!CpuFeatures::IsSupported(FPU)) {
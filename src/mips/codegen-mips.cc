@@ -448,6 +448,24 @@ void StringCharLoadGenerator::Generate(MacroAssembler* masm,
 
 #undef __
 
+
+// -------------------------------------------------------------------------
+// Code aging
+
+// Full codegen does not emit a code age sequence on this architecture.
+// Its prologue clears the code age of the shared function info on every
+// call instead, so code flushing counts the collections since the last
+// call.
+bool Code::IsYoungSequence(byte* sequence) {
+  return false;
+}
+
+
+bool Code::PatchPlatformCodeAge(byte* sequence, Code* stub) {
+  UNREACHABLE();
+  return false;
+}
+
 } }  // namespace v8::internal
 
 #endif  // V8_TARGET_ARCH_MIPS
@@ -170,6 +170,15 @@ void FullCodeGenerator::Generate() {
   // the frame (that is done below).
   FrameScope frame_scope(masm_, StackFrame::MANUAL);
 
+  // There is no code age sequence to patch on this architecture, so
+  // running the function makes its code young again by clearing the age.
+  if (FLAG_flush_code && info->scope()->is_function_scope()) {
+    __ lw(a2, FieldMemOperand(a1, JSFunction::kSharedFunctionInfoOffset));
+    __ lw(a3, FieldMemOperand(a2, SharedFunctionInfo::kCompilerHintsOffset));
+    __ And(a3, a3, Operand(~SharedFunctionInfo::kCodeAgeRawMask));
+    __ sw(a3, FieldMemOperand(a2, SharedFunctionInfo::kCompilerHintsOffset));
+  }
+
   int locals_count = info->scope()->num_stack_slots();
 
   __ Push(ra, fp, cp, a1);
@@ -356,6 +356,15 @@ void LAccessArgumentsAt::PrintDataTo(StringStream* stream) {
 }
 
 
+void LStoreNamedDoubleField::PrintDataTo(StringStream* stream) {
+  object()->PrintTo(stream);
+  stream->Add(".");
+  stream->Add(*String::cast(*name())->ToCString());
+  stream->Add(" <- ");
+  value()->PrintTo(stream);
+}
+
+
 void LStoreNamedField::PrintDataTo(StringStream* stream) {
   object()->PrintTo(stream);
   stream->Add(".");
@@ -858,13 +867,20 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
   ASSERT(!ast_id.IsNone() ||
          hydrogen_env->frame_type() != JS_FUNCTION);
   int value_count = hydrogen_env->length();
+  int field_count = 0;
+  for (int i = 0; i < value_count; ++i) {
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      field_count += HCapturedObject::cast(value)->field_count();
+    }
+  }
   LEnvironment* result = new(zone()) LEnvironment(
       hydrogen_env->closure(),
       hydrogen_env->frame_type(),
       ast_id,
       hydrogen_env->parameter_count(),
       argument_count_,
-      value_count,
+      value_count + field_count,
       outer,
       zone());
   int argument_index = *argument_index_accumulator;
@@ -873,7 +889,7 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
 
     HValue* value = hydrogen_env->values()->at(i);
     LOperand* op = NULL;
-    if (value->IsArgumentsObject()) {
+    if (value->IsArgumentsObject() || value->IsCapturedObject()) {
       op = NULL;
     } else if (value->IsPushArgument()) {
       op = new(zone()) LArgument(argument_index++);
@@ -883,6 +899,26 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
     result->AddValue(op, value->representation());
   }
 
+  // The fields of captured objects follow the values of the frame.
+  int index = 0;
+  for (int i = 0; i < value_count; ++i) {
+    if (hydrogen_env->is_special_index(i)) continue;
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      HCapturedObject* object = HCapturedObject::cast(value);
+      result->AddCapturedObject(index,
+                                object->map(),
+                                object->id(),
+                                object->field_count());
+      for (int j = 0; j < object->field_count(); ++j) {
+        HValue* field = object->FieldAt(j);
+        ASSERT(field->representation().IsTagged());
+        result->AddValue(UseAny(field), field->representation());
+      }
+    }
+    ++index;
+  }
+
   if (hydrogen_env->frame_type() == JS_FUNCTION) {
     *argument_index_accumulator = argument_index;
   }
@@ -1023,6 +1059,14 @@ LInstruction* LChunkBuilder::DoCallConstantFunction(
 }
 
 
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  // The graph builder only emits fast API calls on ia32 and x64.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoInvokeFunction(HInvokeFunction* instr) {
   LOperand* function = UseFixed(instr->function(), a1);
   argument_count_ -= instr->argument_count();
@@ -1322,6 +1366,14 @@ LInstruction* LChunkBuilder::DoRandom(HRandom* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoOrderedHashTableLookup(
+    HOrderedHashTableLookup* instr) {
+  // The graph builder only emits ordered hash table lookups on ia32 and x64.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoCompareGeneric(HCompareGeneric* instr) {
   ASSERT(instr->left()->representation().IsTagged());
   ASSERT(instr->right()->representation().IsTagged());
@@ -1720,6 +1772,13 @@ LInstruction* LChunkBuilder::DoStoreContextSlot(HStoreContextSlot* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoLoadNamedDoubleField(
+    HLoadNamedDoubleField* instr) {
+  return DefineAsRegister(
+      new(zone()) LLoadNamedDoubleField(UseRegisterAtStart(instr->object())));
+}
+
+
 LInstruction* LChunkBuilder::DoLoadNamedField(HLoadNamedField* instr) {
   return DefineAsRegister(
       new(zone()) LLoadNamedField(UseRegisterAtStart(instr->object())));
@@ -1931,6 +1990,14 @@ LInstruction* LChunkBuilder::DoTransitionElementsKind(
 }
 
 
+LInstruction* LChunkBuilder::DoStoreNamedDoubleField(
+    HStoreNamedDoubleField* instr) {
+  LOperand* obj = UseRegisterAtStart(instr->object());
+  LOperand* val = UseRegisterAtStart(instr->value());
+  return new(zone()) LStoreNamedDoubleField(obj, val);
+}
+
+
 LInstruction* LChunkBuilder::DoStoreNamedField(HStoreNamedField* instr) {
   bool needs_write_barrier = instr->NeedsWriteBarrier();
   bool needs_write_barrier_for_map = !instr->transition().is_null() &&
@@ -2074,6 +2141,17 @@ LInstruction* LChunkBuilder::DoArgumentsObject(HArgumentsObject* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoCapturedObject(HCapturedObject* instr) {
+  // Captured objects only exist in deoptimization environments, where each
+  // new state of the object replaces the previous one.
+  if (instr->previous_state() != NULL) {
+    current_block_->last_environment()->ReplaceValue(instr->previous_state(),
+                                                     instr);
+  }
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoAccessArgumentsAt(HAccessArgumentsAt* instr) {
   LOperand* arguments = UseRegister(instr->arguments());
   LOperand* length = UseTempRegister(instr->length());
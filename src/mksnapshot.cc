@@ -0,0 +1,168 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Host tool that boots the VM, serializes the startup heap and the initial
+// context with Snapshot::Create and writes them out as a C++ source file
+// defining the Snapshot byte arrays. The file is compiled into the library
+// in place of snapshot-empty.cc, so the snapshot is deserialized from
+// memory when an isolate is initialized.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "flags.h"
+#include "list.h"
+#include "serialize.h"
+#include "snapshot.h"
+
+using namespace v8::internal;
+
+
+class ListSnapshotSink : public SnapshotByteSink {
+ public:
+  ListSnapshotSink() { }
+  virtual ~ListSnapshotSink() { }
+  virtual void Put(int value, const char* description) {
+    data_.Add(static_cast<byte>(value));
+  }
+  virtual int Position() { return data_.length(); }
+  const List<byte>& data() const { return data_; }
+
+ private:
+  List<byte> data_;
+};
+
+
+static void WriteByteArray(FILE* fp,
+                           const char* name,
+                           const List<byte>& data) {
+  fprintf(fp, "const byte Snapshot::%s[] = {", name);
+  for (int i = 0; i < data.length(); i++) {
+    if ((i & 0x1f) == 0) fprintf(fp, "\n  ");
+    fprintf(fp, "%d,", data[i]);
+  }
+  // An empty array is not valid C++.
+  if (data.is_empty()) fprintf(fp, "0");
+  fprintf(fp, "\n};\n");
+}
+
+
+static bool WriteSnapshotFile(const char* file_name,
+                              const List<byte>& startup,
+                              const List<byte>& context,
+                              const int* context_space_used) {
+  FILE* fp = fopen(file_name, "wb");
+  if (fp == NULL) return false;
+  fprintf(fp, "// Autogenerated snapshot file. Do not edit.\n\n");
+  fprintf(fp, "#include \"v8.h\"\n");
+  fprintf(fp, "#include \"platform.h\"\n\n");
+  fprintf(fp, "#include \"snapshot.h\"\n\n");
+  fprintf(fp, "namespace v8 {\nnamespace internal {\n\n");
+  WriteByteArray(fp, "data_", startup);
+  fprintf(fp, "const byte* Snapshot::raw_data_ = Snapshot::data_;\n");
+  fprintf(fp, "const int Snapshot::size_ = %d;\n", startup.length());
+  fprintf(fp, "const int Snapshot::raw_size_ = %d;\n\n", startup.length());
+  WriteByteArray(fp, "context_data_", context);
+  fprintf(fp, "const byte* Snapshot::context_raw_data_ = "
+              "Snapshot::context_data_;\n");
+  fprintf(fp, "const int Snapshot::context_size_ = %d;\n", context.length());
+  fprintf(fp, "const int Snapshot::context_raw_size_ = %d;\n\n",
+          context.length());
+  static const char* const kSpaceNames[] = {
+    "new", "pointer", "data", "code", "map", "cell", "large"
+  };
+  STATIC_ASSERT(ARRAY_SIZE(kSpaceNames) == LAST_SPACE + 1);
+  for (int space = FIRST_SPACE; space <= LAST_SPACE; space++) {
+    fprintf(fp, "const int Snapshot::%s_space_used_ = %d;\n",
+            kSpaceNames[space], context_space_used[space]);
+  }
+  fprintf(fp, "\n} }  // namespace v8::internal\n");
+  return fclose(fp) == 0;
+}
+
+
+static char* ReadExtraCode(const char* file_name) {
+  FILE* fp = fopen(file_name, "rb");
+  if (fp == NULL) return NULL;
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);  // NOLINT
+  rewind(fp);
+  char* chars = NewArray<char>(static_cast<int>(size) + 1);
+  size_t read = fread(chars, 1, size, fp);
+  fclose(fp);
+  chars[read] = '\0';
+  return chars;
+}
+
+
+int main(int argc, char** argv) {
+  // Print the usage if an error occurs when parsing the command line
+  // flags or if the help flag is set.
+  int result = FlagList::SetFlagsFromCommandLine(&argc, argv, true);
+  if (result > 0 || argc != 2 || FLAG_help) {
+    ::printf("Usage: %s [flag] ... outfile\n", argv[0]);
+    FlagList::PrintHelp();
+    return !FLAG_help;
+  }
+
+#ifdef COMPRESS_STARTUP_DATA_BZ2
+  // The library would try to decompress the arrays written below.
+  fprintf(stderr, "Compressed startup data is not supported\n");
+  return 1;
+#endif
+
+  char* extra_code = NULL;
+  if (FLAG_extra_code != NULL) {
+    extra_code = ReadExtraCode(FLAG_extra_code);
+    if (extra_code == NULL) {
+      fprintf(stderr, "Cannot read extra code file %s\n", FLAG_extra_code);
+      return 1;
+    }
+  }
+
+  ListSnapshotSink startup_sink;
+  ListSnapshotSink context_sink;
+  int context_space_used[LAST_SPACE + 1];
+  bool created = Snapshot::Create(
+      extra_code, &startup_sink, &context_sink, context_space_used);
+  DeleteArray(extra_code);
+  if (!created) {
+    fprintf(stderr, "Failed to create the startup snapshot\n");
+    return 1;
+  }
+
+  if (!WriteSnapshotFile(argv[1],
+                         startup_sink.data(),
+                         context_sink.data(),
+                         context_space_used)) {
+    fprintf(stderr, "Cannot write snapshot file %s\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}
@@ -603,7 +603,7 @@ void JSSet::JSSetVerify() {
   CHECK(IsJSSet());
   JSObjectVerify();
   VerifyHeapPointer(table());
-  ASSERT(table()->IsHashTable() || table()->IsUndefined());
+  ASSERT(table()->IsFixedArray() || table()->IsUndefined());
 }
 
 
@@ -611,7 +611,7 @@ void JSMap::JSMapVerify() {
   CHECK(IsJSMap());
   JSObjectVerify();
   VerifyHeapPointer(table());
-  ASSERT(table()->IsHashTable() || table()->IsUndefined());
+  ASSERT(table()->IsFixedArray() || table()->IsUndefined());
 }
 
 
@@ -619,7 +619,7 @@ void JSWeakMap::JSWeakMapVerify() {
   CHECK(IsJSWeakMap());
   JSObjectVerify();
   VerifyHeapPointer(table());
-  ASSERT(table()->IsHashTable() || table()->IsUndefined());
+  ASSERT(table()->IsFixedArray() || table()->IsUndefined());
 }
 
 
@@ -747,6 +747,8 @@ void FunctionTemplateInfo::FunctionTemplateInfoVerify() {
   VerifyPointer(instance_template());
   VerifyPointer(signature());
   VerifyPointer(access_check_info());
+  VerifyPointer(fast_call_function());
+  VerifyPointer(fast_call_signature());
 }
 
 
@@ -68,6 +68,12 @@ PropertyDetails PropertyDetails::AsDeleted() {
 }
 
 
+PropertyDetails PropertyDetails::AsDoubleField() {
+  Smi* smi = Smi::FromInt(value_ | DoubleField::encode(1));
+  return PropertyDetails(smi);
+}
+
+
 #define TYPE_CHECKER(type, instancetype)                                \
   bool Object::Is##type() {                                             \
   return Object::IsHeapObject() &&                                      \
@@ -1537,6 +1543,14 @@ Object* JSObject::FastPropertyAt(int index) {
 }
 
 
+MaybeObject* JSObject::FastPropertyValueAt(int index,
+                                           PropertyDetails details) {
+  Object* value = FastPropertyAt(index);
+  if (!details.IsDoubleField()) return value;
+  return GetHeap()->AllocateHeapNumber(HeapNumber::cast(value)->value());
+}
+
+
 Object* JSObject::FastPropertyAtPut(int index, Object* value) {
   // Adjust for the number of properties stored in the object.
   index -= map()->inobject_properties();
@@ -3173,6 +3187,21 @@ void Code::set_compiled_optimizable(bool value) {
 }
 
 
+bool Code::has_code_age_sequence() {
+  ASSERT_EQ(FUNCTION, kind());
+  byte flags = READ_BYTE_FIELD(this, kFullCodeFlags);
+  return FullCodeFlagsHasCodeAgeSequence::decode(flags);
+}
+
+
+void Code::set_has_code_age_sequence(bool value) {
+  ASSERT_EQ(FUNCTION, kind());
+  byte flags = READ_BYTE_FIELD(this, kFullCodeFlags);
+  flags = FullCodeFlagsHasCodeAgeSequence::update(flags, value);
+  WRITE_BYTE_FIELD(this, kFullCodeFlags, flags);
+}
+
+
 int Code::allow_osr_at_loop_nesting_level() {
   ASSERT_EQ(FUNCTION, kind());
   return READ_BYTE_FIELD(this, kAllowOSRAtLoopNestingLevelOffset);
@@ -3215,6 +3244,22 @@ void Code::set_stack_slots(unsigned slots) {
 }
 
 
+int Code::optimized_code_age() {
+  ASSERT(kind() == OPTIMIZED_FUNCTION);
+  return OptimizedCodeAgeField::decode(
+      READ_UINT32_FIELD(this, kKindSpecificFlags1Offset));
+}
+
+
+void Code::set_optimized_code_age(int age) {
+  ASSERT(kind() == OPTIMIZED_FUNCTION);
+  ASSERT(age >= 0 && age < (1 << kOptimizedCodeAgeBitCount));
+  int previous = READ_UINT32_FIELD(this, kKindSpecificFlags1Offset);
+  int updated = OptimizedCodeAgeField::update(previous, age);
+  WRITE_UINT32_FIELD(this, kKindSpecificFlags1Offset, updated);
+}
+
+
 unsigned Code::safepoint_table_offset() {
   ASSERT(kind() == OPTIMIZED_FUNCTION);
   return SafepointTableOffsetField::decode(
@@ -3810,6 +3855,10 @@ ACCESSORS(FunctionTemplateInfo, instance_call_handler, Object,
           kInstanceCallHandlerOffset)
 ACCESSORS(FunctionTemplateInfo, access_check_info, Object,
           kAccessCheckInfoOffset)
+ACCESSORS(FunctionTemplateInfo, fast_call_function, Object,
+          kFastCallFunctionOffset)
+ACCESSORS(FunctionTemplateInfo, fast_call_signature, Object,
+          kFastCallSignatureOffset)
 ACCESSORS_TO_SMI(FunctionTemplateInfo, flag, kFlagOffset)
 
 ACCESSORS(ObjectTemplateInfo, constructor, Object, kConstructorOffset)
@@ -4067,15 +4116,15 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_optimize,
                kDontOptimize)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_inline, kDontInline)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_cache, kDontCache)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints,
+               optimization_profile_checked,
+               kOptimizationProfileChecked)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints,
+               in_optimization_profile,
+               kInOptimizationProfile)
 
 void SharedFunctionInfo::BeforeVisitingPointers() {
   if (IsInobjectSlackTrackingInProgress()) DetachInitialMap();
-
-  // Flush optimized code map on major GC.
-  // Note: we may experiment with rebuilding it or retaining entries
-  // which should survive as we iterate through optimized functions
-  // anyway.
-  set_optimized_code_map(Smi::FromInt(0));
 }
 
 
@@ -4224,6 +4273,16 @@ void SharedFunctionInfo::set_opt_reenable_tries(int tries) {
 }
 
 
+int SharedFunctionInfo::deopt_backoff() {
+  return DeoptBackoffBits::decode(counters());
+}
+
+
+void SharedFunctionInfo::set_deopt_backoff(int value) {
+  set_counters(DeoptBackoffBits::update(counters(), value));
+}
+
+
 bool SharedFunctionInfo::has_deoptimization_support() {
   Code* code = this->code();
   return code->kind() == Code::FUNCTION && code->has_deoptimization_support();
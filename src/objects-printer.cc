@@ -954,6 +954,10 @@ void FunctionTemplateInfo::FunctionTemplateInfoPrint(FILE* out) {
   signature()->ShortPrint(out);
   PrintF(out, "\n - access_check_info: ");
   access_check_info()->ShortPrint(out);
+  PrintF(out, "\n - fast_call_function: ");
+  fast_call_function()->ShortPrint(out);
+  PrintF(out, "\n - fast_call_signature: ");
+  fast_call_signature()->ShortPrint(out);
   PrintF(out, "\n - hidden_prototype: %s",
          hidden_prototype() ? "true" : "false");
   PrintF(out, "\n - undetectable: %s", undetectable() ? "true" : "false");
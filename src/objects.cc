@@ -623,10 +623,13 @@ MaybeObject* Object::GetProperty(Object* receiver,
       value = result->holder()->GetNormalizedProperty(result);
       ASSERT(!value->IsTheHole() || result->IsReadOnly());
       return value->IsTheHole() ? heap->undefined_value() : value;
-    case FIELD:
-      value = result->holder()->FastPropertyAt(result->GetFieldIndex());
+    case FIELD: {
+      MaybeObject* maybe_value = result->holder()->FastPropertyValueAt(
+          result->GetFieldIndex(), result->GetPropertyDetails());
+      if (!maybe_value->ToObject(&value)) return maybe_value;
       ASSERT(!value->IsTheHole() || result->IsReadOnly());
       return value->IsTheHole() ? heap->undefined_value() : value;
+    }
     case CONSTANT_FUNCTION:
       return result->GetConstantFunction();
     case CALLBACKS:
@@ -1489,6 +1492,14 @@ MaybeObject* JSObject::AddFastPropertyUsingMap(Map* new_map,
                                                String* name,
                                                Object* value,
                                                int field_index) {
+  Object* field_value = value;
+  DescriptorArray* descriptors = new_map->instance_descriptors();
+  if (descriptors->GetDetails(new_map->LastAdded()).IsDoubleField()) {
+    // The caller has checked that the value is a number.
+    MaybeObject* maybe_number =
+        GetHeap()->AllocateHeapNumber(value->Number());
+    if (!maybe_number->ToObject(&field_value)) return maybe_number;
+  }
   if (map()->unused_property_fields() == 0) {
     int new_unused = new_map->unused_property_fields();
     FixedArray* values;
@@ -1499,7 +1510,8 @@ MaybeObject* JSObject::AddFastPropertyUsingMap(Map* new_map,
     set_properties(values);
   }
   set_map(new_map);
-  return FastPropertyAtPut(field_index, value);
+  FastPropertyAtPut(field_index, field_value);
+  return value;
 }
 
 
@@ -1550,6 +1562,20 @@ MaybeObject* JSObject::AddFastProperty(String* name,
   // Allocate new instance descriptors with (name, index) added
   FieldDescriptor new_field(name, index, attributes, 0);
 
+  // Named stores of heap numbers give the object a double field with its
+  // own heap number, which optimized code can then update in place.  Other
+  // stores, like the ones setting up literal boilerplates that are later
+  // copied word by word, keep plain fields.
+  Object* field_value = value;
+  if (FLAG_track_double_fields &&
+      value->IsHeapNumber() &&
+      store_mode == CERTAINLY_NOT_STORE_FROM_KEYED) {
+    MaybeObject* maybe_number =
+        GetHeap()->AllocateHeapNumber(HeapNumber::cast(value)->value());
+    if (!maybe_number->ToObject(&field_value)) return maybe_number;
+    new_field.SetDoubleField();
+  }
+
   ASSERT(index < map()->inobject_properties() ||
          (index - map()->inobject_properties()) < properties()->length() ||
          map()->unused_property_fields() == 0);
@@ -1581,7 +1607,8 @@ MaybeObject* JSObject::AddFastProperty(String* name,
   }
 
   set_map(new_map);
-  return FastPropertyAtPut(index, value);
+  FastPropertyAtPut(index, field_value);
+  return value;
 }
 
 
@@ -1739,6 +1766,22 @@ MaybeObject* JSObject::ReplaceSlowProperty(String* name,
 }
 
 
+MaybeObject* JSObject::FastPropertyValueAtPut(String* name,
+                                              int index,
+                                              PropertyDetails details,
+                                              Object* value) {
+  if (!details.IsDoubleField()) return FastPropertyAtPut(index, value);
+  if (!value->IsNumber()) {
+    Object* obj;
+    MaybeObject* maybe_obj = NormalizeProperties(CLEAR_INOBJECT_PROPERTIES, 0);
+    if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+    return ReplaceSlowProperty(name, value, details.attributes());
+  }
+  HeapNumber::cast(FastPropertyAt(index))->set_value(value->Number());
+  return value;
+}
+
+
 MaybeObject* JSObject::ConvertTransitionToMapTransition(
     int transition_index,
     String* name,
@@ -2868,7 +2911,10 @@ MaybeObject* JSObject::SetPropertyForResult(LookupResult* result,
     case NORMAL:
       return self->SetNormalizedProperty(result, *value);
     case FIELD:
-      return self->FastPropertyAtPut(result->GetFieldIndex(), *value);
+      return self->FastPropertyValueAtPut(*name,
+                                          result->GetFieldIndex(),
+                                          result->GetPropertyDetails(),
+                                          *value);
     case CONSTANT_FUNCTION:
       // Only replace the function if necessary.
       if (*value == result->GetConstantFunction()) return *value;
@@ -2896,7 +2942,8 @@ MaybeObject* JSObject::SetPropertyForResult(LookupResult* result,
       PropertyDetails details = descriptors->GetDetails(descriptor);
 
       if (details.type() == FIELD) {
-        if (attributes == details.attributes()) {
+        if (attributes == details.attributes() &&
+            (!details.IsDoubleField() || value->IsNumber())) {
           int field_index = descriptors->GetFieldIndex(descriptor);
           return self->AddFastPropertyUsingMap(transition_map,
                                                *name,
@@ -2998,7 +3045,10 @@ MaybeObject* JSObject::SetLocalPropertyIgnoreAttributes(
       return SetNormalizedProperty(name, value, details);
     }
     case FIELD:
-      return FastPropertyAtPut(result.GetFieldIndex(), value);
+      return FastPropertyValueAtPut(name,
+                                    result.GetFieldIndex(),
+                                    result.GetPropertyDetails(),
+                                    value);
     case CONSTANT_FUNCTION:
       // Only replace the function if necessary.
       if (value == result.GetConstantFunction()) return value;
@@ -3016,8 +3066,10 @@ MaybeObject* JSObject::SetLocalPropertyIgnoreAttributes(
       DescriptorArray* descriptors = transition_map->instance_descriptors();
       PropertyDetails details = descriptors->GetDetails(descriptor);
 
+      // Objects set up here may be boilerplates, which must not get
+      // double fields.
       if (details.type() == FIELD) {
-        if (attributes == details.attributes()) {
+        if (attributes == details.attributes() && !details.IsDoubleField()) {
           int field_index = descriptors->GetFieldIndex(descriptor);
           return AddFastPropertyUsingMap(transition_map,
                                          name,
@@ -7417,19 +7469,29 @@ void SharedFunctionInfo::AddToOptimizedCodeMap(
     new_code_map->set(1, *code);
     new_code_map->set(2, *literals);
   } else {
-    // Copy old map and append one new entry.
     Handle<FixedArray> old_code_map(FixedArray::cast(value));
     ASSERT_EQ(-1, shared->SearchOptimizedCodeMap(*global_context));
     int old_length = old_code_map->length();
-    int new_length = old_length + kEntryLength;
-    new_code_map = FACTORY->NewFixedArray(new_length);
-    old_code_map->CopyTo(0, *new_code_map, 0, old_length);
-    new_code_map->set(old_length, *global_context);
-    new_code_map->set(old_length + 1, *code);
-    new_code_map->set(old_length + 2, *literals);
+    // Reuse an entry cleared by the garbage collector, if there is one.
+    int index = 0;
+    while (index < old_length && !old_code_map->get(index)->IsUndefined()) {
+      index += kEntryLength;
+    }
+    if (index < old_length) {
+      new_code_map = old_code_map;
+    } else {
+      // Copy old map and append one new entry.
+      int new_length = old_length + kEntryLength;
+      new_code_map = FACTORY->NewFixedArray(new_length);
+      old_code_map->CopyTo(0, *new_code_map, 0, old_length);
+    }
+    new_code_map->set(index, *global_context);
+    new_code_map->set(index + 1, *code);
+    new_code_map->set(index + 2, *literals);
   }
 #ifdef DEBUG
   for (int i = 0; i < new_code_map->length(); i += kEntryLength) {
+    if (new_code_map->get(i)->IsUndefined()) continue;
     ASSERT(new_code_map->get(i)->IsGlobalContext());
     ASSERT(new_code_map->get(i + 1)->IsCode());
     ASSERT(Code::cast(new_code_map->get(i + 1))->kind() ==
@@ -7455,6 +7517,9 @@ void SharedFunctionInfo::InstallFromOptimizedCodeMap(JSFunction* function,
   ASSERT(code != NULL);
   ASSERT(function->context()->global_context() == code_map->get(index - 1));
   function->ReplaceCode(code);
+  // Reusing the cached code counts as running the function for code aging.
+  set_code_age(0);
+  code->set_optimized_code_age(0);
 }
 
 
@@ -8107,10 +8172,41 @@ void Code::Relocate(intptr_t delta) {
   for (RelocIterator it(this, RelocInfo::kApplyMask); !it.done(); it.next()) {
     it.rinfo()->apply(delta);
   }
+  // The call in an old code age sequence has no relocation info.  Patch it
+  // again for the new position, or make the code young if the builtin is
+  // out of reach from there.
+  if (kind() == FUNCTION && IsOld()) {
+    Code* stub =
+        GetIsolate()->builtins()->builtin(Builtins::kMakeCodeYoungAgain);
+    if (!PatchPlatformCodeAge(instruction_start(), stub)) {
+      PatchPlatformCodeAge(instruction_start(), NULL);
+    }
+  }
   CPU::FlushICache(instruction_start(), instruction_size());
 }
 
 
+bool Code::IsOld() {
+  return has_code_age_sequence() && !IsYoungSequence(instruction_start());
+}
+
+
+bool Code::MakeOlder() {
+  ASSERT(has_code_age_sequence());
+  // The snapshot must not contain calls to the builtin.
+  if (Serializer::enabled()) return false;
+  if (IsOld()) return true;
+  Code* stub =
+      GetIsolate()->builtins()->builtin(Builtins::kMakeCodeYoungAgain);
+  return PatchPlatformCodeAge(instruction_start(), stub);
+}
+
+
+void Code::MakeCodeAgeSequenceYoung(byte* sequence) {
+  PatchPlatformCodeAge(sequence, NULL);
+}
+
+
 void Code::CopyFrom(const CodeDesc& desc) {
   ASSERT(Marking::Color(this) == Marking::WHITE_OBJECT);
 
@@ -8387,6 +8483,15 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(FILE* out) {
 
         case Translation::ARGUMENTS_OBJECT:
           break;
+
+        case Translation::CAPTURED_OBJECT: {
+          int map_index = iterator.Next();
+          int object_id = iterator.Next();
+          int field_count = iterator.Next();
+          PrintF(out, "{map=%d, id=%d, fields=%d}",
+                 map_index, object_id, field_count);
+          break;
+        }
       }
       PrintF(out, "\n");
     }
@@ -12804,6 +12909,292 @@ void ObjectHashTable::RemoveEntry(int entry) {
 }
 
 
+template<class Derived, int entrysize>
+MaybeObject* OrderedHashTable<Derived, entrysize>::Allocate(
+    Heap* heap, int capacity, PretenureFlag pretenure) {
+  capacity = RoundUpToPowerOf2(Max(capacity, kMinCapacity));
+  if (capacity > kMaxCapacity) {
+    return Failure::OutOfMemoryException();
+  }
+  int num_buckets = capacity / kLoadFactor;
+  Derived* table;
+  { MaybeObject* maybe_table = heap->AllocateFixedArray(
+        kHashTableStartIndex + num_buckets + capacity * kEntrySize,
+        pretenure);
+    if (!maybe_table->To(&table)) return maybe_table;
+  }
+  for (int i = 0; i < num_buckets; i++) {
+    table->set(kHashTableStartIndex + i, Smi::FromInt(kNotFound));
+  }
+  table->set(kNumberOfElementsIndex, Smi::FromInt(0));
+  table->set(kNumberOfDeletedElementsIndex, Smi::FromInt(0));
+  table->set(kNumberOfBucketsIndex, Smi::FromInt(num_buckets));
+  table->set(kNextTableIndex, heap->undefined_value());
+  return table;
+}
+
+
+template<class Derived, int entrysize>
+MaybeObject* OrderedHashTable<Derived, entrysize>::EnsureGrowable() {
+  int capacity = Capacity();
+  if (UsedCapacity() < capacity) return this;
+  // Only grow if less than half of the entries have been removed.
+  return Rehash(NumberOfDeletedElements() >= capacity / 2
+                    ? capacity
+                    : capacity * 2);
+}
+
+
+template<class Derived, int entrysize>
+MaybeObject* OrderedHashTable<Derived, entrysize>::Shrink() {
+  int capacity = Capacity();
+  if (capacity <= kMinCapacity || NumberOfElements() >= capacity / 4) {
+    return this;
+  }
+  return Rehash(capacity / 2);
+}
+
+
+template<class Derived, int entrysize>
+MaybeObject* OrderedHashTable<Derived, entrysize>::Rehash(int new_capacity) {
+  Heap* heap = GetHeap();
+  Derived* new_table;
+  { MaybeObject* maybe_table = Allocate(
+        heap, new_capacity, heap->InNewSpace(this) ? NOT_TENURED : TENURED);
+    if (!maybe_table->To(&new_table)) return maybe_table;
+  }
+  // Copy the live entries in insertion order.
+  int used_capacity = UsedCapacity();
+  for (int entry = 0; entry < used_capacity; entry++) {
+    Object* key = KeyAt(entry);
+    if (key->IsTheHole()) continue;
+    Object* hash = HashOf(key, OMIT_CREATION)->ToObjectUnchecked();
+    int new_entry = new_table->AddEntry(key, Smi::cast(hash)->value());
+    int from_index = EntryToIndex(entry);
+    int to_index = new_table->EntryToIndex(new_entry);
+    for (int i = 1; i < entrysize; i++) {
+      new_table->set(to_index + i, get(from_index + i));
+    }
+  }
+  MarkObsolete(new_table);
+  return new_table;
+}
+
+
+template<class Derived, int entrysize>
+void OrderedHashTable<Derived, entrysize>::MarkObsolete(Derived* next_table) {
+  // The k-th removed entry has an entry number of at least k, so its number
+  // can be written over the entries that have already been read.
+  int used_capacity = UsedCapacity();
+  int first_index = EntryToIndex(0);
+  int removed = 0;
+  for (int entry = 0; entry < used_capacity; entry++) {
+    if (KeyAt(entry)->IsTheHole()) {
+      set(first_index + removed, Smi::FromInt(entry));
+      removed++;
+    }
+  }
+  ASSERT(removed == NumberOfDeletedElements());
+  // Drop the keys and values so that iterations do not keep them alive.
+  for (int i = first_index + removed; i < length(); i++) {
+    set_the_hole(i);
+  }
+  set(kNextTableIndex, next_table);
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::TranslateEntry(int entry) {
+  ASSERT(IsObsolete());
+  // Binary search for the number of entries removed before the given one.
+  int first_index = EntryToIndex(0);
+  int low = 0;
+  int high = NumberOfDeletedElements();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (Smi::cast(get(first_index + mid))->value() < entry) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return entry - low;
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::FindEntry(Object* key) {
+  key = NormalizeKey(GetHeap(), key);
+  // If the object does not have an identity hash, it was never used as a key.
+  Object* hash = HashOf(key, OMIT_CREATION)->ToObjectUnchecked();
+  if (hash->IsUndefined()) return kNotFound;
+  int bucket = Smi::cast(hash)->value() & (NumberOfBuckets() - 1);
+  Object* entry = get(kHashTableStartIndex + bucket);
+  while (entry != Smi::FromInt(kNotFound)) {
+    int candidate = Smi::cast(entry)->value();
+    if (KeyAt(candidate)->SameValue(key)) return candidate;
+    entry = get(EntryToIndex(candidate) + kChainOffset);
+  }
+  return kNotFound;
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::NextEntry(int entry) {
+  int used_capacity = UsedCapacity();
+  for (; entry < used_capacity; entry++) {
+    if (!KeyAt(entry)->IsTheHole()) return entry;
+  }
+  return kNotFound;
+}
+
+
+template<class Derived, int entrysize>
+Object* OrderedHashTable<Derived, entrysize>::NormalizeKey(Heap* heap,
+                                                           Object* key) {
+  if (key->IsHeapNumber()) {
+    static const DoubleRepresentation minus_zero(-0.0);
+    double value = HeapNumber::cast(key)->value();
+    if (isnan(value)) return heap->nan_value();
+    if (DoubleRepresentation(value).bits == minus_zero.bits) return key;
+    int int_value = FastD2I(value);
+    if (value == int_value && Smi::IsValid(int_value)) {
+      return Smi::FromInt(int_value);
+    }
+  } else if (key->IsString() && !key->IsSymbol()) {
+    String* symbol;
+    if (heap->LookupSymbolIfExists(String::cast(key), &symbol)) {
+      return symbol;
+    }
+  }
+  return key;
+}
+
+
+template<class Derived, int entrysize>
+MaybeObject* OrderedHashTable<Derived, entrysize>::HashOf(Object* key,
+                                                          CreationFlag flag) {
+  // Smis are hashed like number dictionary keys so that generated code can
+  // use MacroAssembler::GetNumberHash.
+  if (key->IsSmi()) {
+    uint32_t hash = ComputeIntegerHash(Smi::cast(key)->value(),
+                                       GetHeap()->HashSeed());
+    return Smi::FromInt(hash & Smi::kMaxValue);
+  }
+  return key->GetHash(flag);
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::AddEntry(Object* key, int hash) {
+  ASSERT(UsedCapacity() < Capacity());
+  int entry = UsedCapacity();
+  int bucket = hash & (NumberOfBuckets() - 1);
+  int index = EntryToIndex(entry);
+  set(index, key);
+  set(index + kChainOffset, get(kHashTableStartIndex + bucket));
+  set(kHashTableStartIndex + bucket, Smi::FromInt(entry));
+  SetNumberOfElements(NumberOfElements() + 1);
+  return entry;
+}
+
+
+template<class Derived, int entrysize>
+void OrderedHashTable<Derived, entrysize>::RemoveEntry(int entry) {
+  // The chain is kept intact until the table is rehashed.
+  int index = EntryToIndex(entry);
+  for (int i = 0; i < entrysize; i++) {
+    set_the_hole(index + i);
+  }
+  SetNumberOfElements(NumberOfElements() - 1);
+  SetNumberOfDeletedElements(NumberOfDeletedElements() + 1);
+}
+
+
+template class OrderedHashTable<OrderedHashSet, 1>;
+
+template class OrderedHashTable<OrderedHashMap, 2>;
+
+
+bool OrderedHashSet::Contains(Object* key) {
+  return FindEntry(key) != kNotFound;
+}
+
+
+MaybeObject* OrderedHashSet::Add(Object* key) {
+  ASSERT(!key->IsString() || key->IsSymbol());
+  key = NormalizeKey(GetHeap(), key);
+
+  // Make sure the key object has an identity hash code.
+  int hash;
+  { MaybeObject* maybe_hash = HashOf(key, ALLOW_CREATION);
+    if (maybe_hash->IsFailure()) return maybe_hash;
+    hash = Smi::cast(maybe_hash->ToObjectUnchecked())->value();
+  }
+
+  // Check whether key is already present.
+  if (FindEntry(key) != kNotFound) return this;
+
+  OrderedHashSet* table;
+  { MaybeObject* maybe_table = EnsureGrowable();
+    if (!maybe_table->To(&table)) return maybe_table;
+  }
+  table->AddEntry(key, hash);
+  return table;
+}
+
+
+MaybeObject* OrderedHashSet::Remove(Object* key) {
+  int entry = FindEntry(key);
+  if (entry == kNotFound) return this;
+  RemoveEntry(entry);
+  return Shrink();
+}
+
+
+Object* OrderedHashMap::Lookup(Object* key) {
+  int entry = FindEntry(key);
+  if (entry == kNotFound) return GetHeap()->the_hole_value();
+  return ValueAt(entry);
+}
+
+
+MaybeObject* OrderedHashMap::Put(Object* key, Object* value) {
+  // Check whether to perform removal operation.
+  if (value->IsTheHole()) {
+    int entry = FindEntry(key);
+    if (entry == kNotFound) return this;
+    RemoveEntry(entry);
+    return Shrink();
+  }
+
+  ASSERT(!key->IsString() || key->IsSymbol());
+  key = NormalizeKey(GetHeap(), key);
+
+  // Make sure the key object has an identity hash code.
+  int hash;
+  { MaybeObject* maybe_hash = HashOf(key, ALLOW_CREATION);
+    if (maybe_hash->IsFailure()) return maybe_hash;
+    hash = Smi::cast(maybe_hash->ToObjectUnchecked())->value();
+  }
+
+  // Key is already in table, just overwrite value.
+  int entry = FindEntry(key);
+  if (entry != kNotFound) {
+    set(EntryToIndex(entry) + kValueOffset, value);
+    return this;
+  }
+
+  OrderedHashMap* table;
+  { MaybeObject* maybe_table = EnsureGrowable();
+    if (!maybe_table->To(&table)) return maybe_table;
+  }
+  entry = table->AddEntry(key, hash);
+  table->set(table->EntryToIndex(entry) + kValueOffset, value);
+  return table;
+}
+
+
 #ifdef ENABLE_DEBUGGER_SUPPORT
 // Check if there is a break point at this code position.
 bool DebugInfo::HasBreakPoint(int code_position) {
@@ -177,6 +177,18 @@ enum TransitionFlag {
 };
 
 
+// Types of the parameters and the return value of the C functions
+// registered with FunctionTemplate::SetFastCallHandler.  Must match
+// v8::FastCallbackType.
+enum FastCallType {
+  FAST_CALL_VOID,
+  FAST_CALL_INT32,
+  FAST_CALL_DOUBLE,
+  FAST_CALL_BOOL,
+  FAST_CALL_EXTERNAL
+};
+
+
 // Instance size sentinel for objects of variable size.
 const int kVariableSizeSentinel = 0;
 
@@ -2028,6 +2040,20 @@ class JSObject: public JSReceiver {
   inline Object* FastPropertyAt(int index);
   inline Object* FastPropertyAtPut(int index, Object* value);
 
+  // Reads a fast-case property whose value may escape.  The heap number of
+  // a double field is updated in place, so it is returned as a copy.
+  MUST_USE_RESULT inline MaybeObject* FastPropertyValueAt(
+      int index,
+      PropertyDetails details);
+
+  // Stores into a fast-case property.  A number stored in a double field
+  // updates its heap number; anything else normalizes the object.
+  MUST_USE_RESULT MaybeObject* FastPropertyValueAtPut(
+      String* name,
+      int index,
+      PropertyDetails details,
+      Object* value);
+
   // Access to in object properties.
   inline int GetInObjectPropertyOffset(int index);
   inline Object* InObjectPropertyAt(int index);
@@ -3338,6 +3364,184 @@ class ObjectHashTable: public HashTable<ObjectHashTableShape<2>, Object*> {
 };
 
 
+// OrderedHashTable is a hash table with Object keys that preserves
+// insertion order.  It is used as the backing store of Harmony sets and
+// maps.  Collisions are resolved by chaining entries in the same bucket,
+// and everything is stored in a single fixed array:
+//   [0]: element count
+//   [1]: deleted element count
+//   [2]: bucket count
+//   [3]: the table this one was rehashed into, or undefined
+//   [4 .. 4 + bucket count): the index of the first entry in each bucket,
+//       or kNotFound if the bucket is empty.
+//   [4 + bucket count .. length): the entries in insertion order.  Each
+//       entry is followed by the index of the next entry in its bucket.
+// Removed entries have their key replaced by the hole and are only
+// dropped when the table is rehashed, which keeps lookups and iteration
+// deterministic.
+//
+// Iterations walk a table by entry number.  When a table is rehashed it
+// becomes obsolete: it points to the table that replaced it and, in place
+// of its entries, holds the sorted numbers of the entries that were
+// removed before the rehash.  An iteration that still refers to an
+// obsolete table uses them to translate its entry number into the new
+// table, see TranslateEntry.
+//
+// Keys are normalized so that SameValue keys are stored as the same
+// object where possible: integral heap numbers are replaced by smis and
+// all NaNs by the canonical NaN.  String keys are required to be symbols.
+// Generated code relies on this to look up smi and symbol keys by
+// identity, see HOrderedHashTableLookup.
+template<class Derived, int entrysize>
+class OrderedHashTable: public FixedArray {
+ public:
+  // Returns a new table with room for at least the given number of
+  // entries before it needs to grow.
+  MUST_USE_RESULT static MaybeObject* Allocate(
+      Heap* heap, int capacity, PretenureFlag pretenure = NOT_TENURED);
+
+  // Returns a table with room for at least one more entry, which is this
+  // table if it is not full.
+  MUST_USE_RESULT MaybeObject* EnsureGrowable();
+
+  // Returns a smaller table if enough entries have been removed, or this
+  // table otherwise.
+  MUST_USE_RESULT MaybeObject* Shrink();
+
+  // Returns the entry for the given key or kNotFound.
+  int FindEntry(Object* key);
+
+  int NumberOfElements() {
+    return Smi::cast(get(kNumberOfElementsIndex))->value();
+  }
+
+  int NumberOfDeletedElements() {
+    return Smi::cast(get(kNumberOfDeletedElementsIndex))->value();
+  }
+
+  int NumberOfBuckets() {
+    return Smi::cast(get(kNumberOfBucketsIndex))->value();
+  }
+
+  // Returns whether this table has been replaced by a rehashed one.
+  bool IsObsolete() { return !get(kNextTableIndex)->IsUndefined(); }
+
+  // Returns the table that replaced an obsolete table.
+  Derived* NextTable() {
+    ASSERT(IsObsolete());
+    return Derived::cast(get(kNextTableIndex));
+  }
+
+  // Translates an entry number of an obsolete table into the number of the
+  // same entry, or of the first entry following it, in NextTable().
+  int TranslateEntry(int entry);
+
+  // Returns the number of entries, including removed ones.
+  int UsedCapacity() {
+    return NumberOfElements() + NumberOfDeletedElements();
+  }
+
+  int Capacity() { return NumberOfBuckets() * kLoadFactor; }
+
+  int EntryToIndex(int entry) {
+    return kHashTableStartIndex + NumberOfBuckets() + entry * kEntrySize;
+  }
+
+  // Returns the key of an entry, which is the hole for removed entries.
+  Object* KeyAt(int entry) { return get(EntryToIndex(entry)); }
+
+  // Returns the first entry at or after the given one that has not been
+  // removed, or kNotFound.
+  int NextEntry(int entry);
+
+  // Returns the normalized form of a key, see above.  Strings that are
+  // not symbols are only replaced by the symbol if it already exists.
+  static Object* NormalizeKey(Heap* heap, Object* key);
+
+  static const int kNotFound = -1;
+  static const int kEntrySize = entrysize + 1;
+  static const int kChainOffset = entrysize;
+  static const int kLoadFactor = 2;
+  static const int kMinCapacity = 4;
+  static const int kMaxCapacity =
+      (FixedArray::kMaxLength - 4) / (1 + kEntrySize * kLoadFactor);
+
+  static const int kNumberOfElementsIndex = 0;
+  static const int kNumberOfDeletedElementsIndex = 1;
+  static const int kNumberOfBucketsIndex = 2;
+  static const int kNextTableIndex = 3;
+  static const int kHashTableStartIndex = 4;
+
+ protected:
+  // Returns the hash of a normalized key as a smi.  Returns undefined for
+  // receivers without an identity hash if creation is omitted.
+  MUST_USE_RESULT MaybeObject* HashOf(Object* key, CreationFlag flag);
+
+  // Adds an entry for a key with the given hash, which must not be in the
+  // table yet.  The table must not be full.  Returns the new entry.
+  int AddEntry(Object* key, int hash);
+
+  // Marks an entry as removed.
+  void RemoveEntry(int entry);
+
+ private:
+  MUST_USE_RESULT MaybeObject* Rehash(int new_capacity);
+
+  void SetNumberOfElements(int value) {
+    set(kNumberOfElementsIndex, Smi::FromInt(value));
+  }
+
+  void SetNumberOfDeletedElements(int value) {
+    set(kNumberOfDeletedElementsIndex, Smi::FromInt(value));
+  }
+
+  // Makes this table obsolete after it has been rehashed into the given
+  // table.  Its entries are replaced by the numbers of the removed ones.
+  void MarkObsolete(Derived* next_table);
+};
+
+
+class OrderedHashSet: public OrderedHashTable<OrderedHashSet, 1> {
+ public:
+  static inline OrderedHashSet* cast(Object* obj) {
+    ASSERT(obj->IsFixedArray());
+    return reinterpret_cast<OrderedHashSet*>(obj);
+  }
+
+  // Looks up whether the given key is part of this hash set.
+  bool Contains(Object* key);
+
+  // Adds the given key to this hash set.
+  MUST_USE_RESULT MaybeObject* Add(Object* key);
+
+  // Removes the given key from this hash set.
+  MUST_USE_RESULT MaybeObject* Remove(Object* key);
+};
+
+
+class OrderedHashMap: public OrderedHashTable<OrderedHashMap, 2> {
+ public:
+  static inline OrderedHashMap* cast(Object* obj) {
+    ASSERT(obj->IsFixedArray());
+    return reinterpret_cast<OrderedHashMap*>(obj);
+  }
+
+  // Looks up the value associated with the given key. The hole value is
+  // returned in case the key is not present.
+  Object* Lookup(Object* key);
+
+  // Adds (or overwrites) the value associated with the given key. Mapping a
+  // key to the hole value causes removal of the whole entry.
+  MUST_USE_RESULT MaybeObject* Put(Object* key, Object* value);
+
+  Object* ValueAt(int entry) {
+    return get(EntryToIndex(entry) + kValueOffset);
+  }
+
+  static const int kValueOffset = 1;
+};
+
+
 // JSFunctionResultCache caches results of some JSFunction invocation.
 // It is a fixed array with fixed structure:
 //   [0]: factory function
@@ -4334,6 +4538,11 @@ class Code: public HeapObject {
   inline bool is_compiled_optimizable();
   inline void set_compiled_optimizable(bool value);
 
+  // [has_code_age_sequence]: For FUNCTION kind, tells if the code starts
+  // with the young code age sequence.  See MakeOlder.
+  inline bool has_code_age_sequence();
+  inline void set_has_code_age_sequence(bool value);
+
   // [allow_osr_at_loop_nesting_level]: For FUNCTION kind, tells for
   // how long the function has been marked for OSR and therefore which
   // level of loop nesting we are willing to do on-stack replacement
@@ -4351,6 +4560,12 @@ class Code: public HeapObject {
   inline unsigned stack_slots();
   inline void set_stack_slots(unsigned slots);
 
+  // [optimized_code_age]: For kind OPTIMIZED_FUNCTION, the number of full
+  // collections since the code was last seen installed in a closure.  Used
+  // to age the entries of optimized code maps.
+  inline int optimized_code_age();
+  inline void set_optimized_code_age(int age);
+
   // [safepoint_table_start]: For kind OPTIMIZED_CODE, the offset in
   // the instruction stream where the safepoint table starts.
   inline unsigned safepoint_table_offset();
@@ -4406,6 +4621,20 @@ class Code: public HeapObject {
   // Find the first map in an IC stub.
   Map* FindFirstMap();
 
+  // Code aging.  MakeOlder patches the code age sequence at the start of
+  // FUNCTION code into a call to the MakeCodeYoungAgain builtin, which
+  // patches the young sequence back in when the code runs.  Code that is
+  // still old at the next full collection did not run in between.
+  // MakeOlder returns false if the sequence could not be patched.
+  bool IsOld();
+  bool MakeOlder();
+  static void MakeCodeAgeSequenceYoung(byte* sequence);
+
+  // Platform specific code aging support, see codegen-<arch>.cc.  Patching
+  // with a NULL stub restores the young sequence.
+  static bool IsYoungSequence(byte* sequence);
+  static bool PatchPlatformCodeAge(byte* sequence, Code* stub);
+
   class ExtraICStateStrictMode: public BitField<StrictModeFlag, 0, 1> {};
   class ExtraICStateKeyedAccessGrowMode:
       public BitField<KeyedAccessGrowMode, 1, 1> {};  // NOLINT
@@ -4560,6 +4789,7 @@ class Code: public HeapObject {
       public BitField<bool, 0, 1> {};  // NOLINT
   class FullCodeFlagsHasDebugBreakSlotsField: public BitField<bool, 1, 1> {};
   class FullCodeFlagsIsCompiledOptimizable: public BitField<bool, 2, 1> {};
+  class FullCodeFlagsHasCodeAgeSequence: public BitField<bool, 3, 1> {};
 
   static const int kAllowOSRAtLoopNestingLevelOffset = kFullCodeFlags + 1;
   static const int kProfilerTicksOffset = kAllowOSRAtLoopNestingLevelOffset + 1;
@@ -4596,6 +4826,9 @@ class Code: public HeapObject {
   static const int kHasFunctionCacheFirstBit =
       kStackSlotsFirstBit + kStackSlotsBitCount;
   static const int kHasFunctionCacheBitCount = 1;
+  static const int kOptimizedCodeAgeFirstBit =
+      kStackSlotsFirstBit + kStackSlotsBitCount;
+  static const int kOptimizedCodeAgeBitCount = 3;
 
   STATIC_ASSERT(kStackSlotsFirstBit + kStackSlotsBitCount <= 32);
   STATIC_ASSERT(kUnaryOpTypeFirstBit + kUnaryOpTypeBitCount <= 32);
@@ -4606,6 +4839,7 @@ class Code: public HeapObject {
   STATIC_ASSERT(kCompareOperationFirstBit + kCompareOperationBitCount <= 32);
   STATIC_ASSERT(kToBooleanStateFirstBit + kToBooleanStateBitCount <= 32);
   STATIC_ASSERT(kHasFunctionCacheFirstBit + kHasFunctionCacheBitCount <= 32);
+  STATIC_ASSERT(kOptimizedCodeAgeFirstBit + kOptimizedCodeAgeBitCount <= 32);
 
   class StackSlotsField: public BitField<int,
       kStackSlotsFirstBit, kStackSlotsBitCount> {};  // NOLINT
@@ -4623,6 +4857,8 @@ class Code: public HeapObject {
       kToBooleanStateFirstBit, kToBooleanStateBitCount> {};  // NOLINT
   class HasFunctionCacheField: public BitField<bool,
       kHasFunctionCacheFirstBit, kHasFunctionCacheBitCount> {};  // NOLINT
+  class OptimizedCodeAgeField: public BitField<int,
+      kOptimizedCodeAgeFirstBit, kOptimizedCodeAgeBitCount> {};  // NOLINT
 
   // KindSpecificFlags2 layout (STUB and OPTIMIZED_FUNCTION)
   static const int kStubMajorKeyFirstBit = 0;
@@ -5337,15 +5573,23 @@ class Script: public Struct {
   V(Math, max, MathMax)                             \
   V(Math, min, MathMin)
 
+// Functions from experimental natives, which are only installed if the
+// corresponding feature is enabled.
+#define HARMONY_COLLECTIONS_FUNCTIONS_WITH_ID_LIST(V) \
+  V(Map.prototype, get, MapGet)                       \
+  V(Map.prototype, has, MapHas)                       \
+  V(Set.prototype, has, SetHas)
+
 
 enum BuiltinFunctionId {
 #define DECLARE_FUNCTION_ID(ignored1, ignore2, name)    \
   k##name,
   FUNCTIONS_WITH_ID_LIST(DECLARE_FUNCTION_ID)
-#undef DECLARE_FUNCTION_ID
   // Fake id for a special case of Math.pow. Note, it continues the
   // list of math functions.
   kMathPowHalf,
+  HARMONY_COLLECTIONS_FUNCTIONS_WITH_ID_LIST(DECLARE_FUNCTION_ID)
+#undef DECLARE_FUNCTION_ID
   kFirstMathFunctionId = kMathFloor
 };
 
@@ -5491,7 +5735,6 @@ class SharedFunctionInfo: public HeapObject {
   void CompleteInobjectSlackTracking();
 
   // Invoked before pointers in SharedFunctionInfo are being marked.
-  // Also clears the optimized code map.
   inline void BeforeVisitingPointers();
 
   // Clears the initial_map before the GC marking phase to ensure the reference
@@ -5679,6 +5922,14 @@ class SharedFunctionInfo: public HeapObject {
   // Indicates that code for this function cannot be cached.
   DECL_BOOLEAN_ACCESSORS(dont_cache)
 
+  // Indicates that the function was looked up in the loaded optimization
+  // profile of the runtime profiler.
+  DECL_BOOLEAN_ACCESSORS(optimization_profile_checked)
+
+  // Indicates that the function is in the optimization profile of the
+  // runtime profiler, so it does not have to be hashed and added again.
+  DECL_BOOLEAN_ACCESSORS(in_optimization_profile)
+
   // Indicates whether or not the code in the shared function support
   // deoptimization.
   inline bool has_deoptimization_support();
@@ -5731,9 +5982,15 @@ class SharedFunctionInfo: public HeapObject {
   inline void set_opt_reenable_tries(int value);
   inline int opt_reenable_tries();
 
+  // The largest number of times the function was deoptimized for any one
+  // reason.  The runtime profiler backs off reoptimization by it.
+  inline void set_deopt_backoff(int value);
+  inline int deopt_backoff();
+
   inline void TryReenableOptimization();
 
-  // Stores deopt_count, opt_reenable_tries and ic_age as bit-fields.
+  // Stores deopt_count, opt_reenable_tries, deopt_backoff and ic_age as
+  // bit-fields.
   inline void set_counters(int value);
   inline int counters();
 
@@ -5912,11 +6169,14 @@ class SharedFunctionInfo: public HeapObject {
     kDontOptimize,
     kDontInline,
     kDontCache,
+    kOptimizationProfileChecked,
+    kInOptimizationProfile,
     kCompilerHintsCount  // Pseudo entry
   };
 
   class DeoptCountBits: public BitField<int, 0, 4> {};
-  class OptReenableTriesBits: public BitField<int, 4, 18> {};
+  class OptReenableTriesBits: public BitField<int, 4, 15> {};
+  class DeoptBackoffBits: public BitField<int, 19, 3> {};
   class ICAgeBits: public BitField<int, 22, 8> {};
 
  private:
@@ -5946,6 +6206,11 @@ class SharedFunctionInfo: public HeapObject {
   static const int kNativeBitWithinByte =
       (kNative + kCompilerHintsSmiTagSize) % kBitsPerByte;
 
+  // The code age bits of the raw compiler hints field.  On architectures
+  // without a code age sequence full codegen clears them in the prologue.
+  static const int kCodeAgeRawMask =
+      kCodeAgeMask << (kCodeAgeShift + kCompilerHintsSmiTagSize);
+
 #if __BYTE_ORDER == __LITTLE_ENDIAN
   static const int kStrictModeByteOffset = kCompilerHintsOffset +
       (kStrictModeFunction + kCompilerHintsSmiTagSize) / kBitsPerByte;
@@ -8587,6 +8852,11 @@ class FunctionTemplateInfo: public TemplateInfo {
   DECL_ACCESSORS(instance_call_handler, Object)
   DECL_ACCESSORS(access_check_info, Object)
   DECL_ACCESSORS(flag, Smi)
+  // A Foreign holding the address of a C function that optimized code may
+  // call instead of the call handler, or undefined.
+  DECL_ACCESSORS(fast_call_function, Object)
+  // A Smi encoding the parameter and return types of fast_call_function.
+  DECL_ACCESSORS(fast_call_signature, Object)
 
   // Following properties use flag bits.
   DECL_BOOLEAN_ACCESSORS(hidden_prototype)
@@ -8627,7 +8897,27 @@ class FunctionTemplateInfo: public TemplateInfo {
   static const int kAccessCheckInfoOffset =
       kInstanceCallHandlerOffset + kPointerSize;
   static const int kFlagOffset = kAccessCheckInfoOffset + kPointerSize;
-  static const int kSize = kFlagOffset + kPointerSize;
+  static const int kFastCallFunctionOffset = kFlagOffset + kPointerSize;
+  static const int kFastCallSignatureOffset =
+      kFastCallFunctionOffset + kPointerSize;
+  static const int kSize = kFastCallSignatureOffset + kPointerSize;
+
+  // The C function is passed the receiver's first internal field (when the
+  // receiver type is FAST_CALL_EXTERNAL) followed by the arguments.
+  static const int kMaxFastCallParameters = 4;
+
+  // Layout of fast_call_signature.
+  class FastCallReturnTypeField: public BitField<FastCallType, 0, 3> {};
+  class FastCallReceiverTypeField: public BitField<FastCallType, 3, 3> {};
+  class FastCallArgumentCountField: public BitField<int, 6, 3> {};
+  static const int kFastCallArgumentTypesShift = 9;
+  static const int kFastCallArgumentTypeBits = 3;
+
+  static inline FastCallType FastCallArgumentType(int signature, int index) {
+    int shift = kFastCallArgumentTypesShift + index * kFastCallArgumentTypeBits;
+    return static_cast<FastCallType>(
+        (signature >> shift) & ((1 << kFastCallArgumentTypeBits) - 1));
+  }
 
  private:
   // Bit position in the flag, from least significant bit position.
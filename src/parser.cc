@@ -616,7 +616,11 @@ FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
 
   // Compute the parsing mode.
   Mode mode = (FLAG_lazy && allow_lazy_) ? PARSE_LAZILY : PARSE_EAGERLY;
-  if (allow_natives_syntax_ || extension_ != NULL) mode = PARSE_EAGERLY;
+  // Natives syntax forces eager parsing unless preparse data lets us skip
+  // over the function bodies, as it does for the natives scripts.
+  if ((allow_natives_syntax_ && pre_data_ == NULL) || extension_ != NULL) {
+    mode = PARSE_EAGERLY;
+  }
   ParsingModeScope parsing_mode(this, mode);
 
   Handle<String> no_name = isolate()->factory()->empty_symbol();
@@ -6021,6 +6025,29 @@ ScriptDataImpl* ParserApi::PreParse(Utf16CharacterStream* source,
 }
 
 
+ScriptDataImpl* ParserApi::PreParseInBackground(Utf16CharacterStream* source,
+                                                int flags,
+                                                uintptr_t stack_limit) {
+  // Runs without touching the isolate: the unicode cache is private to this
+  // call and stack overflow is reported by returning NULL instead of
+  // throwing.
+  if (FLAG_lazy) flags |= kAllowLazy;
+  UnicodeCache unicode_cache;
+  Scanner scanner(&unicode_cache);
+  scanner.SetHarmonyScoping(FLAG_harmony_scoping);
+  scanner.Initialize(source);
+  CompleteParserRecorder recorder;
+  preparser::PreParser::PreParseResult result =
+      preparser::PreParser::PreParseProgram(&scanner,
+                                            &recorder,
+                                            flags,
+                                            stack_limit);
+  if (result == preparser::PreParser::kPreParseStackOverflow) return NULL;
+  Vector<unsigned> store = recorder.ExtractData();
+  return new ScriptDataImpl(store);
+}
+
+
 bool RegExpParser::ParseRegExp(FlatStringReader* input,
                                bool multiline,
                                RegExpCompileData* result,
@@ -110,6 +110,15 @@ class ScriptDataImpl : public ScriptData {
   // a SanityCheck.
   ScriptDataImpl() : owns_store_(false) { }
 
+  // Returns a ScriptDataImpl reading the same store without owning it, so
+  // that several parsers can use the data at the same time. This object
+  // must outlive the view.
+  ScriptDataImpl* NewView() {
+    ScriptDataImpl* view = new ScriptDataImpl(store_);
+    view->owns_store_ = false;
+    return view;
+  }
+
   virtual ~ScriptDataImpl();
   virtual int Length();
   virtual const char* Data();
@@ -175,6 +184,13 @@ class ParserApi {
   static ScriptDataImpl* PreParse(Utf16CharacterStream* source,
                                   v8::Extension* extension,
                                   int flags);
+
+  // Preparses a program without using any isolate state, so it can run on a
+  // thread other than the one owning the isolate.  The stack limit has to be
+  // supplied by the caller.  Returns NULL on stack overflow.
+  static ScriptDataImpl* PreParseInBackground(Utf16CharacterStream* source,
+                                              int flags,
+                                              uintptr_t stack_limit);
 };
 
 // ----------------------------------------------------------------------------
@@ -93,7 +93,8 @@ void TokenEnumerator::TokenRemoved(Object** token_location) {
 
 
 StringsStorage::StringsStorage()
-    : names_(StringsMatch) {
+    : names_(StringsMatch),
+      max_stored_strings_(kMaxInt) {
 }
 
 
@@ -103,6 +104,7 @@ StringsStorage::~StringsStorage() {
        p = names_.Next(p)) {
     DeleteArray(reinterpret_cast<const char*>(p->value));
   }
+  DisposeUnstoredStrings();
 }
 
 
@@ -113,7 +115,7 @@ const char* StringsStorage::GetCopy(const char* src) {
   dst[len] = '\0';
   uint32_t hash =
       HashSequentialString(dst.start(), len, HEAP->HashSeed());
-  return AddOrDisposeString(dst.start(), hash);
+  return AddOrDisposeString(dst.start(), hash, true);
 }
 
 
@@ -126,8 +128,16 @@ const char* StringsStorage::GetFormatted(const char* format, ...) {
 }
 
 
-const char* StringsStorage::AddOrDisposeString(char* str, uint32_t hash) {
-  HashMap::Entry* cache_entry = names_.Lookup(str, hash, true);
+const char* StringsStorage::AddOrDisposeString(char* str,
+                                               uint32_t hash,
+                                               bool always_store) {
+  bool store = always_store ||
+      names_.occupancy() < static_cast<uint32_t>(max_stored_strings_);
+  HashMap::Entry* cache_entry = names_.Lookup(str, hash, store);
+  if (cache_entry == NULL) {
+    unstored_.Add(str);
+    return str;
+  }
   if (cache_entry->value == NULL) {
     // New entry added.
     cache_entry->value = str;
@@ -169,6 +179,14 @@ const char* StringsStorage::GetName(int index) {
 }
 
 
+void StringsStorage::DisposeUnstoredStrings() {
+  for (int i = 0; i < unstored_.length(); ++i) {
+    DeleteArray(unstored_[i]);
+  }
+  unstored_.Rewind(0);
+}
+
+
 size_t StringsStorage::GetUsedMemorySize() const {
   size_t size = sizeof(*this);
   size += sizeof(HashMap::Entry) * names_.capacity();
@@ -1092,16 +1110,16 @@ template <size_t ptr_size> struct SnapshotSizeConstants;
 template <> struct SnapshotSizeConstants<4> {
   static const int kExpectedHeapGraphEdgeSize = 12;
   static const int kExpectedHeapEntrySize = 24;
-  static const int kExpectedHeapSnapshotsCollectionSize = 96;
-  static const int kExpectedHeapSnapshotSize = 136;
+  static const int kExpectedHeapSnapshotsCollectionSize = 112;
+  static const int kExpectedHeapSnapshotSize = 140;
   static const size_t kMaxSerializableSnapshotRawSize = 256 * MB;
 };
 
 template <> struct SnapshotSizeConstants<8> {
   static const int kExpectedHeapGraphEdgeSize = 24;
   static const int kExpectedHeapEntrySize = 32;
-  static const int kExpectedHeapSnapshotsCollectionSize = 144;
-  static const int kExpectedHeapSnapshotSize = 168;
+  static const int kExpectedHeapSnapshotsCollectionSize = 168;
+  static const int kExpectedHeapSnapshotSize = 176;
   static const uint64_t kMaxSerializableSnapshotRawSize =
       static_cast<uint64_t>(6000) * MB;
 };
@@ -1119,7 +1137,8 @@ HeapSnapshot::HeapSnapshot(HeapSnapshotsCollection* collection,
       root_index_(HeapEntry::kNoEntry),
       gc_roots_index_(HeapEntry::kNoEntry),
       natives_root_index_(HeapEntry::kNoEntry),
-      max_snapshot_js_object_id_(0) {
+      max_snapshot_js_object_id_(0),
+      stream_writer_(NULL) {
   STATIC_CHECK(
       sizeof(HeapGraphEdge) ==
       SnapshotSizeConstants<kPointerSize>::kExpectedHeapGraphEdgeSize);
@@ -1143,50 +1162,62 @@ void HeapSnapshot::RememberLastJSObjectId() {
 }
 
 
-HeapEntry* HeapSnapshot::AddRootEntry() {
+int HeapSnapshot::AddRootEntry() {
   ASSERT(root_index_ == HeapEntry::kNoEntry);
   ASSERT(entries_.is_empty());  // Root entry must be the first one.
-  HeapEntry* entry = AddEntry(HeapEntry::kObject,
-                              "",
-                              HeapObjectsMap::kInternalRootObjectId,
-                              0);
-  root_index_ = entry->index();
+  root_index_ = AddEntry(HeapEntry::kObject,
+                         "",
+                         HeapObjectsMap::kInternalRootObjectId,
+                         0);
   ASSERT(root_index_ == 0);
-  return entry;
+  return root_index_;
 }
 
 
-HeapEntry* HeapSnapshot::AddGcRootsEntry() {
+int HeapSnapshot::AddGcRootsEntry() {
   ASSERT(gc_roots_index_ == HeapEntry::kNoEntry);
-  HeapEntry* entry = AddEntry(HeapEntry::kObject,
-                              "(GC roots)",
-                              HeapObjectsMap::kGcRootsObjectId,
-                              0);
-  gc_roots_index_ = entry->index();
-  return entry;
+  gc_roots_index_ = AddEntry(HeapEntry::kObject,
+                             "(GC roots)",
+                             HeapObjectsMap::kGcRootsObjectId,
+                             0);
+  return gc_roots_index_;
 }
 
 
-HeapEntry* HeapSnapshot::AddGcSubrootEntry(int tag) {
+int HeapSnapshot::AddGcSubrootEntry(int tag) {
   ASSERT(gc_subroot_indexes_[tag] == HeapEntry::kNoEntry);
   ASSERT(0 <= tag && tag < VisitorSynchronization::kNumberOfSyncTags);
-  HeapEntry* entry = AddEntry(
+  gc_subroot_indexes_[tag] = AddEntry(
       HeapEntry::kObject,
       VisitorSynchronization::kTagNames[tag],
       HeapObjectsMap::GetNthGcSubrootId(tag),
       0);
-  gc_subroot_indexes_[tag] = entry->index();
-  return entry;
+  return gc_subroot_indexes_[tag];
 }
 
 
-HeapEntry* HeapSnapshot::AddEntry(HeapEntry::Type type,
-                                  const char* name,
-                                  SnapshotObjectId id,
-                                  int size) {
+int HeapSnapshot::AddEntry(HeapEntry::Type type,
+                           const char* name,
+                           SnapshotObjectId id,
+                           int size) {
+  if (stream_writer_ != NULL) {
+    return stream_writer_->WriteNode(type, name, size);
+  }
   HeapEntry entry(this, type, name, id, size);
   entries_.Add(entry);
-  return &entries_.last();
+  return entries_.length() - 1;
+}
+
+
+void HeapSnapshot::TagEntry(int index, const char* tag) {
+  if (stream_writer_ != NULL) {
+    stream_writer_->TagNode(index, tag);
+    return;
+  }
+  HeapEntry* entry = &entries_[index];
+  if (entry->name()[0] == '\0') {
+    entry->set_name(tag);
+  }
 }
 
 
@@ -1644,12 +1675,14 @@ HeapObject* const V8HeapExplorer::kLastGcSubrootObject =
 
 V8HeapExplorer::V8HeapExplorer(
     HeapSnapshot* snapshot,
-    SnapshottingProgressReportingInterface* progress)
+    SnapshottingProgressReportingInterface* progress,
+    bool assign_object_ids)
     : heap_(Isolate::Current()->heap()),
       snapshot_(snapshot),
       collection_(snapshot_->collection()),
       progress_(progress),
-      filler_(NULL) {
+      filler_(NULL),
+      assign_object_ids_(assign_object_ids) {
 }
 
 
@@ -1657,21 +1690,18 @@ V8HeapExplorer::~V8HeapExplorer() {
 }
 
 
-HeapEntry* V8HeapExplorer::AllocateEntry(HeapThing ptr) {
+int V8HeapExplorer::AllocateEntry(HeapThing ptr) {
   return AddEntry(reinterpret_cast<HeapObject*>(ptr));
 }
 
 
-HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
+int V8HeapExplorer::AddEntry(HeapObject* object) {
   if (object == kInternalRootObject) {
-    snapshot_->AddRootEntry();
-    return snapshot_->root();
+    return snapshot_->AddRootEntry();
   } else if (object == kGcRootsObject) {
-    HeapEntry* entry = snapshot_->AddGcRootsEntry();
-    return entry;
+    return snapshot_->AddGcRootsEntry();
   } else if (object >= kFirstGcSubrootObject && object < kLastGcSubrootObject) {
-    HeapEntry* entry = snapshot_->AddGcSubrootEntry(GetGcSubrootOrder(object));
-    return entry;
+    return snapshot_->AddGcSubrootEntry(GetGcSubrootOrder(object));
   } else if (object->IsJSFunction()) {
     JSFunction* func = JSFunction::cast(object);
     SharedFunctionInfo* shared = func->shared();
@@ -1727,12 +1757,13 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
 }
 
 
-HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object,
-                                    HeapEntry::Type type,
-                                    const char* name) {
+int V8HeapExplorer::AddEntry(HeapObject* object,
+                             HeapEntry::Type type,
+                             const char* name) {
   int object_size = object->Size();
-  SnapshotObjectId object_id =
-    collection_->GetObjectId(object->address(), object_size);
+  SnapshotObjectId object_id = assign_object_ids_
+      ? collection_->GetObjectId(object->address(), object_size)
+      : 0;
   return snapshot_->AddEntry(type, name, object_id, object_size);
 }
 
@@ -1840,9 +1871,8 @@ class IndexedReferencesExtractor : public ObjectVisitor {
 
 
 void V8HeapExplorer::ExtractReferences(HeapObject* obj) {
-  HeapEntry* heap_entry = GetEntry(obj);
-  if (heap_entry == NULL) return;  // No interest in this object.
-  int entry = heap_entry->index();
+  int entry = GetEntry(obj);
+  if (entry == HeapEntry::kNoEntry) return;  // No interest in this object.
 
   bool extract_indexed_refs = true;
   if (obj->IsJSGlobalProxy()) {
@@ -2301,8 +2331,14 @@ String* V8HeapExplorer::GetConstructorName(JSObject* object) {
     LookupResult result(heap->isolate());
     object->LocalLookupRealNamedProperty(heap->constructor_symbol(), &result);
     if (!result.IsFound()) return object->constructor_name();
+    // A double field holds a number, so it cannot be a constructor; this
+    // also keeps GetLazyValue from allocating a copy of its box.
+    if (result.type() == FIELD &&
+        result.GetPropertyDetails().IsDoubleField()) {
+      return object->constructor_name();
+    }
 
-    constructor_prop = result.GetLazyValue();
+    constructor_prop = result.GetLazyValue()->ToObjectUnchecked();
     if (constructor_prop->IsJSFunction()) {
       Object* maybe_name =
           JSFunction::cast(constructor_prop)->shared()->name();
@@ -2316,8 +2352,8 @@ String* V8HeapExplorer::GetConstructorName(JSObject* object) {
 }
 
 
-HeapEntry* V8HeapExplorer::GetEntry(Object* obj) {
-  if (!obj->IsHeapObject()) return NULL;
+int V8HeapExplorer::GetEntry(Object* obj) {
+  if (!obj->IsHeapObject()) return HeapEntry::kNoEntry;
   return filler_->FindOrAddEntry(obj, this);
 }
 
@@ -2399,6 +2435,8 @@ bool V8HeapExplorer::IterateAndExtractReferences(
        obj = iterator.next(), progress_->ProgressStep()) {
     if (!interrupted) {
       ExtractReferences(obj);
+      // Names that were not stored have been written out by now.
+      collection_->names()->DisposeUnstoredStrings();
       if (!progress_->ProgressReport(false)) interrupted = true;
     }
   }
@@ -2439,8 +2477,8 @@ void V8HeapExplorer::SetClosureReference(HeapObject* parent_obj,
                                          int parent_entry,
                                          String* reference_name,
                                          Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     filler_->SetNamedReference(HeapGraphEdge::kContextVariable,
                                parent_entry,
                                collection_->names()->GetName(reference_name),
@@ -2453,8 +2491,8 @@ void V8HeapExplorer::SetNativeBindReference(HeapObject* parent_obj,
                                             int parent_entry,
                                             const char* reference_name,
                                             Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     filler_->SetNamedReference(HeapGraphEdge::kShortcut,
                                parent_entry,
                                reference_name,
@@ -2467,8 +2505,8 @@ void V8HeapExplorer::SetElementReference(HeapObject* parent_obj,
                                          int parent_entry,
                                          int index,
                                          Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     filler_->SetIndexedReference(HeapGraphEdge::kElement,
                                  parent_entry,
                                  index,
@@ -2482,8 +2520,8 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           const char* reference_name,
                                           Object* child_obj,
                                           int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kInternal,
                                parent_entry,
@@ -2499,8 +2537,8 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           int index,
                                           Object* child_obj,
                                           int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == NULL) return;
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kInternal,
                                parent_entry,
@@ -2515,8 +2553,8 @@ void V8HeapExplorer::SetHiddenReference(HeapObject* parent_obj,
                                         int parent_entry,
                                         int index,
                                         Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL && IsEssentialObject(child_obj)) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry && IsEssentialObject(child_obj)) {
     filler_->SetIndexedReference(HeapGraphEdge::kHidden,
                                  parent_entry,
                                  index,
@@ -2530,8 +2568,8 @@ void V8HeapExplorer::SetWeakReference(HeapObject* parent_obj,
                                       int index,
                                       Object* child_obj,
                                       int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     filler_->SetIndexedReference(HeapGraphEdge::kWeak,
                                  parent_entry,
                                  index,
@@ -2547,8 +2585,8 @@ void V8HeapExplorer::SetPropertyReference(HeapObject* parent_obj,
                                           Object* child_obj,
                                           const char* name_format_string,
                                           int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     HeapGraphEdge::Type type = reference_name->length() > 0 ?
         HeapGraphEdge::kProperty : HeapGraphEdge::kInternal;
     const char* name = name_format_string  != NULL ?
@@ -2571,8 +2609,8 @@ void V8HeapExplorer::SetPropertyShortcutReference(HeapObject* parent_obj,
                                                   int parent_entry,
                                                   String* reference_name,
                                                   Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     filler_->SetNamedReference(HeapGraphEdge::kShortcut,
                                parent_entry,
                                collection_->names()->GetName(reference_name),
@@ -2584,17 +2622,17 @@ void V8HeapExplorer::SetPropertyShortcutReference(HeapObject* parent_obj,
 void V8HeapExplorer::SetRootGcRootsReference() {
   filler_->SetIndexedAutoIndexReference(
       HeapGraphEdge::kElement,
-      snapshot_->root()->index(),
-      snapshot_->gc_roots());
+      snapshot_->root_index(),
+      snapshot_->gc_roots_index());
 }
 
 
 void V8HeapExplorer::SetUserGlobalReference(Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  ASSERT(child_entry != NULL);
+  int child_entry = GetEntry(child_obj);
+  ASSERT(child_entry != HeapEntry::kNoEntry);
   filler_->SetNamedAutoIndexReference(
       HeapGraphEdge::kShortcut,
-      snapshot_->root()->index(),
+      snapshot_->root_index(),
       child_entry);
 }
 
@@ -2602,26 +2640,26 @@ void V8HeapExplorer::SetUserGlobalReference(Object* child_obj) {
 void V8HeapExplorer::SetGcRootsReference(VisitorSynchronization::SyncTag tag) {
   filler_->SetIndexedAutoIndexReference(
       HeapGraphEdge::kElement,
-      snapshot_->gc_roots()->index(),
-      snapshot_->gc_subroot(tag));
+      snapshot_->gc_roots_index(),
+      snapshot_->gc_subroot_index(tag));
 }
 
 
 void V8HeapExplorer::SetGcSubrootReference(
     VisitorSynchronization::SyncTag tag, bool is_weak, Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != NULL) {
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry) {
     const char* name = GetStrongGcSubrootName(child_obj);
     if (name != NULL) {
       filler_->SetNamedReference(
           HeapGraphEdge::kInternal,
-          snapshot_->gc_subroot(tag)->index(),
+          snapshot_->gc_subroot_index(tag),
           name,
           child_entry);
     } else {
       filler_->SetIndexedAutoIndexReference(
           is_weak ? HeapGraphEdge::kWeak : HeapGraphEdge::kElement,
-          snapshot_->gc_subroot(tag)->index(),
+          snapshot_->gc_subroot_index(tag),
           child_entry);
     }
   }
@@ -2649,10 +2687,7 @@ const char* V8HeapExplorer::GetStrongGcSubrootName(Object* object) {
 
 void V8HeapExplorer::TagObject(Object* obj, const char* tag) {
   if (IsEssentialObject(obj)) {
-    HeapEntry* entry = GetEntry(obj);
-    if (entry->name()[0] == '\0') {
-      entry->set_name(tag);
-    }
+    snapshot_->TagEntry(GetEntry(obj), tag);
   }
 }
 
@@ -2746,7 +2781,7 @@ class BasicHeapEntriesAllocator : public HeapEntriesAllocator {
       collection_(snapshot_->collection()),
       entries_type_(entries_type) {
   }
-  virtual HeapEntry* AllocateEntry(HeapThing ptr);
+  virtual int AllocateEntry(HeapThing ptr);
  private:
   HeapSnapshot* snapshot_;
   HeapSnapshotsCollection* collection_;
@@ -2754,7 +2789,7 @@ class BasicHeapEntriesAllocator : public HeapEntriesAllocator {
 };
 
 
-HeapEntry* BasicHeapEntriesAllocator::AllocateEntry(HeapThing ptr) {
+int BasicHeapEntriesAllocator::AllocateEntry(HeapThing ptr) {
   v8::RetainedObjectInfo* info = reinterpret_cast<v8::RetainedObjectInfo*>(ptr);
   intptr_t elements = info->GetElementCount();
   intptr_t size = info->GetSizeInBytes();
@@ -2848,12 +2883,12 @@ void NativeObjectsExplorer::FillImplicitReferences() {
     ImplicitRefGroup* group = groups->at(i);
     HeapObject* parent = *group->parent_;
     int parent_entry =
-        filler_->FindOrAddEntry(parent, native_entries_allocator_)->index();
+        filler_->FindOrAddEntry(parent, native_entries_allocator_);
     ASSERT(parent_entry != HeapEntry::kNoEntry);
     Object*** children = group->children_;
     for (size_t j = 0; j < group->length_; ++j) {
       Object* child = *children[j];
-      HeapEntry* child_entry =
+      int child_entry =
           filler_->FindOrAddEntry(child, native_entries_allocator_);
       filler_->SetNamedReference(
           HeapGraphEdge::kInternal,
@@ -2946,33 +2981,33 @@ NativeGroupRetainedObjectInfo* NativeObjectsExplorer::FindOrAddGroupInfo(
 
 void NativeObjectsExplorer::SetNativeRootReference(
     v8::RetainedObjectInfo* info) {
-  HeapEntry* child_entry =
+  int child_entry =
       filler_->FindOrAddEntry(info, native_entries_allocator_);
-  ASSERT(child_entry != NULL);
+  ASSERT(child_entry != HeapEntry::kNoEntry);
   NativeGroupRetainedObjectInfo* group_info =
       FindOrAddGroupInfo(info->GetGroupLabel());
-  HeapEntry* group_entry =
+  int group_entry =
       filler_->FindOrAddEntry(group_info, synthetic_entries_allocator_);
   filler_->SetNamedAutoIndexReference(
       HeapGraphEdge::kInternal,
-      group_entry->index(),
+      group_entry,
       child_entry);
 }
 
 
 void NativeObjectsExplorer::SetWrapperNativeReferences(
     HeapObject* wrapper, v8::RetainedObjectInfo* info) {
-  HeapEntry* wrapper_entry = filler_->FindEntry(wrapper);
-  ASSERT(wrapper_entry != NULL);
-  HeapEntry* info_entry =
+  int wrapper_entry = filler_->FindEntry(wrapper);
+  ASSERT(wrapper_entry != HeapEntry::kNoEntry);
+  int info_entry =
       filler_->FindOrAddEntry(info, native_entries_allocator_);
-  ASSERT(info_entry != NULL);
+  ASSERT(info_entry != HeapEntry::kNoEntry);
   filler_->SetNamedReference(HeapGraphEdge::kInternal,
-                             wrapper_entry->index(),
+                             wrapper_entry,
                              "native",
                              info_entry);
   filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement,
-                                        info_entry->index(),
+                                        info_entry,
                                         wrapper_entry);
 }
 
@@ -2983,12 +3018,12 @@ void NativeObjectsExplorer::SetRootNativeRootsReference() {
        entry = native_groups_.Next(entry)) {
     NativeGroupRetainedObjectInfo* group_info =
         static_cast<NativeGroupRetainedObjectInfo*>(entry->value);
-    HeapEntry* group_entry =
+    int group_entry =
         filler_->FindOrAddEntry(group_info, native_entries_allocator_);
-    ASSERT(group_entry != NULL);
+    ASSERT(group_entry != HeapEntry::kNoEntry);
     filler_->SetIndexedAutoIndexReference(
         HeapGraphEdge::kElement,
-        snapshot_->root()->index(),
+        snapshot_->root_index(),
         group_entry);
   }
 }
@@ -3010,44 +3045,47 @@ class SnapshotFiller : public SnapshotFillerInterface {
       : snapshot_(snapshot),
         collection_(snapshot->collection()),
         entries_(entries) { }
-  HeapEntry* AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
-    HeapEntry* entry = allocator->AllocateEntry(ptr);
-    entries_->Pair(ptr, entry->index());
-    return entry;
+  int AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    int index = allocator->AllocateEntry(ptr);
+    entries_->Pair(ptr, index);
+    return index;
   }
-  HeapEntry* FindEntry(HeapThing ptr) {
-    int index = entries_->Map(ptr);
-    return index != HeapEntry::kNoEntry ? &snapshot_->entries()[index] : NULL;
+  int FindEntry(HeapThing ptr) {
+    return entries_->Map(ptr);
   }
-  HeapEntry* FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
-    HeapEntry* entry = FindEntry(ptr);
-    return entry != NULL ? entry : AddEntry(ptr, allocator);
+  int FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    int index = FindEntry(ptr);
+    return index != HeapEntry::kNoEntry ? index : AddEntry(ptr, allocator);
   }
   void SetIndexedReference(HeapGraphEdge::Type type,
                            int parent,
                            int index,
-                           HeapEntry* child_entry) {
+                           int child) {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
+    HeapEntry* child_entry = &snapshot_->entries()[child];
     parent_entry->SetIndexedReference(type, index, child_entry);
   }
   void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
                                     int parent,
-                                    HeapEntry* child_entry) {
+                                    int child) {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
+    HeapEntry* child_entry = &snapshot_->entries()[child];
     int index = parent_entry->children_count() + 1;
     parent_entry->SetIndexedReference(type, index, child_entry);
   }
   void SetNamedReference(HeapGraphEdge::Type type,
                          int parent,
                          const char* reference_name,
-                         HeapEntry* child_entry) {
+                         int child) {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
+    HeapEntry* child_entry = &snapshot_->entries()[child];
     parent_entry->SetNamedReference(type, reference_name, child_entry);
   }
   void SetNamedAutoIndexReference(HeapGraphEdge::Type type,
                                   int parent,
-                                  HeapEntry* child_entry) {
+                                  int child) {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
+    HeapEntry* child_entry = &snapshot_->entries()[child];
     int index = parent_entry->children_count() + 1;
     parent_entry->SetNamedReference(
         type,
@@ -3062,11 +3100,51 @@ class SnapshotFiller : public SnapshotFillerInterface {
 };
 
 
-HeapSnapshotGenerator::HeapSnapshotGenerator(HeapSnapshot* snapshot,
-                                             v8::ActivityControl* control)
+// Writes edges out instead of adding them to the snapshot.
+class StreamingSnapshotFiller : public SnapshotFiller {
+ public:
+  StreamingSnapshotFiller(HeapSnapshot* snapshot, HeapEntriesMap* entries)
+      : SnapshotFiller(snapshot, entries),
+        collection_(snapshot->collection()),
+        writer_(snapshot->stream_writer()) { }
+  void SetIndexedReference(HeapGraphEdge::Type type,
+                           int parent,
+                           int index,
+                           int child) {
+    writer_->WriteEdge(type, parent, child, index);
+  }
+  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
+                                    int parent,
+                                    int child) {
+    int index = writer_->edges_count(parent) + 1;
+    writer_->WriteEdge(type, parent, child, index);
+  }
+  void SetNamedReference(HeapGraphEdge::Type type,
+                         int parent,
+                         const char* reference_name,
+                         int child) {
+    writer_->WriteEdge(type, parent, child, reference_name);
+  }
+  void SetNamedAutoIndexReference(HeapGraphEdge::Type type,
+                                  int parent,
+                                  int child) {
+    int index = writer_->edges_count(parent) + 1;
+    writer_->WriteEdge(
+        type, parent, child, collection_->names()->GetName(index));
+  }
+
+ private:
+  HeapSnapshotsCollection* collection_;
+  HeapSnapshotStreamWriter* writer_;
+};
+
+
+HeapSnapshotGenerator::HeapSnapshotGenerator(
+    HeapSnapshot* snapshot,
+    v8::ActivityControl* control)
     : snapshot_(snapshot),
       control_(control),
-      v8_heap_explorer_(snapshot_, this),
+      v8_heap_explorer_(snapshot_, this, snapshot->stream_writer() == NULL),
       dom_explorer_(snapshot_, this) {
 }
 
@@ -3110,8 +3188,14 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   if (!FillReferences()) return false;
 
-  snapshot_->FillChildren();
-  snapshot_->RememberLastJSObjectId();
+  HeapSnapshotStreamWriter* stream_writer = snapshot_->stream_writer();
+  if (stream_writer != NULL) {
+    stream_writer->Finalize();
+    if (stream_writer->aborted()) return false;
+  } else {
+    snapshot_->FillChildren();
+    snapshot_->RememberLastJSObjectId();
+  }
 
   progress_counter_ = progress_total_;
   if (!ProgressReport(true)) return false;
@@ -3126,6 +3210,8 @@ void HeapSnapshotGenerator::ProgressStep() {
 
 bool HeapSnapshotGenerator::ProgressReport(bool force) {
   const int kProgressReportGranularity = 10000;
+  HeapSnapshotStreamWriter* stream_writer = snapshot_->stream_writer();
+  if (stream_writer != NULL && stream_writer->aborted()) return false;
   if (control_ != NULL
       && (force || progress_counter_ % kProgressReportGranularity == 0)) {
       return
@@ -3147,10 +3233,13 @@ void HeapSnapshotGenerator::SetProgressTotal(int iterations_count) {
 
 
 bool HeapSnapshotGenerator::FillReferences() {
-  SnapshotFiller filler(snapshot_, &entries_);
-  v8_heap_explorer_.AddRootEntries(&filler);
-  return v8_heap_explorer_.IterateAndExtractReferences(&filler)
-      && dom_explorer_.IterateAndExtractReferences(&filler);
+  SnapshotFiller snapshot_filler(snapshot_, &entries_);
+  StreamingSnapshotFiller streaming_filler(snapshot_, &entries_);
+  SnapshotFillerInterface* filler = &snapshot_filler;
+  if (snapshot_->stream_writer() != NULL) filler = &streaming_filler;
+  v8_heap_explorer_.AddRootEntries(filler);
+  return v8_heap_explorer_.IterateAndExtractReferences(filler)
+      && dom_explorer_.IterateAndExtractReferences(filler);
 }
 
 
@@ -3291,8 +3380,9 @@ HeapSnapshot* HeapSnapshotJSONSerializer::CreateFakeSnapshot() {
       "Actual snapshot size is %"  V8_PTR_PREFIX "u MB.",
       SnapshotSizeConstants<kPointerSize>::kMaxSerializableSnapshotRawSize / MB,
       (snapshot_->RawSnapshotSize() + MB - 1) / MB);
-  HeapEntry* message = result->AddEntry(HeapEntry::kString, text, 0, 4);
-  result->root()->SetIndexedReference(HeapGraphEdge::kElement, 1, message);
+  int message = result->AddEntry(HeapEntry::kString, text, 0, 4);
+  result->root()->SetIndexedReference(
+      HeapGraphEdge::kElement, 1, &result->entries()[message]);
   result->FillChildren();
   return result;
 }
@@ -3490,53 +3580,59 @@ static void WriteUChar(OutputStreamWriter* w, unibrow::uchar u) {
   w->AddCharacter(hex_chars[u & 0xf]);
 }
 
-void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
-  writer_->AddCharacter('\n');
-  writer_->AddCharacter('\"');
+static void WriteJSONString(OutputStreamWriter* writer,
+                            const unsigned char* s) {
+  writer->AddCharacter('\"');
   for ( ; *s != '\0'; ++s) {
     switch (*s) {
       case '\b':
-        writer_->AddString("\\b");
+        writer->AddString("\\b");
         continue;
       case '\f':
-        writer_->AddString("\\f");
+        writer->AddString("\\f");
         continue;
       case '\n':
-        writer_->AddString("\\n");
+        writer->AddString("\\n");
         continue;
       case '\r':
-        writer_->AddString("\\r");
+        writer->AddString("\\r");
         continue;
       case '\t':
-        writer_->AddString("\\t");
+        writer->AddString("\\t");
         continue;
       case '\"':
       case '\\':
-        writer_->AddCharacter('\\');
-        writer_->AddCharacter(*s);
+        writer->AddCharacter('\\');
+        writer->AddCharacter(*s);
         continue;
       default:
         if (*s > 31 && *s < 128) {
-          writer_->AddCharacter(*s);
+          writer->AddCharacter(*s);
         } else if (*s <= 31) {
           // Special character with no dedicated literal.
-          WriteUChar(writer_, *s);
+          WriteUChar(writer, *s);
         } else {
           // Convert UTF-8 into \u UTF-16 literal.
           unsigned length = 1, cursor = 0;
           for ( ; length <= 4 && *(s + length) != '\0'; ++length) { }
           unibrow::uchar c = unibrow::Utf8::CalculateValue(s, length, &cursor);
           if (c != unibrow::Utf8::kBadChar) {
-            WriteUChar(writer_, c);
+            WriteUChar(writer, c);
             ASSERT(cursor != 0);
             s += cursor - 1;
           } else {
-            writer_->AddCharacter('?');
+            writer->AddCharacter('?');
           }
         }
     }
   }
-  writer_->AddCharacter('\"');
+  writer->AddCharacter('\"');
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
+  writer_->AddCharacter('\n');
+  WriteJSONString(writer_, s);
 }
 
 
@@ -3574,4 +3670,136 @@ void HeapSnapshotJSONSerializer::SortHashMap(
   sorted_entries->Sort(SortUsingEntryValue);
 }
 
+
+HeapSnapshotStreamWriter::HeapSnapshotStreamWriter(v8::OutputStream* stream)
+    : strings_(StringsMatch),
+      next_string_id_(1),
+      writer_(new OutputStreamWriter(stream)) {
+}
+
+
+HeapSnapshotStreamWriter::~HeapSnapshotStreamWriter() {
+  for (HashMap::Entry* p = strings_.Start();
+       p != NULL;
+       p = strings_.Next(p)) {
+    DeleteArray(reinterpret_cast<char*>(p->key));
+  }
+  delete writer_;
+}
+
+
+bool HeapSnapshotStreamWriter::aborted() {
+  return writer_->aborted();
+}
+
+
+int HeapSnapshotStreamWriter::GetStringId(const char* s) {
+  int length = StrLength(s);
+  uint32_t hash = HashSequentialString(s, length, HEAP->HashSeed());
+  HashMap::Entry* cache_entry =
+      strings_.Lookup(const_cast<char*>(s), hash, false);
+  if (cache_entry != NULL) {
+    return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+  }
+  if (strings_.occupancy() >= static_cast<uint32_t>(kMaxStringTableSize)) {
+    return 0;
+  }
+  Vector<char> copy = Vector<char>::New(length + 1);
+  OS::StrNCpy(copy, s, length);
+  copy[length] = '\0';
+  int id = next_string_id_++;
+  cache_entry = strings_.Lookup(copy.start(), hash, true);
+  cache_entry->value = reinterpret_cast<void*>(id);
+  writer_->AddString("[\"s\",");
+  writer_->AddNumber(id);
+  writer_->AddCharacter(',');
+  WriteJSONString(writer_, reinterpret_cast<const unsigned char*>(s));
+  writer_->AddString("]\n");
+  return id;
+}
+
+
+void HeapSnapshotStreamWriter::WriteName(const char* s, int string_id) {
+  if (string_id != 0) {
+    writer_->AddNumber(string_id);
+  } else {
+    WriteJSONString(writer_, reinterpret_cast<const unsigned char*>(s));
+  }
+}
+
+
+int HeapSnapshotStreamWriter::WriteNode(HeapEntry::Type type,
+                                        const char* name,
+                                        int self_size) {
+  int index = nodes_.length();
+  nodes_.Add(name[0] != '\0' ? kNamedNodeBit : 0);
+  int name_id = GetStringId(name);
+  writer_->AddString("[\"n\",");
+  writer_->AddNumber(index);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(type);
+  writer_->AddCharacter(',');
+  WriteName(name, name_id);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(self_size);
+  writer_->AddString("]\n");
+  return index;
+}
+
+
+void HeapSnapshotStreamWriter::TagNode(int index, const char* tag) {
+  if ((nodes_[index] & kNamedNodeBit) != 0) return;
+  nodes_[index] |= kNamedNodeBit;
+  int tag_id = GetStringId(tag);
+  writer_->AddString("[\"t\",");
+  writer_->AddNumber(index);
+  writer_->AddCharacter(',');
+  WriteName(tag, tag_id);
+  writer_->AddString("]\n");
+}
+
+
+void HeapSnapshotStreamWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         int from,
+                                         int to,
+                                         int index) {
+  ASSERT(type == HeapGraphEdge::kElement
+      || type == HeapGraphEdge::kHidden
+      || type == HeapGraphEdge::kWeak);
+  CountEdge(from);
+  writer_->AddString("[\"e\",");
+  writer_->AddNumber(type);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(from);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(to);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(index);
+  writer_->AddString("]\n");
+}
+
+
+void HeapSnapshotStreamWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         int from,
+                                         int to,
+                                         const char* name) {
+  CountEdge(from);
+  int name_id = GetStringId(name);
+  writer_->AddString("[\"e\",");
+  writer_->AddNumber(type);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(from);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(to);
+  writer_->AddCharacter(',');
+  WriteName(name, name_id);
+  writer_->AddString("]\n");
+}
+
+
+void HeapSnapshotStreamWriter::Finalize() {
+  writer_->Finalize();
+}
+
+
 } }  // namespace v8::internal
@@ -74,6 +74,11 @@ class StringsStorage {
   inline const char* GetFunctionName(const char* name);
   size_t GetUsedMemorySize() const;
 
+  // Once |count| strings are stored, strings not stored yet are only kept
+  // until the next DisposeUnstoredStrings call. GetCopy always stores.
+  void set_max_stored_strings(int count) { max_stored_strings_ = count; }
+  void DisposeUnstoredStrings();
+
  private:
   static const int kMaxNameSize = 1024;
 
@@ -81,10 +86,14 @@ class StringsStorage {
     return strcmp(reinterpret_cast<char*>(key1),
                   reinterpret_cast<char*>(key2)) == 0;
   }
-  const char* AddOrDisposeString(char* str, uint32_t hash);
+  const char* AddOrDisposeString(char* str,
+                                 uint32_t hash,
+                                 bool always_store = false);
 
   // Mapping of strings by String::Hash to const char* strings.
   HashMap names_;
+  int max_stored_strings_;
+  List<char*> unstored_;
 
   DISALLOW_COPY_AND_ASSIGN(StringsStorage);
 };
@@ -564,6 +573,7 @@ class HeapEntry BASE_EMBEDDED {
 
 
 class HeapSnapshotsCollection;
+class HeapSnapshotStreamWriter;
 
 // HeapSnapshot represents a single heap snapshot. It is stored in
 // HeapSnapshotsCollection, which is also a factory for
@@ -587,6 +597,15 @@ class HeapSnapshot {
   const char* title() { return title_; }
   unsigned uid() { return uid_; }
   size_t RawSnapshotSize() const;
+  // When a stream writer is set, entries are written to it as they are
+  // added instead of being stored in entries().
+  HeapSnapshotStreamWriter* stream_writer() { return stream_writer_; }
+  void set_stream_writer(HeapSnapshotStreamWriter* writer) {
+    stream_writer_ = writer;
+  }
+  int root_index() { return root_index_; }
+  int gc_roots_index() { return gc_roots_index_; }
+  int gc_subroot_index(int index) { return gc_subroot_indexes_[index]; }
   HeapEntry* root() { return &entries_[root_index_]; }
   HeapEntry* gc_roots() { return &entries_[gc_roots_index_]; }
   HeapEntry* natives_root() { return &entries_[natives_root_index_]; }
@@ -601,14 +620,17 @@ class HeapSnapshot {
     return max_snapshot_js_object_id_;
   }
 
-  HeapEntry* AddEntry(HeapEntry::Type type,
-                      const char* name,
-                      SnapshotObjectId id,
-                      int size);
-  HeapEntry* AddRootEntry();
-  HeapEntry* AddGcRootsEntry();
-  HeapEntry* AddGcSubrootEntry(int tag);
-  HeapEntry* AddNativesRootEntry();
+  // These return the index of the new entry.
+  int AddEntry(HeapEntry::Type type,
+               const char* name,
+               SnapshotObjectId id,
+               int size);
+  int AddRootEntry();
+  int AddGcRootsEntry();
+  int AddGcSubrootEntry(int tag);
+  int AddNativesRootEntry();
+  // Names the entry by |tag| unless it already has a name.
+  void TagEntry(int index, const char* tag);
   HeapEntry* GetEntryById(SnapshotObjectId id);
   List<HeapEntry*>* GetSortedEntriesList();
   void FillChildren();
@@ -630,6 +652,7 @@ class HeapSnapshot {
   List<HeapGraphEdge*> children_;
   List<HeapEntry*> sorted_entries_;
   SnapshotObjectId max_snapshot_js_object_id_;
+  HeapSnapshotStreamWriter* stream_writer_;
 
   friend class HeapSnapshotTester;
 
@@ -765,7 +788,7 @@ typedef void* HeapThing;
 class HeapEntriesAllocator {
  public:
   virtual ~HeapEntriesAllocator() { }
-  virtual HeapEntry* AllocateEntry(HeapThing ptr) = 0;
+  virtual int AllocateEntry(HeapThing ptr) = 0;
 };
 
 
@@ -814,28 +837,29 @@ class HeapObjectsSet {
 
 
 // An interface used to populate a snapshot with nodes and edges.
+// Entries are referred to by their indexes in the snapshot; FindEntry
+// returns HeapEntry::kNoEntry for things that have no entry.
 class SnapshotFillerInterface {
  public:
   virtual ~SnapshotFillerInterface() { }
-  virtual HeapEntry* AddEntry(HeapThing ptr,
-                              HeapEntriesAllocator* allocator) = 0;
-  virtual HeapEntry* FindEntry(HeapThing ptr) = 0;
-  virtual HeapEntry* FindOrAddEntry(HeapThing ptr,
-                                    HeapEntriesAllocator* allocator) = 0;
+  virtual int AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) = 0;
+  virtual int FindEntry(HeapThing ptr) = 0;
+  virtual int FindOrAddEntry(HeapThing ptr,
+                             HeapEntriesAllocator* allocator) = 0;
   virtual void SetIndexedReference(HeapGraphEdge::Type type,
                                    int parent_entry,
                                    int index,
-                                   HeapEntry* child_entry) = 0;
+                                   int child_entry) = 0;
   virtual void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
                                             int parent_entry,
-                                            HeapEntry* child_entry) = 0;
+                                            int child_entry) = 0;
   virtual void SetNamedReference(HeapGraphEdge::Type type,
                                  int parent_entry,
                                  const char* reference_name,
-                                 HeapEntry* child_entry) = 0;
+                                 int child_entry) = 0;
   virtual void SetNamedAutoIndexReference(HeapGraphEdge::Type type,
                                           int parent_entry,
-                                          HeapEntry* child_entry) = 0;
+                                          int child_entry) = 0;
 };
 
 
@@ -850,10 +874,13 @@ class SnapshottingProgressReportingInterface {
 // An implementation of V8 heap graph extractor.
 class V8HeapExplorer : public HeapEntriesAllocator {
  public:
+  // When |assign_object_ids| is false, entries get no ids and the
+  // collection's HeapObjectsMap is left untouched.
   V8HeapExplorer(HeapSnapshot* snapshot,
-                 SnapshottingProgressReportingInterface* progress);
+                 SnapshottingProgressReportingInterface* progress,
+                 bool assign_object_ids = true);
   virtual ~V8HeapExplorer();
-  virtual HeapEntry* AllocateEntry(HeapThing ptr);
+  virtual int AllocateEntry(HeapThing ptr);
   void AddRootEntries(SnapshotFillerInterface* filler);
   int EstimateObjectsCount(HeapIterator* iterator);
   bool IterateAndExtractReferences(SnapshotFillerInterface* filler);
@@ -864,10 +891,8 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   static HeapObject* const kInternalRootObject;
 
  private:
-  HeapEntry* AddEntry(HeapObject* object);
-  HeapEntry* AddEntry(HeapObject* object,
-                      HeapEntry::Type type,
-                      const char* name);
+  int AddEntry(HeapObject* object);
+  int AddEntry(HeapObject* object, HeapEntry::Type type, const char* name);
   const char* GetSystemEntryName(HeapObject* object);
 
   void ExtractReferences(HeapObject* obj);
@@ -937,7 +962,7 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   const char* GetStrongGcSubrootName(Object* object);
   void TagObject(Object* obj, const char* tag);
 
-  HeapEntry* GetEntry(Object* obj);
+  int GetEntry(Object* obj);
 
   static inline HeapObject* GetNthGcSubrootObject(int delta);
   static inline int GetGcSubrootOrder(HeapObject* subroot);
@@ -947,6 +972,7 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   HeapSnapshotsCollection* collection_;
   SnapshottingProgressReportingInterface* progress_;
   SnapshotFillerInterface* filler_;
+  bool assign_object_ids_;
   HeapObjectsSet objects_tags_;
   HeapObjectsSet strong_gc_subroot_names_;
 
@@ -1024,6 +1050,8 @@ class NativeObjectsExplorer {
 
 class HeapSnapshotGenerator : public SnapshottingProgressReportingInterface {
  public:
+  // If the snapshot has a stream writer, nodes and edges are written to it
+  // as they are discovered and never stored in the snapshot.
   HeapSnapshotGenerator(HeapSnapshot* snapshot,
                         v8::ActivityControl* control);
   bool GenerateSnapshot();
@@ -1099,6 +1127,55 @@ class HeapSnapshotJSONSerializer {
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotJSONSerializer);
 };
 
+
+// Writes a snapshot in the line oriented format described at
+// v8::HeapProfiler::StreamSnapshot while the heap is traversed. For each
+// node only the number of its edges and whether it has a name is kept.
+// Names are replaced by ids from a string table of bounded size; once it
+// is full, new names are written inline and not kept.
+class HeapSnapshotStreamWriter {
+ public:
+  explicit HeapSnapshotStreamWriter(v8::OutputStream* stream);
+  ~HeapSnapshotStreamWriter();
+
+  bool aborted();
+  // Returns the index of the new node.
+  int WriteNode(HeapEntry::Type type, const char* name, int self_size);
+  // Names node |index| by |tag| unless it already has a name.
+  void TagNode(int index, const char* tag);
+  void WriteEdge(HeapGraphEdge::Type type, int from, int to, int index);
+  void WriteEdge(HeapGraphEdge::Type type, int from, int to,
+                 const char* name);
+  int edges_count(int node) { return nodes_[node] >> kEdgesCountShift; }
+  void Finalize();
+
+  static const int kMaxStringTableSize = 64 * KB;
+
+ private:
+  INLINE(static bool StringsMatch(void* key1, void* key2)) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  // Returns 0 for strings that are not in the table once it is full.
+  int GetStringId(const char* s);
+  void WriteName(const char* s, int string_id);
+  void CountEdge(int from) { nodes_[from] += 1 << kEdgesCountShift; }
+
+  static const int kNamedNodeBit = 1;
+  static const int kEdgesCountShift = 1;
+
+  // Strings are copied into the table, as names that were not stored
+  // may be disposed of as soon as they are written.
+  HashMap strings_;
+  int next_string_id_;
+  // Edges count and named bit of each node.
+  List<int> nodes_;
+  OutputStreamWriter* writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStreamWriter);
+};
+
 } }  // namespace v8::internal
 
 #endif  // V8_PROFILE_GENERATOR_H_
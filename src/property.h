@@ -64,9 +64,15 @@ class Descriptor BASE_EMBEDDED {
   void Print(FILE* out);
 #endif
 
+  void SetDoubleField() {
+    details_ = details_.AsDoubleField();
+  }
+
   void SetEnumerationIndex(int index) {
     ASSERT(PropertyDetails::IsValidIndex(index));
+    bool is_double_field = details_.IsDoubleField();
     details_ = PropertyDetails(details_.attributes(), details_.type(), index);
+    if (is_double_field) details_ = details_.AsDoubleField();
   }
 
  private:
@@ -274,10 +280,13 @@ class LookupResult BASE_EMBEDDED {
   bool IsCacheable() { return cacheable_; }
   void DisallowCaching() { cacheable_ = false; }
 
-  Object* GetLazyValue() {
+  // A double field's box is mutable and is copied, as by
+  // JSObject::FastPropertyValueAt, so that only the holder can see it.
+  MUST_USE_RESULT MaybeObject* GetLazyValue() {
     switch (type()) {
       case FIELD:
-        return holder()->FastPropertyAt(GetFieldIndex());
+        return holder()->FastPropertyValueAt(GetFieldIndex(),
+                                             GetPropertyDetails());
       case NORMAL: {
         Object* value;
         value = holder()->property_dictionary()->ValueAt(GetDictionaryEntry());
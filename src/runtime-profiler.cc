@@ -30,6 +30,7 @@
 #include "runtime-profiler.h"
 
 #include "assembler.h"
+#include "char-predicates-inl.h"
 #include "code-stubs.h"
 #include "compilation-cache.h"
 #include "deoptimizer.h"
@@ -78,6 +79,12 @@ static const int kTicksWhenNotEnoughTypeInfo = 100;
 STATIC_ASSERT(kProfilerTicksBeforeOptimization < 256);
 STATIC_ASSERT(kProfilerTicksBeforeReenablingOptimization < 256);
 STATIC_ASSERT(kTicksWhenNotEnoughTypeInfo < 256);
+// Each deoptimization for the reason the function deoptimized most often for
+// doubles the number of ticks needed before the function is optimized again,
+// up to this many doublings.
+static const int kMaxDeoptBackoffShift = 6;
+STATIC_ASSERT((kProfilerTicksBeforeOptimization << kMaxDeoptBackoffShift) <
+              256);
 
 
 // Maximum size in bytes of generated code for a function to be optimized
@@ -138,8 +145,220 @@ static void GetICCounts(JSFunction* function,
 }
 
 
+// Fills in the profile entry of a function.  Returns false if the source of
+// the function is not available without allocating.
+static bool ComputeProfileEntry(SharedFunctionInfo* shared,
+                                OptimizationProfileEntry* entry) {
+  if (!shared->script()->IsScript()) return false;
+  Object* source = Script::cast(shared->script())->source();
+  if (!source->IsString() || !String::cast(source)->IsFlat()) return false;
+  int start = shared->start_position();
+  int length = shared->end_position() - start;
+  if (start < 0 || length < 0 ||
+      start + length > String::cast(source)->length()) {
+    return false;
+  }
+  // Use a fixed seed, the hash has to be the same in every process.
+  const uint32_t kSeed = 0;
+  AssertNoAllocation no_allocation;
+  String::FlatContent content = String::cast(source)->GetFlatContent();
+  if (content.IsAscii()) {
+    entry->source_hash = HashSequentialString(
+        content.ToAsciiVector().start() + start, length, kSeed);
+  } else {
+    entry->source_hash = HashSequentialString(
+        content.ToUC16Vector().start() + start, length, kSeed);
+  }
+  entry->start_position = start;
+  return true;
+}
+
+
+// Longer start positions in a loaded profile could overflow.
+static const int kMaxPositionDigits = 9;
+
+
+static int CompareProfileEntries(const OptimizationProfileEntry* a,
+                                 const OptimizationProfileEntry* b) {
+  if (a->source_hash != b->source_hash) {
+    return a->source_hash < b->source_hash ? -1 : 1;
+  }
+  return a->start_position - b->start_position;
+}
+
+
+// Returns the index of the first of the sorted entries that is not less than
+// the given one.
+static int LowerBoundProfileEntry(const List<OptimizationProfileEntry>& entries,
+                                  const OptimizationProfileEntry& entry) {
+  int low = 0;
+  int high = entries.length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (CompareProfileEntries(&entries[mid], &entry) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+
+static bool ContainsProfileEntry(const List<OptimizationProfileEntry>& entries,
+                                 const OptimizationProfileEntry& entry) {
+  int index = LowerBoundProfileEntry(entries, entry);
+  return index < entries.length() &&
+      CompareProfileEntries(&entries[index], &entry) == 0;
+}
+
+
+bool RuntimeProfiler::IsInLoadedProfile(SharedFunctionInfo* shared) {
+  if (loaded_profile_.is_empty()) return false;
+  if (shared->optimization_profile_checked()) return false;
+  shared->set_optimization_profile_checked(true);
+  OptimizationProfileEntry entry;
+  if (!ComputeProfileEntry(shared, &entry)) return false;
+  if (!ContainsProfileEntry(loaded_profile_, entry)) return false;
+  // Exported profiles include the loaded entries anyway.
+  shared->set_in_optimization_profile(true);
+  return true;
+}
+
+
+void RuntimeProfiler::AddToOptimizationProfile(SharedFunctionInfo* shared) {
+  if (shared->in_optimization_profile()) return;
+  OptimizationProfileEntry entry;
+  if (!ComputeProfileEntry(shared, &entry)) return;
+  shared->set_in_optimization_profile(true);
+  // Functions compiled again get a new shared function info, keep a single
+  // entry for them.
+  int index = LowerBoundProfileEntry(optimized_functions_, entry);
+  if (index == optimized_functions_.length() ||
+      CompareProfileEntries(&optimized_functions_[index], &entry) != 0) {
+    optimized_functions_.InsertAt(index, entry);
+  }
+}
+
+
+Handle<String> RuntimeProfiler::GetOptimizationProfile() {
+  List<OptimizationProfileEntry> entries(
+      loaded_profile_.length() + optimized_functions_.length());
+  entries.AddAll(loaded_profile_);
+  entries.AddAll(optimized_functions_);
+  entries.Sort(&CompareProfileEntries);
+
+  // One line per function: "<source hash in hex> <start position>".
+  const int kMaxLineLength = 32;
+  ScopedVector<char> buffer(entries.length() * kMaxLineLength + 1);
+  int position = 0;
+  for (int i = 0; i < entries.length(); i++) {
+    if (i > 0 && CompareProfileEntries(&entries[i], &entries[i - 1]) == 0) {
+      continue;
+    }
+    position += OS::SNPrintF(buffer.SubVector(position, buffer.length()),
+                             "%08x %d\n",
+                             entries[i].source_hash,
+                             entries[i].start_position);
+  }
+  return isolate_->factory()->NewStringFromAscii(
+      Vector<const char>(buffer.start(), position));
+}
+
+
+bool RuntimeProfiler::LoadOptimizationProfile(Handle<String> profile) {
+  List<OptimizationProfileEntry> entries;
+  FlattenString(profile);
+  {
+    AssertNoAllocation no_allocation;
+    String::FlatContent content = profile->GetFlatContent();
+    if (!content.IsAscii()) return false;
+    Vector<const char> chars = content.ToAsciiVector();
+    int i = 0;
+    while (i < chars.length()) {
+      OptimizationProfileEntry entry = { 0, 0 };
+      int digits = 0;
+      for (; i < chars.length() && IsHexDigit(chars[i]); i++, digits++) {
+        int value = IsDecimalDigit(chars[i])
+            ? chars[i] - '0'
+            : AsciiAlphaToLower(chars[i]) - 'a' + 10;
+        entry.source_hash = (entry.source_hash << 4) | value;
+      }
+      if (digits == 0 || digits > 8) return false;
+      if (i == chars.length() || chars[i++] != ' ') return false;
+      digits = 0;
+      for (; i < chars.length() && IsDecimalDigit(chars[i]); i++, digits++) {
+        entry.start_position = entry.start_position * 10 + (chars[i] - '0');
+      }
+      if (digits == 0 || digits > kMaxPositionDigits) return false;
+      if (i == chars.length() || chars[i++] != '\n') return false;
+      entries.Add(entry);
+    }
+  }
+  entries.Sort(&CompareProfileEntries);
+  loaded_profile_.Clear();
+  loaded_profile_.AddAll(entries);
+  return true;
+}
+
+
+void RuntimeProfiler::RecordDeoptimization(SharedFunctionInfo* shared,
+                                           int bailout_type,
+                                           int ast_id) {
+  ASSERT(bailout_type >= 0 &&
+         bailout_type < DeoptimizationStatistics::kBailoutTypeCount);
+  OptimizationProfileEntry function;
+  if (!ComputeProfileEntry(shared, &function)) {
+    // Without a key every deoptimization counts as the same reason.
+    shared->set_deopt_backoff(Min(shared->deopt_backoff() + 1,
+                                  SharedFunctionInfo::DeoptBackoffBits::kMax));
+    return;
+  }
+
+  int reason_count = 1;
+  for (int i = 0; i < deoptimization_reasons_.length(); i++) {
+    DeoptimizationReasonCount* reason = &deoptimization_reasons_[i];
+    if (reason->bailout_type == bailout_type &&
+        reason->ast_id == ast_id &&
+        CompareProfileEntries(&reason->function, &function) == 0) {
+      reason_count = ++reason->count;
+      break;
+    }
+  }
+  if (reason_count == 1) {
+    DeoptimizationReasonCount reason;
+    reason.function = function;
+    reason.bailout_type = bailout_type;
+    reason.ast_id = ast_id;
+    reason.count = 1;
+    deoptimization_reasons_.Add(reason);
+  }
+  if (reason_count > shared->deopt_backoff()) {
+    shared->set_deopt_backoff(
+        Min(reason_count, SharedFunctionInfo::DeoptBackoffBits::kMax));
+  }
+
+  for (int i = 0; i < deoptimization_statistics_.length(); i++) {
+    DeoptimizationStatistics* stats = &deoptimization_statistics_[i];
+    if (CompareProfileEntries(&stats->function, &function) == 0) {
+      stats->counts[bailout_type]++;
+      return;
+    }
+  }
+  DeoptimizationStatistics stats;
+  stats.function = function;
+  stats.name = shared->DebugName()->ToCString().Detach();
+  for (int i = 0; i < DeoptimizationStatistics::kBailoutTypeCount; i++) {
+    stats.counts[i] = 0;
+  }
+  stats.counts[bailout_type] = 1;
+  deoptimization_statistics_.Add(stats);
+}
+
+
 void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
   ASSERT(function->IsOptimizable());
+  AddToOptimizationProfile(function->shared());
   if (FLAG_trace_opt) {
     PrintF("[marking ");
     function->PrintName();
@@ -319,10 +538,26 @@ void RuntimeProfiler::OptimizeNow() {
     }
     if (!function->IsOptimizable()) continue;
 
+    // Functions that were optimized by an earlier run skip the warm-up.  The
+    // profile is consulted once per function.
+    if (IsInLoadedProfile(shared)) {
+      Optimize(function, "in loaded optimization profile");
+      continue;
+    }
+
     if (FLAG_watch_ic_patching) {
       int ticks = shared_code->profiler_ticks();
-
-      if (ticks >= kProfilerTicksBeforeOptimization) {
+      // Back off exponentially from functions that keep deoptimizing for
+      // the same reason, so a deoptimization loop does not burn the CPU in
+      // the compiler.  A function that deoptimized once each for several
+      // reasons has new type feedback for all of them and backs off less.
+      // Once opt_count exceeds its limit, optimization is disabled
+      // altogether.
+      int deopt_count = shared->deopt_count();
+      int ticks_before_optimization = kProfilerTicksBeforeOptimization <<
+          Min(shared->deopt_backoff(), kMaxDeoptBackoffShift);
+
+      if (ticks >= ticks_before_optimization) {
         int typeinfo, total, percentage;
         GetICCounts(function, &typeinfo, &total, &percentage);
         if (percentage >= FLAG_type_info_threshold) {
@@ -340,7 +575,7 @@ void RuntimeProfiler::OptimizeNow() {
                    typeinfo, total, percentage);
           }
         }
-      } else if (!any_ic_changed_ &&
+      } else if (!any_ic_changed_ && deopt_count == 0 &&
                  shared_code->instruction_size() < kMaxSizeEarlyOpt) {
         // If no IC was patched since the last tick and this function is very
         // small, optimistically optimize it now.
@@ -404,7 +639,11 @@ void RuntimeProfiler::Reset() {
 
 
 void RuntimeProfiler::TearDown() {
-  // Nothing to do.
+  for (int i = 0; i < deoptimization_statistics_.length(); i++) {
+    DeleteArray(deoptimization_statistics_[i].name);
+  }
+  deoptimization_statistics_.Clear();
+  deoptimization_reasons_.Clear();
 }
 
 
@@ -30,6 +30,8 @@
 
 #include "allocation.h"
 #include "atomicops.h"
+#include "handles.h"
+#include "list.h"
 
 namespace v8 {
 namespace internal {
@@ -38,6 +40,35 @@ class Isolate;
 class JSFunction;
 class Object;
 class Semaphore;
+class SharedFunctionInfo;
+class String;
+
+// A function in an optimization profile, identified independently of the
+// process: by a hash of its source text and its start position in the script.
+struct OptimizationProfileEntry {
+  uint32_t source_hash;
+  int start_position;
+};
+
+// Deoptimization counts of a function, by Deoptimizer::BailoutType.  Frames
+// deoptimized for the debugger are not counted.
+struct DeoptimizationStatistics {
+  static const int kBailoutTypeCount = 3;
+  OptimizationProfileEntry function;
+  char* name;  // Owned by the runtime profiler.
+  int counts[kBailoutTypeCount];
+};
+
+// Deoptimization count of a function for one reason: a bailout type at one
+// bailout point, identified by its AST id.  AST ids do not change when the
+// function is optimized again, so repeated deoptimizations at the same
+// check add up.
+struct DeoptimizationReasonCount {
+  OptimizationProfileEntry function;
+  int bailout_type;
+  int ast_id;
+  int count;
+};
 
 class RuntimeProfiler {
  public:
@@ -96,6 +127,22 @@ class RuntimeProfiler {
 
   void AttemptOnStackReplacement(JSFunction* function);
 
+  // Optimization profiles let a new process optimize the functions that
+  // were optimized by an earlier one as soon as they run.  The profile
+  // returned contains the loaded entries and every function optimized since.
+  Handle<String> GetOptimizationProfile();
+  bool LoadOptimizationProfile(Handle<String> profile);
+
+  // Called by the deoptimizer for every deoptimization.  The counts outlive
+  // the function's code, so repeated optimize/deoptimize cycles show up.
+  // The function's deopt_backoff becomes the largest count for any reason.
+  void RecordDeoptimization(SharedFunctionInfo* shared,
+                            int bailout_type,
+                            int ast_id);
+  const List<DeoptimizationStatistics>& deoptimization_statistics() const {
+    return deoptimization_statistics_;
+  }
+
  private:
   static const int kSamplerWindowSize = 16;
 
@@ -103,6 +150,9 @@ class RuntimeProfiler {
 
   void Optimize(JSFunction* function, const char* reason);
 
+  bool IsInLoadedProfile(SharedFunctionInfo* shared);
+  void AddToOptimizationProfile(SharedFunctionInfo* shared);
+
   void ClearSampleBuffer();
 
   void ClearSampleBufferNewSpaceEntries();
@@ -124,6 +174,14 @@ class RuntimeProfiler {
   bool any_ic_changed_;
   bool code_generated_;
 
+  // Sorted, so that lookups can use binary search.  The optimized functions
+  // hold each entry once.
+  List<OptimizationProfileEntry> loaded_profile_;
+  List<OptimizationProfileEntry> optimized_functions_;
+
+  List<DeoptimizationStatistics> deoptimization_statistics_;
+  List<DeoptimizationReasonCount> deoptimization_reasons_;
+
   // Possible state values:
   //   -1            => the profiler thread is waiting on the semaphore
   //   0 or positive => the number of isolates running JavaScript code.
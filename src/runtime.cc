@@ -736,11 +736,63 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_Fix) {
 }
 
 
+// Returns the iterator used by Set and Map forEach: an array holding the
+// table being walked and the number of the entry to continue from.
+template<class Table>
+static MaybeObject* NewOrderedHashTableIterator(Isolate* isolate,
+                                                Handle<Table> table) {
+  Handle<FixedArray> state = isolate->factory()->NewFixedArray(2);
+  state->set(0, *table);
+  state->set(1, Smi::FromInt(0));
+  return *isolate->factory()->NewJSArrayWithElements(state, FAST_ELEMENTS);
+}
+
+
+// Moves an iterator to the next entry that has not been removed and
+// returns its number in the current table, or -1 if there is none.  If the
+// table has been rehashed since the previous step, the iterator follows it
+// to the current table, translating the entry number on the way, so that
+// entries added by the callback are visited and removed ones are not.
+template<class Table>
+static MaybeObject* OrderedHashTableIteratorNext(Isolate* isolate,
+                                                 Table* current,
+                                                 JSArray* iterator) {
+  RUNTIME_ASSERT(iterator->HasFastObjectElements());
+  FixedArray* state = FixedArray::cast(iterator->elements());
+  RUNTIME_ASSERT(state->length() == 2 &&
+                 state->get(0)->IsFixedArray() &&
+                 state->get(1)->IsSmi());
+  Table* table = Table::cast(state->get(0));
+  int entry = Smi::cast(state->get(1))->value();
+  while (table->IsObsolete()) {
+    entry = table->TranslateEntry(entry);
+    table = table->NextTable();
+  }
+  RUNTIME_ASSERT(table == current);
+  entry = table->NextEntry(entry);
+  state->set(0, table);
+  state->set(1, Smi::FromInt(entry == Table::kNotFound
+                                 ? table->UsedCapacity()
+                                 : entry + 1));
+  return Smi::FromInt(entry);
+}
+
+
+// String keys of sets and maps are symbols, see OrderedHashTable.
+static Handle<Object> OrderedHashTableKey(Isolate* isolate,
+                                          Handle<Object> key) {
+  if (key->IsString() && !key->IsSymbol()) {
+    return isolate->factory()->LookupSymbol(Handle<String>::cast(key));
+  }
+  return key;
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_SetInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<ObjectHashSet> table = isolate->factory()->NewObjectHashSet(0);
+  Handle<OrderedHashSet> table = isolate->factory()->NewOrderedHashSet();
   holder->set_table(*table);
   return *holder;
 }
@@ -750,21 +802,20 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetAdd) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<Object> key(args[1]);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSetAdd(table, key);
+  Handle<Object> key = OrderedHashTableKey(isolate, args.at<Object>(1));
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  table = OrderedHashSetAdd(table, key);
   holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_SetHas) {
-  HandleScope scope(isolate);
+  NoHandleAllocation ha;
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<Object> key(args[1]);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  return isolate->heap()->ToBoolean(table->Contains(*key));
+  CONVERT_ARG_CHECKED(JSSet, holder, 0);
+  OrderedHashSet* table = OrderedHashSet::cast(holder->table());
+  return isolate->heap()->ToBoolean(table->Contains(args[1]));
 }
 
 
@@ -773,42 +824,72 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
   Handle<Object> key(args[1]);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSetRemove(table, key);
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  table = OrderedHashSetRemove(table, key);
   holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
 
 
+// Returns an iterator over the entries of a set for SetNextEntry.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SetIterationStart) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  return NewOrderedHashTableIterator(isolate, table);
+}
+
+
+// Returns the next entry of a set that has not been removed, or -1 if there
+// is none, see OrderedHashTableIteratorNext.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SetNextEntry) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSSet, holder, 0);
+  CONVERT_ARG_CHECKED(JSArray, iterator, 1);
+  return OrderedHashTableIteratorNext(
+      isolate, OrderedHashSet::cast(holder->table()), iterator);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SetKeyAt) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSSet, holder, 0);
+  CONVERT_SMI_ARG_CHECKED(entry, 1);
+  OrderedHashSet* table = OrderedHashSet::cast(holder->table());
+  RUNTIME_ASSERT(entry >= 0 && entry < table->UsedCapacity());
+  return table->KeyAt(entry);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  Handle<ObjectHashTable> table = isolate->factory()->NewObjectHashTable(0);
+  Handle<OrderedHashMap> table = isolate->factory()->NewOrderedHashMap();
   holder->set_table(*table);
   return *holder;
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapGet) {
-  HandleScope scope(isolate);
+  NoHandleAllocation ha;
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<Object> lookup(table->Lookup(*key));
-  return lookup->IsTheHole() ? isolate->heap()->undefined_value() : *lookup;
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  Object* lookup = table->Lookup(args[1]);
+  return lookup->IsTheHole() ? isolate->heap()->undefined_value() : lookup;
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapHas) {
-  HandleScope scope(isolate);
+  NoHandleAllocation ha;
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<Object> lookup(table->Lookup(*key));
-  return isolate->heap()->ToBoolean(!lookup->IsTheHole());
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  return isolate->heap()->ToBoolean(!table->Lookup(args[1])->IsTheHole());
 }
 
 
@@ -817,10 +898,10 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
   Handle<Object> lookup(table->Lookup(*key));
-  Handle<ObjectHashTable> new_table =
-      PutIntoObjectHashTable(table, key, isolate->factory()->the_hole_value());
+  Handle<OrderedHashMap> new_table =
+      PutIntoOrderedHashMap(table, key, isolate->factory()->the_hole_value());
   holder->set_table(*new_table);
   return isolate->heap()->ToBoolean(!lookup->IsTheHole());
 }
@@ -830,15 +911,59 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapSet) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 3);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
+  Handle<Object> key = OrderedHashTableKey(isolate, args.at<Object>(1));
   CONVERT_ARG_HANDLE_CHECKED(Object, value, 2);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<ObjectHashTable> new_table = PutIntoObjectHashTable(table, key, value);
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
+  Handle<OrderedHashMap> new_table = PutIntoOrderedHashMap(table, key, value);
   holder->set_table(*new_table);
   return isolate->heap()->undefined_value();
 }
 
 
+// Returns an iterator over the entries of a map for MapNextEntry.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_MapIterationStart) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
+  return NewOrderedHashTableIterator(isolate, table);
+}
+
+
+// Returns the next entry of a map that has not been removed, or -1 if there
+// is none, see OrderedHashTableIteratorNext.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_MapNextEntry) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  CONVERT_ARG_CHECKED(JSArray, iterator, 1);
+  return OrderedHashTableIteratorNext(
+      isolate, OrderedHashMap::cast(holder->table()), iterator);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_MapKeyAt) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  CONVERT_SMI_ARG_CHECKED(entry, 1);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  RUNTIME_ASSERT(entry >= 0 && entry < table->UsedCapacity());
+  return table->KeyAt(entry);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_MapValueAt) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  CONVERT_SMI_ARG_CHECKED(entry, 1);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  RUNTIME_ASSERT(entry >= 0 && entry < table->UsedCapacity());
+  return table->ValueAt(entry);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_WeakMapInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
@@ -4042,8 +4167,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_KeyedGetProperty) {
         receiver->LocalLookup(key, &result);
         if (result.IsField()) {
           int offset = result.GetFieldIndex();
-          keyed_lookup_cache->Update(receiver_map, key, offset);
-          return receiver->FastPropertyAt(offset);
+          PropertyDetails details = result.GetPropertyDetails();
+          // Loads through the lookup cache do not copy double fields.
+          if (!details.IsDoubleField()) {
+            keyed_lookup_cache->Update(receiver_map, key, offset);
+          }
+          return receiver->FastPropertyValueAt(offset, details);
         }
       } else {
         // Attempt dictionary lookup.
@@ -5393,6 +5522,297 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_URIUnescape) {
 }
 
 
+// The URI character classes of ECMA-262 section 15.1.3 for the characters
+// below 128.  uriUnreserved characters are never escaped.  uriReserved
+// characters and '#' are left alone by encodeURI and decodeURI, but not by
+// encodeURIComponent and decodeURIComponent.  All other characters are
+// always escaped.
+static const int kURIEscaped = 0;
+static const int kURIUnreserved = 1;
+static const int kURIReserved = 2;
+
+static const char kURICharClass[128] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 1, 0, 2, 2, 0, 2, 1, 1, 1, 1, 2, 2, 1, 1, 2,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 0, 2, 0, 2,
+  2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1,
+  0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0,
+};
+
+
+static inline bool IsURIUnescaped(int character, bool component) {
+  if (character >= 128) return false;
+  int char_class = kURICharClass[character];
+  if (char_class == kURIEscaped) return false;
+  return char_class == kURIUnreserved || !component;
+}
+
+
+static inline bool IsURIReserved(int character, bool component) {
+  if (component || character >= 128) return false;
+  return kURICharClass[character] == kURIReserved;
+}
+
+
+// Returns the escaped form of the string for encodeURI and
+// encodeURIComponent, or null if it contains a lone surrogate.  Strings
+// without characters to escape are returned as is.
+template <typename Char>
+static MaybeObject* URIEncode(Isolate* isolate,
+                              String* source,
+                              Vector<const Char> characters,
+                              bool component) {
+  const char hex_chars[] = "0123456789ABCDEF";
+  int length = characters.length();
+  int prefix = 0;
+  while (prefix < length && IsURIUnescaped(characters[prefix], component)) {
+    prefix++;
+  }
+  if (prefix == length) return source;
+
+  int escaped_length = prefix;
+  for (int i = prefix; i < length; i++) {
+    int character = characters[i];
+    if (IsURIUnescaped(character, component)) {
+      escaped_length++;
+    } else if (!unibrow::Utf16::IsLeadSurrogate(character) &&
+               !unibrow::Utf16::IsTrailSurrogate(character)) {
+      escaped_length += 3 * unibrow::Utf8::Length(
+          character, unibrow::Utf16::kNoPreviousCharacter);
+    } else if (unibrow::Utf16::IsLeadSurrogate(character) &&
+               i + 1 < length &&
+               unibrow::Utf16::IsTrailSurrogate(characters[i + 1])) {
+      escaped_length += 3 * 4;
+      i++;
+    } else {
+      return isolate->heap()->null_value();
+    }
+    // We don't allow strings that are longer than a maximal length.
+    ASSERT(String::kMaxLength < 0x7fffffff - 12);  // Cannot overflow.
+    if (escaped_length > String::kMaxLength) {
+      isolate->context()->mark_out_of_memory();
+      return Failure::OutOfMemoryException();
+    }
+  }
+
+  Object* o;
+  { MaybeObject* maybe_o =
+        isolate->heap()->AllocateRawAsciiString(escaped_length);
+    if (!maybe_o->ToObject(&o)) return maybe_o;
+  }
+  char* dest = SeqAsciiString::cast(o)->GetChars();
+  CopyChars(dest, characters.start(), prefix);
+  dest += prefix;
+  for (int i = prefix; i < length; i++) {
+    int character = characters[i];
+    if (IsURIUnescaped(character, component)) {
+      *dest++ = static_cast<char>(character);
+      continue;
+    }
+    if (unibrow::Utf16::IsLeadSurrogate(character)) {
+      character = unibrow::Utf16::CombineSurrogatePair(character,
+                                                       characters[++i]);
+    }
+    char octets[unibrow::Utf8::kMaxEncodedSize];
+    int count = unibrow::Utf8::Encode(octets,
+                                      character,
+                                      unibrow::Utf16::kNoPreviousCharacter);
+    for (int j = 0; j < count; j++) {
+      uint8_t octet = static_cast<uint8_t>(octets[j]);
+      *dest++ = '%';
+      *dest++ = hex_chars[octet >> 4];
+      *dest++ = hex_chars[octet & 0xf];
+    }
+  }
+  ASSERT(dest == SeqAsciiString::cast(o)->GetChars() + escaped_length);
+  return o;
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_URIEncode) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  if (!source->IsFlat()) {
+    MaybeObject* try_flatten = source->TryFlatten();
+    Object* flat;
+    if (!try_flatten->ToObject(&flat)) {
+      return try_flatten;
+    }
+    source = String::cast(flat);
+    ASSERT(source->IsFlat());
+  }
+  String::FlatContent flat = source->GetFlatContent();
+  if (flat.IsTwoByte()) {
+    return URIEncode<uc16>(isolate, source, flat.ToUC16Vector(), component);
+  } else {
+    return URIEncode<char>(isolate, source, flat.ToAsciiVector(), component);
+  }
+}
+
+
+// Decodes the UTF-8 sequence of escapes for one character starting at the
+// '%' at index i.  Returns the decoded character and sets *step to the
+// number of characters consumed, or returns -1 if the sequence is
+// malformed.
+template <typename Char>
+static int DecodeURIEscape(Vector<const Char> characters, int i, int* step) {
+  static const int kMinValue[] = { 0, 0, 0x80, 0x800, 0x10000 };
+  int length = characters.length();
+  if (i + 2 >= length) return -1;
+  int value = TwoDigitHex(characters[i + 1], characters[i + 2]);
+  if (value == -1) return -1;
+  *step = 3;
+  if (value < 0x80) return value;
+
+  int count;
+  if (value >= 0xf8) {
+    return -1;
+  } else if (value >= 0xf0) {
+    count = 4;
+    value &= 0x07;
+  } else if (value >= 0xe0) {
+    count = 3;
+    value &= 0x0f;
+  } else if (value >= 0xc0) {
+    count = 2;
+    value &= 0x1f;
+  } else {
+    return -1;
+  }
+  if (i + 3 * count > length) return -1;
+  for (int j = 1; j < count; j++) {
+    int index = i + 3 * j;
+    if (characters[index] != '%') return -1;
+    int octet = TwoDigitHex(characters[index + 1], characters[index + 2]);
+    if (octet == -1 || (octet & 0xc0) != 0x80) return -1;
+    value = (value << 6) | (octet & 0x3f);
+  }
+  // Reject overlong encodings, surrogates and values beyond Unicode.
+  if (value < kMinValue[count] || value > 0x10ffff) return -1;
+  if (value >= 0xd800 && value <= 0xdfff) return -1;
+  *step = 3 * count;
+  return value;
+}
+
+
+template <typename Char, typename SinkChar>
+static void WriteDecodedURI(Vector<const Char> characters,
+                            int prefix,
+                            SinkChar* dest,
+                            bool component) {
+  int length = characters.length();
+  CopyChars(dest, characters.start(), prefix);
+  dest += prefix;
+  for (int i = prefix; i < length; ) {
+    int character = characters[i];
+    if (character != '%') {
+      *dest++ = character;
+      i++;
+      continue;
+    }
+    int step;
+    int value = DecodeURIEscape(characters, i, &step);
+    ASSERT(value != -1);
+    if (IsURIReserved(value, component)) {
+      CopyChars(dest, characters.start() + i, step);
+      dest += step;
+    } else if (value >
+               static_cast<int>(unibrow::Utf16::kMaxNonSurrogateCharCode)) {
+      *dest++ = unibrow::Utf16::LeadSurrogate(value);
+      *dest++ = unibrow::Utf16::TrailSurrogate(value);
+    } else {
+      *dest++ = value;
+    }
+    i += step;
+  }
+}
+
+
+// Returns the decoded form of the string for decodeURI and
+// decodeURIComponent, or null if it contains a malformed escape sequence.
+// Strings without escape sequences are returned as is.
+template <typename Char>
+static MaybeObject* URIDecode(Isolate* isolate,
+                              String* source,
+                              Vector<const Char> characters,
+                              bool component) {
+  int length = characters.length();
+  int prefix = 0;
+  while (prefix < length && characters[prefix] != '%') prefix++;
+  if (prefix == length) return source;
+
+  // The result is never longer than the source.
+  bool ascii = true;
+  int decoded_length = 0;
+  for (int i = 0; i < length; ) {
+    int character = characters[i];
+    if (character != '%') {
+      if (character > String::kMaxAsciiCharCode) ascii = false;
+      decoded_length++;
+      i++;
+      continue;
+    }
+    int step;
+    int value = DecodeURIEscape(characters, i, &step);
+    if (value == -1) return isolate->heap()->null_value();
+    if (IsURIReserved(value, component)) {
+      decoded_length += step;
+    } else {
+      if (value > String::kMaxAsciiCharCode) ascii = false;
+      decoded_length += (value >
+          static_cast<int>(unibrow::Utf16::kMaxNonSurrogateCharCode)) ? 2 : 1;
+    }
+    i += step;
+  }
+
+  Object* o;
+  if (ascii) {
+    { MaybeObject* maybe_o =
+          isolate->heap()->AllocateRawAsciiString(decoded_length);
+      if (!maybe_o->ToObject(&o)) return maybe_o;
+    }
+    WriteDecodedURI(characters, prefix,
+                    SeqAsciiString::cast(o)->GetChars(), component);
+  } else {
+    { MaybeObject* maybe_o =
+          isolate->heap()->AllocateRawTwoByteString(decoded_length);
+      if (!maybe_o->ToObject(&o)) return maybe_o;
+    }
+    WriteDecodedURI(characters, prefix,
+                    SeqTwoByteString::cast(o)->GetChars(), component);
+  }
+  return o;
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_URIDecode) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  if (!source->IsFlat()) {
+    MaybeObject* try_flatten = source->TryFlatten();
+    Object* flat;
+    if (!try_flatten->ToObject(&flat)) {
+      return try_flatten;
+    }
+    source = String::cast(flat);
+    ASSERT(source->IsFlat());
+  }
+  String::FlatContent flat = source->GetFlatContent();
+  if (flat.IsTwoByte()) {
+    return URIDecode<uc16>(isolate, source, flat.ToUC16Vector(), component);
+  } else {
+    return URIDecode<char>(isolate, source, flat.ToAsciiVector(), component);
+  }
+}
+
+
 static const unsigned int kQuoteTableLength = 128u;
 
 static const int kJsonQuotesCharactersPerEntry = 8;
@@ -5918,37 +6338,51 @@ enum AsciiCaseConversion {
 
 template <AsciiCaseConversion dir>
 struct FastAsciiConverter {
-  static bool Convert(char* dst, char* src, int length) {
-#ifdef DEBUG
-    char* saved_dst = dst;
-    char* saved_src = src;
-#endif
-    // We rely on the distance between upper and lower case letters
-    // being a known power of 2.
+  // Boundaries for the range of input characters than require conversion.
+  static const char kLo = (dir == ASCII_TO_LOWER) ? 'A' - 1 : 'a' - 1;
+  static const char kHi = (dir == ASCII_TO_LOWER) ? 'Z' + 1 : 'z' + 1;
+
+  static inline bool NeedsConversion(int c) {
+    return kLo < c && c < kHi;
+  }
+
+  // We rely on the distance between upper and lower case letters
+  // being a known power of 2.
+  static inline int ConvertChar(int c) {
     ASSERT('a' - 'A' == (1 << 5));
-    // Boundaries for the range of input characters than require conversion.
-    const char lo = (dir == ASCII_TO_LOWER) ? 'A' - 1 : 'a' - 1;
-    const char hi = (dir == ASCII_TO_LOWER) ? 'Z' + 1 : 'z' + 1;
-    bool changed = false;
-    char* const limit = src + length;
+    return NeedsConversion(c) ? c ^ (1 << 5) : c;
+  }
+
+  // Returns the index of the first character in the ASCII input that
+  // requires conversion, or length if there is none.
+  static int FindFirstToConvert(const char* src, int length) {
+    const char* const start = src;
+    const char* const limit = src + length;
 #ifdef V8_HOST_CAN_READ_UNALIGNED
-    // Process the prefix of the input that requires no conversion one
+    // Skip the prefix of the input that requires no conversion one
     // (machine) word at a time.
     while (src <= limit - sizeof(uintptr_t)) {
-      uintptr_t w = *reinterpret_cast<uintptr_t*>(src);
-      if (AsciiRangeMask(w, lo, hi) != 0) {
-        changed = true;
-        break;
-      }
-      *reinterpret_cast<uintptr_t*>(dst) = w;
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src);
+      if (AsciiRangeMask(w, kLo, kHi) != 0) break;
       src += sizeof(uintptr_t);
-      dst += sizeof(uintptr_t);
     }
-    // Process the remainder of the input performing conversion when
-    // required one word at a time.
+#endif
+    while (src < limit && !NeedsConversion(*src)) ++src;
+    return static_cast<int>(src - start);
+  }
+
+  static void Convert(char* dst, const char* src, int length) {
+#ifdef DEBUG
+    char* saved_dst = dst;
+    const char* saved_src = src;
+#endif
+    const char* const limit = src + length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+    // Process the input performing conversion when required one word at
+    // a time.
     while (src <= limit - sizeof(uintptr_t)) {
-      uintptr_t w = *reinterpret_cast<uintptr_t*>(src);
-      uintptr_t m = AsciiRangeMask(w, lo, hi);
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src);
+      uintptr_t m = AsciiRangeMask(w, kLo, kHi);
       // The mask has high (7th) bit set in every byte that needs
       // conversion and we know that the distance between cases is
       // 1 << 5.
@@ -5960,27 +6394,19 @@ struct FastAsciiConverter {
     // Process the last few bytes of the input (or the whole input if
     // unaligned access is not supported).
     while (src < limit) {
-      char c = *src;
-      if (lo < c && c < hi) {
-        c ^= (1 << 5);
-        changed = true;
-      }
-      *dst = c;
+      *dst = ConvertChar(*src);
       ++src;
       ++dst;
     }
 #ifdef DEBUG
-    CheckConvert(saved_dst, saved_src, length, changed);
+    CheckConvert(saved_dst, saved_src, length);
 #endif
-    return changed;
   }
 
 #ifdef DEBUG
-  static void CheckConvert(char* dst, char* src, int length, bool changed) {
-    bool expected_changed = false;
+  static void CheckConvert(char* dst, const char* src, int length) {
     for (int i = 0; i < length; i++) {
       if (dst[i] == src[i]) continue;
-      expected_changed = true;
       if (dir == ASCII_TO_LOWER) {
         ASSERT('A' <= src[i] && src[i] <= 'Z');
         ASSERT(dst[i] == src[i] + ('a' - 'A'));
@@ -5990,7 +6416,6 @@ struct FastAsciiConverter {
         ASSERT(dst[i] == src[i] - ('a' - 'A'));
       }
     }
-    ASSERT(expected_changed == changed);
   }
 #endif
 };
@@ -6012,6 +6437,61 @@ struct ToUpperTraits {
 }  // namespace
 
 
+// Converts a flat two-byte string.  ASCII characters are converted
+// inline, only the other characters go through the unibrow mapping.
+// Returns a smi if some character converts to several characters, in which
+// case the string has to be converted by ConvertCaseHelper.
+template <typename ConvertTraits>
+MUST_USE_RESULT static MaybeObject* ConvertTwoByteCase(
+    Isolate* isolate,
+    String* s,
+    Vector<const uc16> chars,
+    unibrow::Mapping<typename ConvertTraits::UnibrowConverter, 128>* mapping) {
+  typedef typename ConvertTraits::AsciiConverter AsciiConverter;
+  const int length = chars.length();
+
+  // Return the string itself if it starts with a run of ASCII characters
+  // that need no conversion and nothing follows.
+  int prefix = 0;
+  while (prefix < length &&
+         chars[prefix] <= String::kMaxAsciiCharCode &&
+         !AsciiConverter::NeedsConversion(chars[prefix])) {
+    prefix++;
+  }
+  if (prefix == length) return s;
+
+  Object* o;
+  { MaybeObject* maybe_o = isolate->heap()->AllocateRawTwoByteString(length);
+    if (!maybe_o->ToObject(&o)) return maybe_o;
+  }
+  uc16* dst = SeqTwoByteString::cast(o)->GetChars();
+  CopyChars(dst, chars.start(), prefix);
+
+  bool has_changed_character = false;
+  unibrow::uchar converted[ConvertTraits::UnibrowConverter::kMaxWidth];
+  for (int i = prefix; i < length; i++) {
+    uc16 current = chars[i];
+    if (current <= String::kMaxAsciiCharCode) {
+      uc16 c = AsciiConverter::ConvertChar(current);
+      if (c != current) has_changed_character = true;
+      dst[i] = c;
+      continue;
+    }
+    uc16 next = (i + 1 < length) ? chars[i + 1] : 0;
+    int char_length = mapping->get(current, next, converted);
+    if (char_length == 0) {
+      dst[i] = current;
+    } else if (char_length == 1) {
+      dst[i] = converted[0];
+      has_changed_character = true;
+    } else {
+      return Smi::FromInt(0);
+    }
+  }
+  return has_changed_character ? o : s;
+}
+
+
 template <typename ConvertTraits>
 MUST_USE_RESULT static MaybeObject* ConvertCase(
     Arguments args,
@@ -6025,24 +6505,39 @@ MUST_USE_RESULT static MaybeObject* ConvertCase(
   // Assume that the string is not empty; we need this assumption later
   if (length == 0) return s;
 
+  String::FlatContent flat = s->GetFlatContent();
   // Simpler handling of ASCII strings.
   //
   // NOTE: This assumes that the upper/lower case of an ASCII
   // character is also ASCII.  This is currently the case, but it
   // might break in the future if we implement more context and locale
   // dependent upper/lower conversions.
-  if (s->IsSeqAsciiString()) {
+  if (flat.IsAscii()) {
+    typedef typename ConvertTraits::AsciiConverter AsciiConverter;
+    const char* chars = flat.ToAsciiVector().start();
+    // Strings that are already in the requested case are returned without
+    // allocating a copy.
+    int prefix = AsciiConverter::FindFirstToConvert(chars, length);
+    if (prefix == length) return s;
     Object* o;
     { MaybeObject* maybe_o = isolate->heap()->AllocateRawAsciiString(length);
       if (!maybe_o->ToObject(&o)) return maybe_o;
     }
-    SeqAsciiString* result = SeqAsciiString::cast(o);
-    bool has_changed_character = ConvertTraits::AsciiConverter::Convert(
-        result->GetChars(), SeqAsciiString::cast(s)->GetChars(), length);
-    return has_changed_character ? result : s;
+    char* dst = SeqAsciiString::cast(o)->GetChars();
+    CopyChars(dst, chars, prefix);
+    AsciiConverter::Convert(dst + prefix, chars + prefix, length - prefix);
+    return o;
   }
 
   Object* answer;
+  if (flat.IsTwoByte()) {
+    { MaybeObject* maybe_answer = ConvertTwoByteCase<ConvertTraits>(
+          isolate, s, flat.ToUC16Vector(), mapping);
+      if (!maybe_answer->ToObject(&answer)) return maybe_answer;
+    }
+    if (!answer->IsSmi()) return answer;
+  }
+
   { MaybeObject* maybe_answer =
         ConvertCaseHelper(isolate, s, length, length, mapping);
     if (!maybe_answer->ToObject(&answer)) return maybe_answer;
@@ -7991,7 +8486,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_NotifyDeoptimized) {
   ASSERT(isolate->heap()->IsAllocationAllowed());
   int jsframes = deoptimizer->jsframe_count();
 
-  deoptimizer->MaterializeHeapNumbers();
+  deoptimizer->MaterializeHeapObjects();
   delete deoptimizer;
 
   JavaScriptFrameIterator it(isolate);
@@ -9947,14 +10442,16 @@ static MaybeObject* DebugLookupResultValue(Heap* heap,
         return heap->undefined_value();
       }
       return value;
-    case FIELD:
-      value =
-          JSObject::cast(
-              result->holder())->FastPropertyAt(result->GetFieldIndex());
+    case FIELD: {
+      MaybeObject* maybe_value =
+          JSObject::cast(result->holder())->FastPropertyValueAt(
+              result->GetFieldIndex(), result->GetPropertyDetails());
+      if (!maybe_value->ToObject(&value)) return maybe_value;
       if (value->IsTheHole()) {
         return heap->undefined_value();
       }
       return value;
+    }
     case CONSTANT_FUNCTION:
       return result->GetConstantFunction();
     case CALLBACKS: {
@@ -12826,9 +13323,11 @@ static bool ShowFrameInStackTrace(StackFrame* raw_frame,
 }
 
 
-// Collect the raw data for a stack trace.  Returns an array of 4
-// element segments each containing a receiver, function, code and
-// native code offset.
+// Collect the raw data for a stack trace and store it in a hidden property
+// of the error object.  The raw data is an array of 4 element segments each
+// containing a receiver, function, code and native code offset.  It is
+// only turned into a formatted stack trace when the 'stack' property of the
+// error is first read, see messages.js.
 RUNTIME_FUNCTION(MaybeObject*, Runtime_CollectStackTrace) {
   ASSERT_EQ(args.length(), 3);
   CONVERT_ARG_HANDLE_CHECKED(JSObject, error_object, 0);
@@ -12883,10 +13382,46 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CollectStackTrace) {
     iter.Advance();
   }
   Handle<JSArray> result = factory->NewJSArrayWithElements(elements);
+  result->set_length(Smi::FromInt(cursor));
+  JSObject::SetHiddenProperty(
+      error_object, factory->raw_stack_trace_symbol(), result);
   // Capture and attach a more detailed stack trace if necessary.
   isolate->CaptureAndSetCurrentStackTraceFor(error_object);
-  result->set_length(Smi::FromInt(cursor));
-  return *result;
+  return isolate->heap()->undefined_value();
+}
+
+
+// Returns the raw stack trace collected for an error object, or undefined
+// if there is none, and removes it from the object.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_GetAndClearRawStackTrace) {
+  NoHandleAllocation ha;
+  ASSERT_EQ(args.length(), 1);
+  CONVERT_ARG_CHECKED(JSObject, error_object, 0);
+  String* key = isolate->heap()->raw_stack_trace_symbol();
+  Object* raw_stack = error_object->GetHiddenProperty(key);
+  if (!raw_stack->IsUndefined()) error_object->DeleteHiddenProperty(key);
+  return raw_stack;
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_GetFormattedStackTrace) {
+  NoHandleAllocation ha;
+  ASSERT_EQ(args.length(), 1);
+  CONVERT_ARG_CHECKED(JSObject, error_object, 0);
+  return error_object->GetHiddenProperty(
+      isolate->heap()->formatted_stack_trace_symbol());
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SetFormattedStackTrace) {
+  NoHandleAllocation ha;
+  ASSERT_EQ(args.length(), 2);
+  CONVERT_ARG_CHECKED(JSObject, error_object, 0);
+  Object* value = args[1];
+  MaybeObject* result = error_object->SetHiddenProperty(
+      isolate->heap()->formatted_stack_trace_symbol(), value);
+  if (result->IsFailure()) return result;
+  return value;
 }
 
 
@@ -121,6 +121,8 @@ namespace internal {
   F(CharFromCode, 1, 1) \
   F(URIEscape, 1, 1) \
   F(URIUnescape, 1, 1) \
+  F(URIEncode, 2, 1) \
+  F(URIDecode, 2, 1) \
   F(QuoteJSONString, 1, 1) \
   F(QuoteJSONStringComma, 1, 1) \
   F(QuoteJSONStringArray, 1, 1) \
@@ -233,6 +235,9 @@ namespace internal {
   F(FunctionIsBuiltin, 1, 1) \
   F(GetScript, 1, 1) \
   F(CollectStackTrace, 3, 1) \
+  F(GetAndClearRawStackTrace, 1, 1) \
+  F(GetFormattedStackTrace, 1, 1) \
+  F(SetFormattedStackTrace, 2, 1) \
   F(GetV8Version, 0, 1) \
   \
   F(ClassOf, 1, 1) \
@@ -302,6 +307,9 @@ namespace internal {
   F(SetAdd, 2, 1) \
   F(SetHas, 2, 1) \
   F(SetDelete, 2, 1) \
+  F(SetIterationStart, 1, 1) \
+  F(SetNextEntry, 2, 1) \
+  F(SetKeyAt, 2, 1) \
   \
   /* Harmony maps */ \
   F(MapInitialize, 1, 1) \
@@ -309,6 +317,10 @@ namespace internal {
   F(MapHas, 2, 1) \
   F(MapDelete, 2, 1) \
   F(MapSet, 3, 1) \
+  F(MapIterationStart, 1, 1) \
+  F(MapNextEntry, 2, 1) \
+  F(MapKeyAt, 2, 1) \
+  F(MapValueAt, 2, 1) \
   \
   /* Harmony weakmaps */ \
   F(WeakMapInitialize, 1, 1) \
@@ -253,6 +253,24 @@ static inline bool IsByteOrderMark(uc32 c) {
 }
 
 
+// Predicates for the runs of ASCII code units that the scanner consumes in
+// bulk through Utf16CharacterStream::AdvanceSkipping. Anything outside
+// ASCII is left to the unicode cache.
+static inline bool IsSpaceOrTab(uc16 c) {
+  return c == ' ' || c == '\t';
+}
+
+
+static inline bool IsSingleLineCommentChar(uc16 c) {
+  return c < 0x80 && c != '\n' && c != '\r';
+}
+
+
+static inline bool IsMultiLineCommentChar(uc16 c) {
+  return c < 0x80 && c != '\n' && c != '\r' && c != '*';
+}
+
+
 bool Scanner::SkipWhiteSpace() {
   int start_position = source_pos();
 
@@ -260,6 +278,10 @@ bool Scanner::SkipWhiteSpace() {
     // We treat byte-order marks (BOMs) as whitespace for better
     // compatibility with Spidermonkey and other JavaScript engines.
     while (unicode_cache_->IsWhiteSpace(c0_) || IsByteOrderMark(c0_)) {
+      if (IsSpaceOrTab(c0_)) {
+        c0_ = source_->AdvanceSkipping(IsSpaceOrTab);
+        continue;
+      }
       // IsWhiteSpace() includes line terminators!
       if (unicode_cache_->IsLineTerminator(c0_)) {
         // Ignore line terminators, but remember them. This is necessary
@@ -302,7 +324,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
-    Advance();
+    c0_ = source_->AdvanceSkipping(IsSingleLineCommentChar);
   }
 
   return Token::WHITESPACE;
@@ -314,6 +336,10 @@ Token::Value Scanner::SkipMultiLineComment() {
   Advance();
 
   while (c0_ >= 0) {
+    if (IsMultiLineCommentChar(c0_)) {
+      c0_ = source_->AdvanceSkipping(IsMultiLineCommentChar);
+      continue;
+    }
     uc32 ch = c0_;
     Advance();
     if (unicode_cache_->IsLineTerminator(ch)) {
@@ -814,72 +840,108 @@ uc32 Scanner::ScanIdentifierUnicodeEscape() {
 // ----------------------------------------------------------------------------
 // Keyword Matcher
 
-#define KEYWORDS(KEYWORD_GROUP, KEYWORD)                            \
-  KEYWORD_GROUP('b')                                                \
-  KEYWORD("break", Token::BREAK)                                    \
-  KEYWORD_GROUP('c')                                                \
-  KEYWORD("case", Token::CASE)                                      \
-  KEYWORD("catch", Token::CATCH)                                    \
-  KEYWORD("class", Token::FUTURE_RESERVED_WORD)                     \
-  KEYWORD("const", Token::CONST)                                    \
-  KEYWORD("continue", Token::CONTINUE)                              \
-  KEYWORD_GROUP('d')                                                \
-  KEYWORD("debugger", Token::DEBUGGER)                              \
-  KEYWORD("default", Token::DEFAULT)                                \
-  KEYWORD("delete", Token::DELETE)                                  \
-  KEYWORD("do", Token::DO)                                          \
-  KEYWORD_GROUP('e')                                                \
-  KEYWORD("else", Token::ELSE)                                      \
-  KEYWORD("enum", Token::FUTURE_RESERVED_WORD)                      \
-  KEYWORD("export", harmony_modules                                 \
-                    ? Token::EXPORT : Token::FUTURE_RESERVED_WORD)  \
-  KEYWORD("extends", Token::FUTURE_RESERVED_WORD)                   \
-  KEYWORD_GROUP('f')                                                \
-  KEYWORD("false", Token::FALSE_LITERAL)                            \
-  KEYWORD("finally", Token::FINALLY)                                \
-  KEYWORD("for", Token::FOR)                                        \
-  KEYWORD("function", Token::FUNCTION)                              \
-  KEYWORD_GROUP('i')                                                \
-  KEYWORD("if", Token::IF)                                          \
-  KEYWORD("implements", Token::FUTURE_STRICT_RESERVED_WORD)         \
-  KEYWORD("import", harmony_modules                                 \
-                    ? Token::IMPORT : Token::FUTURE_RESERVED_WORD)  \
-  KEYWORD("in", Token::IN)                                          \
-  KEYWORD("instanceof", Token::INSTANCEOF)                          \
-  KEYWORD("interface", Token::FUTURE_STRICT_RESERVED_WORD)          \
-  KEYWORD_GROUP('l')                                                \
-  KEYWORD("let", harmony_scoping                                    \
-                 ? Token::LET : Token::FUTURE_STRICT_RESERVED_WORD) \
-  KEYWORD_GROUP('n')                                                \
-  KEYWORD("new", Token::NEW)                                        \
-  KEYWORD("null", Token::NULL_LITERAL)                              \
-  KEYWORD_GROUP('p')                                                \
-  KEYWORD("package", Token::FUTURE_STRICT_RESERVED_WORD)            \
-  KEYWORD("private", Token::FUTURE_STRICT_RESERVED_WORD)            \
-  KEYWORD("protected", Token::FUTURE_STRICT_RESERVED_WORD)          \
-  KEYWORD("public", Token::FUTURE_STRICT_RESERVED_WORD)             \
-  KEYWORD_GROUP('r')                                                \
-  KEYWORD("return", Token::RETURN)                                  \
-  KEYWORD_GROUP('s')                                                \
-  KEYWORD("static", Token::FUTURE_STRICT_RESERVED_WORD)             \
-  KEYWORD("super", Token::FUTURE_RESERVED_WORD)                     \
-  KEYWORD("switch", Token::SWITCH)                                  \
-  KEYWORD_GROUP('t')                                                \
-  KEYWORD("this", Token::THIS)                                      \
-  KEYWORD("throw", Token::THROW)                                    \
-  KEYWORD("true", Token::TRUE_LITERAL)                              \
-  KEYWORD("try", Token::TRY)                                        \
-  KEYWORD("typeof", Token::TYPEOF)                                  \
-  KEYWORD_GROUP('v')                                                \
-  KEYWORD("var", Token::VAR)                                        \
-  KEYWORD("void", Token::VOID)                                      \
-  KEYWORD_GROUP('w')                                                \
-  KEYWORD("while", Token::WHILE)                                    \
-  KEYWORD("with", Token::WITH)                                      \
-  KEYWORD_GROUP('y')                                                \
+#define KEYWORDS(KEYWORD)                                   \
+  KEYWORD("break", Token::BREAK)                            \
+  KEYWORD("case", Token::CASE)                              \
+  KEYWORD("catch", Token::CATCH)                            \
+  KEYWORD("class", Token::FUTURE_RESERVED_WORD)             \
+  KEYWORD("const", Token::CONST)                            \
+  KEYWORD("continue", Token::CONTINUE)                      \
+  KEYWORD("debugger", Token::DEBUGGER)                      \
+  KEYWORD("default", Token::DEFAULT)                        \
+  KEYWORD("delete", Token::DELETE)                          \
+  KEYWORD("do", Token::DO)                                  \
+  KEYWORD("else", Token::ELSE)                              \
+  KEYWORD("enum", Token::FUTURE_RESERVED_WORD)              \
+  KEYWORD("export", Token::EXPORT)                          \
+  KEYWORD("extends", Token::FUTURE_RESERVED_WORD)           \
+  KEYWORD("false", Token::FALSE_LITERAL)                    \
+  KEYWORD("finally", Token::FINALLY)                        \
+  KEYWORD("for", Token::FOR)                                \
+  KEYWORD("function", Token::FUNCTION)                      \
+  KEYWORD("if", Token::IF)                                  \
+  KEYWORD("implements", Token::FUTURE_STRICT_RESERVED_WORD) \
+  KEYWORD("import", Token::IMPORT)                          \
+  KEYWORD("in", Token::IN)                                  \
+  KEYWORD("instanceof", Token::INSTANCEOF)                  \
+  KEYWORD("interface", Token::FUTURE_STRICT_RESERVED_WORD)  \
+  KEYWORD("let", Token::LET)                                \
+  KEYWORD("new", Token::NEW)                                \
+  KEYWORD("null", Token::NULL_LITERAL)                      \
+  KEYWORD("package", Token::FUTURE_STRICT_RESERVED_WORD)    \
+  KEYWORD("private", Token::FUTURE_STRICT_RESERVED_WORD)    \
+  KEYWORD("protected", Token::FUTURE_STRICT_RESERVED_WORD)  \
+  KEYWORD("public", Token::FUTURE_STRICT_RESERVED_WORD)     \
+  KEYWORD("return", Token::RETURN)                          \
+  KEYWORD("static", Token::FUTURE_STRICT_RESERVED_WORD)     \
+  KEYWORD("super", Token::FUTURE_RESERVED_WORD)             \
+  KEYWORD("switch", Token::SWITCH)                          \
+  KEYWORD("this", Token::THIS)                              \
+  KEYWORD("throw", Token::THROW)                            \
+  KEYWORD("true", Token::TRUE_LITERAL)                      \
+  KEYWORD("try", Token::TRY)                                \
+  KEYWORD("typeof", Token::TYPEOF)                          \
+  KEYWORD("var", Token::VAR)                                \
+  KEYWORD("void", Token::VOID)                              \
+  KEYWORD("while", Token::WHILE)                            \
+  KEYWORD("with", Token::WITH)                              \
   KEYWORD("yield", Token::FUTURE_STRICT_RESERVED_WORD)
 
 
+// The keywords are found with a perfect hash over the first two
+// characters, the last character and the length of the input.  The
+// constants below are chosen so that no two entries of KEYWORDS collide;
+// they have to be searched for again, and kKeywordHashTable regenerated,
+// whenever a keyword is added.  The contextual keywords (let, import and
+// export) are listed with their Harmony token and downgraded to reserved
+// words in KeywordOrIdentifierToken when Harmony is off.
+struct KeywordEntry {
+  const char* keyword;
+  int length;
+  Token::Value token;
+};
+
+
+static const KeywordEntry kKeywords[] = {
+#define KEYWORD_ENTRY(keyword, token)                         \
+  /* 'keyword' is a char array, so sizeof(keyword) is */      \
+  /* strlen(keyword) plus 1 for the NUL char. */              \
+  { keyword, sizeof(keyword) - 1, token },
+  KEYWORDS(KEYWORD_ENTRY)
+#undef KEYWORD_ENTRY
+};
+
+
+static const int kKeywordHashFirstFactor = 6;
+static const int kKeywordHashSecondFactor = 32;
+static const int kKeywordHashLastFactor = 18;
+static const int kKeywordHashTableSize = 128;
+
+// Maps a keyword hash to an index in kKeywords, or -1 if no keyword has
+// that hash.
+static const int8_t kKeywordHashTable[kKeywordHashTableSize] = {
+  -1, 28, -1, 44,  6, -1, -1, -1,  9, -1, 39, -1, 12, 15, 31, -1,
+   1, -1, -1, -1, -1, 25, 37,  0,  8, -1, -1, 36, -1, -1, -1, -1,
+  -1, -1, -1, 14, -1, -1, -1,  7, -1, -1, -1, -1, -1, -1, 32, -1,
+  41, -1, -1, -1, -1, -1, 19, -1, -1, -1, -1, -1, 30, -1, 43, -1,
+  -1, -1, -1, -1, 20, -1, -1,  2, 17, -1, -1, 16, 11, -1, -1, -1,
+  26, -1, 35, 24,  5, -1, -1, -1, -1, 23, -1, 33, -1, -1, -1,  4,
+  -1, 27, -1, -1, 18, -1, -1, -1, 34, 42, -1, 40, 22,  3, -1, -1,
+  -1, 29, -1, -1, 21, -1, -1, -1, -1, -1, -1, 13, 10, 38, -1, -1,
+};
+
+
+static inline int KeywordHash(const char* input, int input_length) {
+  int first = static_cast<unsigned char>(input[0]);
+  int second = static_cast<unsigned char>(input[1]);
+  int last = static_cast<unsigned char>(input[input_length - 1]);
+  return (first * kKeywordHashFirstFactor +
+          second * kKeywordHashSecondFactor +
+          last * kKeywordHashLastFactor +
+          input_length) & (kKeywordHashTableSize - 1);
+}
+
+
 static Token::Value KeywordOrIdentifierToken(const char* input,
                                              int input_length,
                                              bool harmony_scoping,
@@ -890,34 +952,22 @@ static Token::Value KeywordOrIdentifierToken(const char* input,
   if (input_length < kMinLength || input_length > kMaxLength) {
     return Token::IDENTIFIER;
   }
-  switch (input[0]) {
+  int index = kKeywordHashTable[KeywordHash(input, input_length)];
+  if (index < 0) return Token::IDENTIFIER;
+  const KeywordEntry& entry = kKeywords[index];
+  if (entry.length != input_length ||
+      memcmp(entry.keyword, input, input_length) != 0) {
+    return Token::IDENTIFIER;
+  }
+  switch (entry.token) {
+    case Token::LET:
+      return harmony_scoping ? Token::LET : Token::FUTURE_STRICT_RESERVED_WORD;
+    case Token::IMPORT:
+    case Token::EXPORT:
+      return harmony_modules ? entry.token : Token::FUTURE_RESERVED_WORD;
     default:
-#define KEYWORD_GROUP_CASE(ch)                                \
-      break;                                                  \
-    case ch:
-#define KEYWORD(keyword, token)                               \
-    {                                                         \
-      /* 'keyword' is a char array, so sizeof(keyword) is */  \
-      /* strlen(keyword) plus 1 for the NUL char. */          \
-      const int keyword_length = sizeof(keyword) - 1;         \
-      STATIC_ASSERT(keyword_length >= kMinLength);            \
-      STATIC_ASSERT(keyword_length <= kMaxLength);            \
-      if (input_length == keyword_length &&                   \
-          input[1] == keyword[1] &&                           \
-          (keyword_length <= 2 || input[2] == keyword[2]) &&  \
-          (keyword_length <= 3 || input[3] == keyword[3]) &&  \
-          (keyword_length <= 4 || input[4] == keyword[4]) &&  \
-          (keyword_length <= 5 || input[5] == keyword[5]) &&  \
-          (keyword_length <= 6 || input[6] == keyword[6]) &&  \
-          (keyword_length <= 7 || input[7] == keyword[7]) &&  \
-          (keyword_length <= 8 || input[8] == keyword[8]) &&  \
-          (keyword_length <= 9 || input[9] == keyword[9])) {  \
-        return token;                                         \
-      }                                                       \
-    }
-    KEYWORDS(KEYWORD_GROUP_CASE, KEYWORD)
+      return entry.token;
   }
-  return Token::IDENTIFIER;
 }
 
 
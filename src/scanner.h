@@ -99,6 +99,24 @@ class Utf16CharacterStream {
     return kEndOfInput;
   }
 
+  // Advances past the code units for which skip(code_unit) holds, then
+  // returns and advances past the next code unit like Advance() does.
+  // Runs of skipped code units are consumed directly from the buffered
+  // block, without going through Advance() for each of them.
+  template <typename SkipPredicate>
+  inline uc32 AdvanceSkipping(SkipPredicate skip) {
+    while (true) {
+      const uc16* cursor = buffer_cursor_;
+      const uc16* end = buffer_end_;
+      while (cursor < end && skip(*cursor)) cursor++;
+      pos_ += static_cast<unsigned>(cursor - buffer_cursor_);
+      buffer_cursor_ = cursor;
+      if (cursor < end) break;
+      if (!ReadBlock()) break;
+    }
+    return Advance();
+  }
+
   // Return the current position in the code unit stream.
   // Starts at zero.
   inline unsigned pos() const { return pos_; }
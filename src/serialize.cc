@@ -523,6 +523,10 @@ void ExternalReferenceTable::PopulateTable(Isolate* isolate) {
       UNCLASSIFIED,
       50,
       "pending_message_script");
+  Add(ExternalReference::make_code_young_function(isolate).address(),
+      UNCLASSIFIED,
+      51,
+      "Code::MakeCodeAgeSequenceYoung");
 }
 
 
@@ -696,8 +700,9 @@ void Deserializer::Deserialize() {
       isolate_->heap()->undefined_value());
 
   // Update data pointers to the external strings containing natives sources.
-  for (int i = 0; i < Natives::GetBuiltinsCount(); i++) {
-    Object* source = isolate_->heap()->natives_source_cache()->get(i);
+  FixedArray* natives_source_cache = isolate_->heap()->natives_source_cache();
+  for (int i = 0; i < natives_source_cache->length(); i++) {
+    Object* source = natives_source_cache->get(i);
     if (!source->IsUndefined()) {
       ExternalAsciiString::cast(source)->update_data_cache();
     }
@@ -1096,8 +1101,13 @@ void Deserializer::ReadChunk(Object** current,
       }
 
       case kNativesStringResource: {
+        // Experimental natives are numbered after the natives.
         int index = source_->Get();
-        Vector<const char> source_vector = Natives::GetRawScriptSource(index);
+        Vector<const char> source_vector =
+            index < Natives::GetBuiltinsCount()
+                ? Natives::GetRawScriptSource(index)
+                : ExperimentalNatives::GetRawScriptSource(
+                      index - Natives::GetBuiltinsCount());
         NativesExternalStringResource* resource =
             new NativesExternalStringResource(isolate->bootstrapper(),
                                               source_vector.start(),
@@ -1588,8 +1598,9 @@ void Serializer::ObjectSerializer::VisitExternalAsciiString(
     v8::String::ExternalAsciiStringResource** resource_pointer) {
   Address references_start = reinterpret_cast<Address>(resource_pointer);
   OutputRawData(references_start);
-  for (int i = 0; i < Natives::GetBuiltinsCount(); i++) {
-    Object* source = HEAP->natives_source_cache()->get(i);
+  FixedArray* natives_source_cache = HEAP->natives_source_cache();
+  for (int i = 0; i < natives_source_cache->length(); i++) {
+    Object* source = natives_source_cache->get(i);
     if (!source->IsUndefined()) {
       ExternalAsciiString* string = ExternalAsciiString::cast(source);
       typedef v8::String::ExternalAsciiStringResource Resource;
@@ -1602,7 +1613,7 @@ void Serializer::ObjectSerializer::VisitExternalAsciiString(
       }
     }
   }
-  // One of the strings in the natives cache should match the resource.  We
+  // One of the strings in the natives caches should match the resource.  We
   // can't serialize any other kinds of external strings.
   UNREACHABLE();
 }
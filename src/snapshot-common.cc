@@ -30,6 +30,8 @@
 #include "v8.h"
 
 #include "api.h"
+#include "bootstrapper.h"
+#include "natives.h"
 #include "serialize.h"
 #include "snapshot.h"
 #include "platform.h"
@@ -80,4 +82,59 @@ Handle<Context> Snapshot::NewContextFromSnapshot() {
   return Handle<Context>(Context::cast(root));
 }
 
+
+
+bool Snapshot::Create(const char* extra_code,
+                      SnapshotByteSink* startup_sink,
+                      SnapshotByteSink* context_sink,
+                      int* context_space_used) {
+  Serializer::Enable();
+  v8::V8::Initialize();
+  v8::Persistent<v8::Context> context = v8::Context::New();
+  if (context.IsEmpty()) return false;
+  Isolate* isolate = Isolate::Current();
+
+  if (extra_code != NULL) {
+    context->Enter();
+    bool succeeded;
+    {
+      v8::HandleScope scope;
+      v8::TryCatch try_catch;
+      v8::Local<v8::Script> script =
+          v8::Script::Compile(v8::String::New(extra_code));
+      succeeded = !script.IsEmpty() && !script->Run().IsEmpty();
+    }
+    context->Exit();
+    if (!succeeded) {
+      context.Dispose();
+      return false;
+    }
+  }
+
+  // Make sure all builtin scripts are cached.
+  { HandleScope scope(isolate);
+    for (int i = 0; i < Natives::GetBuiltinsCount(); i++) {
+      isolate->bootstrapper()->NativesSourceLookup(i);
+    }
+  }
+  // If we don't do this then we end up with a stray root pointing at the
+  // context even after we have disposed of it.
+  isolate->heap()->CollectAllGarbage(Heap::kNoGCFlags, "Snapshot::Create");
+  Object* raw_context = *v8::Utils::OpenHandle(*context);
+  context.Dispose();
+
+  StartupSerializer startup_serializer(startup_sink);
+  startup_serializer.SerializeStrongReferences();
+
+  PartialSerializer context_serializer(&startup_serializer, context_sink);
+  context_serializer.Serialize(&raw_context);
+  startup_serializer.SerializeWeakReferences();
+
+  for (int space = FIRST_SPACE; space <= LAST_SPACE; space++) {
+    context_space_used[space] =
+        context_serializer.CurrentAllocationAddress(space);
+  }
+  return true;
+}
+
 } }  // namespace v8::internal
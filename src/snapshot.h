@@ -33,6 +33,8 @@
 namespace v8 {
 namespace internal {
 
+class SnapshotByteSink;
+
 class Snapshot {
  public:
   // Initialize the VM from the given snapshot file. If snapshot_file is
@@ -48,9 +50,18 @@ class Snapshot {
   // Returns whether or not the snapshot is enabled.
   static bool IsEnabled() { return size_ != 0; }
 
-  // Write snapshot to the given file. Returns true if snapshot was written
-  // successfully.
-  static bool WriteToFile(const char* snapshot_file);
+  // Boot the VM, create a context and serialize both. The startup heap is
+  // written to startup_sink and the context to context_sink, and
+  // context_space_used[space] receives the number of bytes the context
+  // takes in each space from FIRST_SPACE to LAST_SPACE. If extra_code is not
+  // NULL it is run in the context before serialization. Serialization must
+  // be enabled before the VM is initialized, so this has to be the first
+  // use of V8 in the process. Returns false if the context could not be
+  // created or extra_code threw.
+  static bool Create(const char* extra_code,
+                     SnapshotByteSink* startup_sink,
+                     SnapshotByteSink* context_sink,
+                     int* context_space_used);
 
   static const byte* data() { return data_; }
   static int size() { return size_; }
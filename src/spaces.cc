@@ -27,6 +27,7 @@
 
 #include "v8.h"
 
+#include "heap-profiler.h"
 #include "macro-assembler.h"
 #include "mark-compact.h"
 #include "platform.h"
@@ -1174,11 +1175,12 @@ void NewSpace::UpdateAllocationInfo() {
   allocation_info_.top = to_space_.page_low();
   allocation_info_.limit = to_space_.page_high();
 
-  // Lower limit during incremental marking.
-  if (heap()->incremental_marking()->IsMarking() &&
-      inline_allocation_limit_step() != 0) {
-    Address new_limit =
-        allocation_info_.top + inline_allocation_limit_step();
+  // Lower limit during incremental marking or allocation sampling.
+  intptr_t step = heap()->incremental_marking()->IsMarking()
+      ? InlineAllocationStep()
+      : allocation_sample_step_;
+  if (step != 0) {
+    Address new_limit = allocation_info_.top + step;
     allocation_info_.limit = Min(new_limit, allocation_info_.limit);
   }
   ASSERT_SEMISPACE_ALLOCATION_INFO(allocation_info_, to_space_);
@@ -1234,16 +1236,28 @@ MaybeObject* NewSpace::SlowAllocateRaw(int size_in_bytes) {
   Address new_top = old_top + size_in_bytes;
   Address high = to_space_.page_high();
   if (allocation_info_.limit < high) {
-    // Incremental marking has lowered the limit to get a
-    // chance to do a step.
-    allocation_info_.limit = Min(
-        allocation_info_.limit + inline_allocation_limit_step_,
-        high);
+    // Incremental marking or the sampling heap profiler has lowered the
+    // limit to get a chance to do a step.
+    intptr_t step = InlineAllocationStep();
+    allocation_info_.limit = (step == 0)
+        ? high
+        : Min(Max(allocation_info_.limit + step, new_top), high);
     int bytes_allocated = static_cast<int>(new_top - top_on_previous_step_);
     heap()->incremental_marking()->Step(
         bytes_allocated, IncrementalMarking::GC_VIA_STACK_GUARD);
     top_on_previous_step_ = new_top;
-    return AllocateRaw(size_in_bytes);
+    MaybeObject* result = AllocateRaw(size_in_bytes);
+    // Objects that did not fit on the current page are reported, if at all,
+    // by the recursive call that moved to a fresh page.
+    if (allocation_sample_step_ != 0 && new_top <= high) {
+      SamplingHeapProfiler* sampler =
+          heap()->isolate()->heap_profiler()->sampling_heap_profiler();
+      HeapObject* object;
+      if (sampler != NULL && result->To(&object)) {
+        sampler->NewSpaceAllocationStep(bytes_allocated, object, size_in_bytes);
+      }
+    }
+    return result;
   } else if (AddFreshPage()) {
     // Switched to new page. Try allocating again.
     int bytes_allocated = static_cast<int>(old_top - top_on_previous_step_);
@@ -2068,7 +2068,8 @@ class NewSpace : public Space {
       to_space_(heap, kToSpace),
       from_space_(heap, kFromSpace),
       reservation_(),
-      inline_allocation_limit_step_(0) {}
+      inline_allocation_limit_step_(0),
+      allocation_sample_step_(0) {}
 
   // Sets up the new space using the given chunk.
   bool SetUp(int reserved_semispace_size_, int max_semispace_size);
@@ -2190,14 +2191,15 @@ class NewSpace : public Space {
 
   void LowerInlineAllocationLimit(intptr_t step) {
     inline_allocation_limit_step_ = step;
-    if (step == 0) {
-      allocation_info_.limit = to_space_.page_high();
-    } else {
-      allocation_info_.limit = Min(
-          allocation_info_.top + inline_allocation_limit_step_,
-          allocation_info_.limit);
-    }
-    top_on_previous_step_ = allocation_info_.top;
+    ResetInlineAllocationLimit();
+  }
+
+  // Lowers the inline allocation limit so that the sampling heap profiler
+  // gets an allocation step within |step| bytes, even when all allocation is
+  // performed from inlined generated code. A step of zero stops sampling.
+  void SetAllocationSampleStep(intptr_t step) {
+    allocation_sample_step_ = step;
+    ResetInlineAllocationLimit();
   }
 
   // Get the extent of the inactive semispace (for use as a marking stack,
@@ -2273,12 +2275,35 @@ class NewSpace : public Space {
     return inline_allocation_limit_step_;
   }
 
+  inline intptr_t allocation_sample_step() {
+    return allocation_sample_step_;
+  }
+
   SemiSpace* active_space() { return &to_space_; }
 
  private:
   // Update allocation info to match the current to-space page.
   void UpdateAllocationInfo();
 
+  // Returns the smaller of the non-zero incremental marking and allocation
+  // sampling steps, or zero if the limit should not be lowered.
+  intptr_t InlineAllocationStep() {
+    if (inline_allocation_limit_step_ == 0) return allocation_sample_step_;
+    if (allocation_sample_step_ == 0) return inline_allocation_limit_step_;
+    return Min(inline_allocation_limit_step_, allocation_sample_step_);
+  }
+
+  void ResetInlineAllocationLimit() {
+    intptr_t step = InlineAllocationStep();
+    if (step == 0) {
+      allocation_info_.limit = to_space_.page_high();
+    } else {
+      allocation_info_.limit = Min(allocation_info_.top + step,
+                                   allocation_info_.limit);
+    }
+    top_on_previous_step_ = allocation_info_.top;
+  }
+
   Address chunk_base_;
   uintptr_t chunk_size_;
 
@@ -2304,6 +2329,10 @@ class NewSpace : public Space {
   // when all allocation is performed from inlined generated code.
   intptr_t inline_allocation_limit_step_;
 
+  // The sampling heap profiler lowers the limit in the same way to observe
+  // allocations at its sampling points.
+  intptr_t allocation_sample_step_;
+
   Address top_on_previous_step_;
 
   HistogramInfo* allocated_histogram_;
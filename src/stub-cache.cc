@@ -1357,6 +1357,19 @@ Handle<Code> StubCompiler::GetCodeWithFlags(Code::Flags flags,
 }
 
 
+bool StubCompiler::IsDoubleField(Handle<JSObject> holder,
+                                 Handle<String> name,
+                                 Handle<Map> transition) {
+  if (!transition.is_null()) {
+    DescriptorArray* descriptors = transition->instance_descriptors();
+    return descriptors->GetDetails(transition->LastAdded()).IsDoubleField();
+  }
+  LookupResult lookup(holder->GetIsolate());
+  holder->LocalLookupRealNamedProperty(*name, &lookup);
+  return lookup.IsField() && lookup.GetPropertyDetails().IsDoubleField();
+}
+
+
 void StubCompiler::LookupPostInterceptor(Handle<JSObject> holder,
                                          Handle<String> name,
                                          LookupResult* lookup) {
@@ -483,6 +483,12 @@ class StubCompiler BASE_EMBEDDED {
                           Register scratch2,
                           Label* miss_label);
 
+  // Returns whether a field stub accesses a double field, whose heap number
+  // loads copy and stores update in place.
+  static bool IsDoubleField(Handle<JSObject> holder,
+                            Handle<String> name,
+                            Handle<Map> transition);
+
   static void GenerateLoadMiss(MacroAssembler* masm,
                                Code::Kind kind);
 
@@ -48,7 +48,12 @@ namespace internal {
   /* Total compilation times. */                                      \
   HT(compile, V8.Compile)                                             \
   HT(compile_eval, V8.CompileEval)                                    \
-  HT(compile_lazy, V8.CompileLazy)
+  HT(compile_lazy, V8.CompileLazy)                                    \
+  /* Register allocation times. */                                    \
+  HT(regalloc_build_live_ranges, V8.RegAllocBuildLiveRanges)          \
+  HT(regalloc_allocate, V8.RegAllocAllocate)                          \
+  HT(regalloc_pointer_maps, V8.RegAllocPointerMaps)                   \
+  HT(regalloc_resolve, V8.RegAllocResolve)
 
 
 #define HISTOGRAM_PERCENTAGE_LIST(HP)                                 \
@@ -123,12 +128,17 @@ namespace internal {
   SC(contexts_created_from_scratch, V8.ContextsCreatedFromScratch)    \
   /* Number of contexts created by partial snapshot. */               \
   SC(contexts_created_by_snapshot, V8.ContextsCreatedBySnapshot)      \
+  /* Number of contexts created by cloning another context. */        \
+  SC(contexts_created_by_cloning, V8.ContextsCreatedByCloning)        \
   /* Number of code objects found from pc. */                         \
   SC(pc_to_code, V8.PcToCode)                                         \
   SC(pc_to_code_cached, V8.PcToCodeCached)                            \
   /* The store-buffer implementation of the write barrier. */         \
   SC(store_buffer_compactions, V8.StoreBufferCompactions)             \
-  SC(store_buffer_overflows, V8.StoreBufferOverflows)
+  SC(store_buffer_overflows, V8.StoreBufferOverflows)                 \
+  /* Code reclaimed by code flushing. */                              \
+  SC(flushed_code_size, V8.FlushedCodeSize)                           \
+  SC(flushed_optimized_code_size, V8.FlushedOptimizedCodeSize)
 
 
 #define STATS_COUNTER_LIST_2(SC)                                      \
@@ -620,6 +620,9 @@ class Assembler : public AssemblerBase {
   static const int kCallInstructionLength = 13;
   static const int kJSReturnSequenceLength = 13;
   static const int kShortCallInstructionLength = 5;
+  // Length of the frame setup that starts a full codegen function.  It is
+  // patched into a short call for code aging.
+  static const int kCodeAgeSequenceLength = 6;
 
   // The debug break slot must be able to contain a call instruction.
   static const int kDebugBreakSlotLength = kCallInstructionLength;
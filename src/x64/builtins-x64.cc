@@ -663,6 +663,29 @@ void Builtins::Generate_NotifyOSR(MacroAssembler* masm) {
 }
 
 
+void Builtins::Generate_MakeCodeYoungAgain(MacroAssembler* masm) {
+  // Called from the old code age sequence at the start of a function, with
+  // the function's arguments in place.  Restoring the young sequence does
+  // not allocate, so the registers can be saved without a frame, and we
+  // return to the start of the function to run the restored sequence.
+  __ subq(Operand(rsp, 0), Immediate(Assembler::kShortCallInstructionLength));
+  __ Pushad();
+#ifdef _WIN64
+  __ movq(rcx, Operand(rsp, kNumSafepointRegisters * kPointerSize));
+#else
+  __ movq(rdi, Operand(rsp, kNumSafepointRegisters * kPointerSize));
+#endif
+  {
+    AllowExternalCallThatCantCauseGC scope(masm);
+    __ PrepareCallCFunction(1);
+    __ CallCFunction(
+        ExternalReference::make_code_young_function(masm->isolate()), 1);
+  }
+  __ Popad();
+  __ ret(0);
+}
+
+
 void Builtins::Generate_FunctionCall(MacroAssembler* masm) {
   // Stack Layout:
   // rsp[0]:   Return address
@@ -577,6 +577,43 @@ void StringCharLoadGenerator::Generate(MacroAssembler* masm,
 
 #undef __
 
+
+// -------------------------------------------------------------------------
+// Code aging
+
+// The frame setup at the start of a full codegen function.
+static const byte kYoungSequence[Assembler::kCodeAgeSequenceLength] = {
+  0x55,              // push rbp
+  0x48, 0x89, 0xe5,  // movq rbp, rsp
+  0x56,              // push rsi
+  0x57               // push rdi
+};
+
+
+bool Code::IsYoungSequence(byte* sequence) {
+  return memcmp(sequence,
+                kYoungSequence,
+                Assembler::kCodeAgeSequenceLength) == 0;
+}
+
+
+bool Code::PatchPlatformCodeAge(byte* sequence, Code* stub) {
+  if (stub == NULL) {
+    memcpy(sequence, kYoungSequence, Assembler::kCodeAgeSequenceLength);
+    CPU::FlushICache(sequence, Assembler::kCodeAgeSequenceLength);
+    return true;
+  }
+  // The builtin is reached with a short call, which needs a 32-bit
+  // displacement.
+  intptr_t displacement = stub->instruction_start() -
+      (sequence + Assembler::kShortCallInstructionLength);
+  if (!is_int32(displacement)) return false;
+  CodePatcher patcher(sequence, Assembler::kCodeAgeSequenceLength);
+  patcher.masm()->call(stub->instruction_start());
+  patcher.masm()->nop();
+  return true;
+}
+
 } }  // namespace v8::internal
 
 #endif  // V8_TARGET_ARCH_X64
@@ -364,7 +364,7 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   if (environment == NULL) return;
 
   // The translation includes one command per value in the environment.
-  int translation_size = environment->values()->length();
+  int translation_size = environment->translation_size();
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
@@ -388,6 +388,21 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   }
   for (int i = 0; i < translation_size; ++i) {
     LOperand* value = environment->values()->at(i);
+    const LEnvironment::CapturedObject* captured =
+        environment->CapturedObjectAt(i);
+    if (captured != NULL) {
+      translation->StoreCapturedObject(
+          DefineDeoptimizationLiteral(captured->map),
+          captured->id,
+          captured->field_count);
+      for (int j = 0; j < captured->field_count; ++j) {
+        int field = captured->first_field + j;
+        AddToTranslation(translation,
+                         environment->values()->at(field),
+                         environment->HasTaggedValueAt(field));
+      }
+      continue;
+    }
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
     if (environment->spilled_registers() != NULL && value != NULL) {
@@ -2329,6 +2344,20 @@ void LCodeGen::DoStoreContextSlot(LStoreContextSlot* instr) {
 }
 
 
+void LCodeGen::DoLoadNamedDoubleField(LLoadNamedDoubleField* instr) {
+  Register object = ToRegister(instr->InputAt(0));
+  XMMRegister result = ToDoubleRegister(instr->result());
+  Register scratch = kScratchRegister;
+  if (instr->hydrogen()->is_in_object()) {
+    __ movq(scratch, FieldOperand(object, instr->hydrogen()->offset()));
+  } else {
+    __ movq(scratch, FieldOperand(object, JSObject::kPropertiesOffset));
+    __ movq(scratch, FieldOperand(scratch, instr->hydrogen()->offset()));
+  }
+  __ movsd(result, FieldOperand(scratch, HeapNumber::kValueOffset));
+}
+
+
 void LCodeGen::DoLoadNamedField(LLoadNamedField* instr) {
   Register object = ToRegister(instr->InputAt(0));
   Register result = ToRegister(instr->result());
@@ -3255,6 +3284,102 @@ void LCodeGen::DoMathPowHalf(LUnaryMathOperation* instr) {
 }
 
 
+void LCodeGen::DoCallFastApiFunction(LCallFastApiFunction* instr) {
+  HCallFastApiFunction* hinstr = instr->hydrogen();
+  int parameter_count = instr->InputCount();
+
+  // Check all tagged parameters before any of them is converted so that
+  // the deoptimization environment still sees the original values.
+  for (int i = 0; i < parameter_count; i++) {
+    FastCallType type = hinstr->ParameterTypeAt(i);
+    if (type == FAST_CALL_EXTERNAL) {
+      Register reg = ToRegister(instr->InputAt(i));
+      Label done;
+      __ JumpIfSmi(reg, &done);
+      __ CmpObjectType(reg, FOREIGN_TYPE, kScratchRegister);
+      DeoptimizeIf(not_equal, instr->environment());
+      __ bind(&done);
+    } else if (type == FAST_CALL_BOOL) {
+      Register reg = ToRegister(instr->InputAt(i));
+      Label done;
+      __ CompareRoot(reg, Heap::kTrueValueRootIndex);
+      __ j(equal, &done, Label::kNear);
+      __ CompareRoot(reg, Heap::kFalseValueRootIndex);
+      DeoptimizeIf(not_equal, instr->environment());
+      __ bind(&done);
+    }
+  }
+
+  // Convert the tagged parameters to their C representation and move the
+  // parameters that were kept out of rsi and xmm0 into place.
+  int double_count = 0;
+  for (int i = 0; i < parameter_count; i++) {
+    FastCallType type = hinstr->ParameterTypeAt(i);
+    if (type == FAST_CALL_DOUBLE) {
+      XMMRegister target =
+          LCallFastApiFunction::DoubleParameterRegister(i, double_count++);
+      XMMRegister reg = ToDoubleRegister(instr->InputAt(i));
+      ASSERT(reg.code() == target.code() + 1);
+      __ movsd(target, reg);
+      continue;
+    }
+    Register reg = ToRegister(instr->InputAt(i));
+    if (type == FAST_CALL_EXTERNAL) {
+      // Aligned pointers are stored as smis, see v8::External.
+      Label is_foreign, done;
+      __ JumpIfNotSmi(reg, &is_foreign, Label::kNear);
+      __ shr(reg, Immediate(kPointerToSmiShift));
+      __ jmp(&done, Label::kNear);
+      __ bind(&is_foreign);
+      __ movq(reg, FieldOperand(reg, Foreign::kForeignAddressOffset));
+      __ bind(&done);
+    } else if (type == FAST_CALL_BOOL) {
+      Label done;
+      __ CompareRoot(reg, Heap::kTrueValueRootIndex);
+      __ movl(reg, Immediate(1));
+      __ j(equal, &done, Label::kNear);
+      __ movl(reg, Immediate(0));
+      __ bind(&done);
+    }
+#ifndef _WIN64
+    if (reg.is(r8)) __ movq(rsi, r8);
+#endif
+  }
+
+  ApiFunction function(hinstr->callback());
+  __ PrepareCallCFunction(parameter_count);
+  __ CallCFunction(ExternalReference(&function,
+                                     ExternalReference::BUILTIN_CALL,
+                                     isolate()),
+                   parameter_count);
+  __ movq(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
+
+  switch (hinstr->return_type()) {
+    case FAST_CALL_INT32:
+      ASSERT(ToRegister(instr->result()).is(rax));
+      break;
+    case FAST_CALL_DOUBLE:
+      ASSERT(ToDoubleRegister(instr->result()).is(xmm1));
+      __ movaps(xmm1, xmm0);
+      break;
+    case FAST_CALL_BOOL: {
+      Label done;
+      __ testb(rax, rax);
+      __ LoadRoot(rax, Heap::kTrueValueRootIndex);
+      __ j(not_zero, &done, Label::kNear);
+      __ LoadRoot(rax, Heap::kFalseValueRootIndex);
+      __ bind(&done);
+      break;
+    }
+    case FAST_CALL_VOID:
+      __ LoadRoot(rax, Heap::kUndefinedValueRootIndex);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+
 void LCodeGen::DoPower(LPower* instr) {
   Representation exponent_type = instr->hydrogen()->right()->representation();
   // Having marked this as a call, we can use any registers.
@@ -3382,6 +3507,115 @@ void LCodeGen::DoDeferredRandom(LRandom* instr) {
 }
 
 
+void LCodeGen::DoOrderedHashTableLookup(LOrderedHashTableLookup* instr) {
+  class DeferredOrderedHashTableLookup: public LDeferredCode {
+   public:
+    DeferredOrderedHashTableLookup(LCodeGen* codegen,
+                                   LOrderedHashTableLookup* instr)
+        : LDeferredCode(codegen), instr_(instr) { }
+    virtual void Generate() {
+      codegen()->DoDeferredOrderedHashTableLookup(instr_);
+    }
+    virtual LInstruction* instr() { return instr_; }
+   private:
+    LOrderedHashTableLookup* instr_;
+  };
+
+  DeferredOrderedHashTableLookup* deferred =
+      new(zone()) DeferredOrderedHashTableLookup(this, instr);
+  HOrderedHashTableLookup* hinstr = instr->hydrogen();
+  Register table = ToRegister(instr->table());
+  Register key = ToRegister(instr->key());
+  Register result = ToRegister(instr->result());
+  Register temp = ToRegister(instr->temp());
+  // Both tables share the header layout.
+  const int kBucketsOffset = FixedArray::OffsetOfElementAt(
+      OrderedHashSet::kNumberOfBucketsIndex);
+  const int kStartOffset = FixedArray::OffsetOfElementAt(
+      OrderedHashSet::kHashTableStartIndex);
+
+  // The table is undefined until the collection has been initialized.
+  __ CompareRoot(FieldOperand(table, HeapObject::kMapOffset),
+                 Heap::kFixedArrayMapRootIndex);
+  DeoptimizeIf(not_equal, instr->environment());
+
+  // Compute the hash of the key into result.  Only smis and symbols are
+  // handled here, other keys need to be normalized by the runtime first.
+  Label symbol_key, compute_bucket;
+  __ JumpIfNotSmi(key, &symbol_key, Label::kNear);
+  __ SmiToInteger32(result, key);
+  __ GetNumberHash(result, temp);
+  __ jmp(&compute_bucket, Label::kNear);
+
+  __ bind(&symbol_key);
+  __ movq(result, FieldOperand(key, HeapObject::kMapOffset));
+  __ movzxbl(result, FieldOperand(result, Map::kInstanceTypeOffset));
+  __ andb(result, Immediate(kIsSymbolMask | kIsNotStringMask));
+  __ cmpb(result, Immediate(kSymbolTag | kStringTag));
+  __ j(not_equal, deferred->entry());
+  __ movl(result, FieldOperand(key, String::kHashFieldOffset));
+  __ shrl(result, Immediate(String::kHashShift));
+
+  // Load the first entry of the bucket chain.  temp holds the number of
+  // buckets, which is the offset of the entries from the bucket heads.
+  __ bind(&compute_bucket);
+  __ SmiToInteger32(temp, FieldOperand(table, kBucketsOffset));
+  __ decl(temp);
+  __ andl(result, temp);
+  __ incl(temp);
+  __ movq(result,
+          FieldOperand(table, result, times_pointer_size, kStartOffset));
+
+  // Walk the chain.  Table keys are normalized, so smis and symbols can be
+  // compared by identity.
+  Label loop, found, not_found, done;
+  __ bind(&loop);
+  __ Cmp(result, Smi::FromInt(OrderedHashSet::kNotFound));
+  __ j(equal, &not_found, Label::kNear);
+  __ SmiToInteger32(result, result);
+  __ imull(result, result, Immediate(hinstr->entry_size()));
+  __ addl(result, temp);
+  __ cmpq(key, FieldOperand(table, result, times_pointer_size, kStartOffset));
+  __ j(equal, &found, Label::kNear);
+  __ movq(result,
+          FieldOperand(table, result, times_pointer_size,
+                       kStartOffset + hinstr->chain_offset() * kPointerSize));
+  __ jmp(&loop);
+
+  __ bind(&found);
+  if (hinstr->loads_value()) {
+    __ movq(result,
+            FieldOperand(table, result, times_pointer_size,
+                         kStartOffset +
+                         OrderedHashMap::kValueOffset * kPointerSize));
+  } else {
+    __ LoadRoot(result, Heap::kTrueValueRootIndex);
+  }
+  __ jmp(&done, Label::kNear);
+
+  __ bind(&not_found);
+  __ LoadRoot(result, hinstr->loads_value() ? Heap::kUndefinedValueRootIndex
+                                            : Heap::kFalseValueRootIndex);
+  __ bind(&done);
+  __ bind(deferred->exit());
+}
+
+
+void LCodeGen::DoDeferredOrderedHashTableLookup(
+    LOrderedHashTableLookup* instr) {
+  Register result = ToRegister(instr->result());
+
+  // The result register is in the pointer map but holds a hash here.
+  __ Set(result, 0);
+
+  PushSafepointRegistersScope scope(this);
+  __ push(ToRegister(instr->receiver()));
+  __ push(ToRegister(instr->key()));
+  CallRuntimeFromDeferred(instr->hydrogen()->runtime_function(), 2, instr);
+  __ StoreToSafepointRegisterSlot(result, rax);
+}
+
+
 void LCodeGen::DoMathLog(LUnaryMathOperation* instr) {
   ASSERT(ToDoubleRegister(instr->result()).is(xmm1));
   TranscendentalCacheStub stub(TranscendentalCache::LOG,
@@ -3544,6 +3778,20 @@ void LCodeGen::DoCallRuntime(LCallRuntime* instr) {
 }
 
 
+void LCodeGen::DoStoreNamedDoubleField(LStoreNamedDoubleField* instr) {
+  Register object = ToRegister(instr->object());
+  XMMRegister value = ToDoubleRegister(instr->value());
+  Register scratch = kScratchRegister;
+  if (instr->is_in_object()) {
+    __ movq(scratch, FieldOperand(object, instr->offset()));
+  } else {
+    __ movq(scratch, FieldOperand(object, JSObject::kPropertiesOffset));
+    __ movq(scratch, FieldOperand(scratch, instr->offset()));
+  }
+  __ movsd(FieldOperand(scratch, HeapNumber::kValueOffset), value);
+}
+
+
 void LCodeGen::DoStoreNamedField(LStoreNamedField* instr) {
   Register object = ToRegister(instr->object());
   Register value = ToRegister(instr->value());
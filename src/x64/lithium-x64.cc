@@ -376,6 +376,15 @@ LOperand* LPlatformChunk::GetNextSpillSlot(bool is_double) {
 }
 
 
+void LStoreNamedDoubleField::PrintDataTo(StringStream* stream) {
+  object()->PrintTo(stream);
+  stream->Add(".");
+  stream->Add(*String::cast(*name())->ToCString());
+  stream->Add(" <- ");
+  value()->PrintTo(stream);
+}
+
+
 void LStoreNamedField::PrintDataTo(StringStream* stream) {
   object()->PrintTo(stream);
   stream->Add(".");
@@ -863,13 +872,20 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
   ASSERT(!ast_id.IsNone() ||
          hydrogen_env->frame_type() != JS_FUNCTION);
   int value_count = hydrogen_env->length();
+  int field_count = 0;
+  for (int i = 0; i < value_count; ++i) {
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      field_count += HCapturedObject::cast(value)->field_count();
+    }
+  }
   LEnvironment* result = new(zone()) LEnvironment(
       hydrogen_env->closure(),
       hydrogen_env->frame_type(),
       ast_id,
       hydrogen_env->parameter_count(),
       argument_count_,
-      value_count,
+      value_count + field_count,
       outer,
       zone());
   int argument_index = *argument_index_accumulator;
@@ -878,7 +894,7 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
 
     HValue* value = hydrogen_env->values()->at(i);
     LOperand* op = NULL;
-    if (value->IsArgumentsObject()) {
+    if (value->IsArgumentsObject() || value->IsCapturedObject()) {
       op = NULL;
     } else if (value->IsPushArgument()) {
       op = new(zone()) LArgument(argument_index++);
@@ -888,6 +904,26 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
     result->AddValue(op, value->representation());
   }
 
+  // The fields of captured objects follow the values of the frame.
+  int index = 0;
+  for (int i = 0; i < value_count; ++i) {
+    if (hydrogen_env->is_special_index(i)) continue;
+    HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      HCapturedObject* object = HCapturedObject::cast(value);
+      result->AddCapturedObject(index,
+                                object->map(),
+                                object->id(),
+                                object->field_count());
+      for (int j = 0; j < object->field_count(); ++j) {
+        HValue* field = object->FieldAt(j);
+        ASSERT(field->representation().IsTagged());
+        result->AddValue(UseAny(field), field->representation());
+      }
+    }
+    ++index;
+  }
+
   if (hydrogen_env->frame_type() == JS_FUNCTION) {
     *argument_index_accumulator = argument_index;
   }
@@ -1027,6 +1063,77 @@ LInstruction* LChunkBuilder::DoCallConstantFunction(
 }
 
 
+Register LCallFastApiFunction::IntegerParameterRegister(int index,
+                                                       int ordinal) {
+#ifdef _WIN64
+  switch (index) {
+    case 0: return rcx;
+    case 1: return rdx;
+    case 2: return r8;
+    case 3: return r9;
+  }
+#else
+  switch (ordinal) {
+    case 0: return rdi;
+    case 1: return rsi;
+    case 2: return rdx;
+    case 3: return rcx;
+  }
+#endif
+  UNREACHABLE();
+  return no_reg;
+}
+
+
+XMMRegister LCallFastApiFunction::DoubleParameterRegister(int index,
+                                                          int ordinal) {
+#ifdef _WIN64
+  return XMMRegister::from_code(index);
+#else
+  return XMMRegister::from_code(ordinal);
+#endif
+}
+
+
+LInstruction* LChunkBuilder::DoCallFastApiFunction(
+    HCallFastApiFunction* instr) {
+  // The parameters are fixed to the registers the C calling convention
+  // expects them in, except for rsi and xmm0 which are not allocatable.
+  // Double parameters are shifted up by one register and moved into
+  // place by the code generator, and the parameter passed in rsi is
+  // taken in r8, which is not used for integer parameters in this case.
+  int input_count = instr->OperandCount();
+  LCallFastApiFunction* result =
+      new(zone()) LCallFastApiFunction(input_count);
+  int integer_count = 0;
+  int double_count = 0;
+  for (int i = 0; i < input_count; i++) {
+    LOperand* operand;
+    if (instr->ParameterTypeAt(i) == FAST_CALL_DOUBLE) {
+      XMMRegister reg =
+          LCallFastApiFunction::DoubleParameterRegister(i, double_count++);
+      operand = UseFixedDouble(instr->OperandAt(i),
+                               XMMRegister::from_code(reg.code() + 1));
+    } else {
+      Register reg =
+          LCallFastApiFunction::IntegerParameterRegister(i, integer_count++);
+      operand = UseFixed(instr->OperandAt(i), reg.is(rsi) ? r8 : reg);
+    }
+    result->set_input(i, operand);
+  }
+  LInstruction* call;
+  switch (instr->return_type()) {
+    case FAST_CALL_DOUBLE:
+      call = DefineFixedDouble(result, xmm1);
+      break;
+    default:
+      call = DefineFixed(result, rax);
+      break;
+  }
+  return MarkAsCall(call, instr, CAN_DEOPTIMIZE_EAGERLY);
+}
+
+
 LInstruction* LChunkBuilder::DoInvokeFunction(HInvokeFunction* instr) {
   LOperand* function = UseFixed(instr->function(), rdi);
   argument_count_ -= instr->argument_count();
@@ -1383,6 +1490,18 @@ LInstruction* LChunkBuilder::DoRandom(HRandom* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoOrderedHashTableLookup(
+    HOrderedHashTableLookup* instr) {
+  LOperand* receiver = UseRegister(instr->receiver());
+  LOperand* table = UseRegister(instr->table());
+  LOperand* key = UseRegister(instr->key());
+  LOperand* temp = TempRegister();
+  LOrderedHashTableLookup* result =
+      new(zone()) LOrderedHashTableLookup(receiver, table, key, temp);
+  return AssignEnvironment(AssignPointerMap(DefineAsRegister(result)));
+}
+
+
 LInstruction* LChunkBuilder::DoCompareGeneric(HCompareGeneric* instr) {
   ASSERT(instr->left()->representation().IsTagged());
   ASSERT(instr->right()->representation().IsTagged());
@@ -1781,6 +1900,13 @@ LInstruction* LChunkBuilder::DoStoreContextSlot(HStoreContextSlot* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoLoadNamedDoubleField(
+    HLoadNamedDoubleField* instr) {
+  return DefineAsRegister(
+      new(zone()) LLoadNamedDoubleField(UseRegisterAtStart(instr->object())));
+}
+
+
 LInstruction* LChunkBuilder::DoLoadNamedField(HLoadNamedField* instr) {
   ASSERT(instr->representation().IsTagged());
   LOperand* obj = UseRegisterAtStart(instr->object());
@@ -2008,6 +2134,14 @@ LInstruction* LChunkBuilder::DoTransitionElementsKind(
 }
 
 
+LInstruction* LChunkBuilder::DoStoreNamedDoubleField(
+    HStoreNamedDoubleField* instr) {
+  LOperand* obj = UseRegisterAtStart(instr->object());
+  LOperand* val = UseRegisterAtStart(instr->value());
+  return new(zone()) LStoreNamedDoubleField(obj, val);
+}
+
+
 LInstruction* LChunkBuilder::DoStoreNamedField(HStoreNamedField* instr) {
   bool needs_write_barrier = instr->NeedsWriteBarrier();
   bool needs_write_barrier_for_map = !instr->transition().is_null() &&
@@ -2152,6 +2286,17 @@ LInstruction* LChunkBuilder::DoArgumentsObject(HArgumentsObject* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoCapturedObject(HCapturedObject* instr) {
+  // Captured objects only exist in deoptimization environments, where each
+  // new state of the object replaces the previous one.
+  if (instr->previous_state() != NULL) {
+    current_block_->last_environment()->ReplaceValue(instr->previous_state(),
+                                                     instr);
+  }
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoAccessArgumentsAt(HAccessArgumentsAt* instr) {
   LOperand* arguments = UseRegister(instr->arguments());
   LOperand* length = UseTempRegister(instr->length());
@@ -61,6 +61,7 @@ class LCodeGen;
   V(BoundsCheck)                                \
   V(Branch)                                     \
   V(CallConstantFunction)                       \
+  V(CallFastApiFunction)                        \
   V(CallFunction)                               \
   V(CallGlobal)                                 \
   V(CallKeyed)                                  \
@@ -128,6 +129,7 @@ class LCodeGen;
   V(LoadKeyedFastElement)                       \
   V(LoadKeyedGeneric)                           \
   V(LoadKeyedSpecializedArrayElement)           \
+  V(LoadNamedDoubleField)                       \
   V(LoadNamedField)                             \
   V(LoadNamedFieldPolymorphic)                  \
   V(LoadNamedGeneric)                           \
@@ -139,6 +141,7 @@ class LCodeGen;
   V(NumberTagI)                                 \
   V(NumberUntagD)                               \
   V(ObjectLiteral)                              \
+  V(OrderedHashTableLookup)                     \
   V(OsrEntry)                                   \
   V(OuterContext)                               \
   V(Parameter)                                  \
@@ -158,6 +161,7 @@ class LCodeGen;
   V(StoreKeyedFastElement)                      \
   V(StoreKeyedGeneric)                          \
   V(StoreKeyedSpecializedArrayElement)          \
+  V(StoreNamedDoubleField)                      \
   V(StoreNamedField)                            \
   V(StoreNamedGeneric)                          \
   V(StringAdd)                                  \
@@ -1100,6 +1104,29 @@ class LRandom: public LTemplateInstruction<1, 1, 0> {
 };
 
 
+class LOrderedHashTableLookup: public LTemplateInstruction<1, 3, 1> {
+ public:
+  LOrderedHashTableLookup(LOperand* receiver,
+                          LOperand* table,
+                          LOperand* key,
+                          LOperand* temp) {
+    inputs_[0] = receiver;
+    inputs_[1] = table;
+    inputs_[2] = key;
+    temps_[0] = temp;
+  }
+
+  LOperand* receiver() { return inputs_[0]; }
+  LOperand* table() { return inputs_[1]; }
+  LOperand* key() { return inputs_[2]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(OrderedHashTableLookup,
+                               "ordered-hash-table-lookup")
+  DECLARE_HYDROGEN_ACCESSOR(OrderedHashTableLookup)
+};
+
+
 class LArithmeticD: public LTemplateInstruction<1, 2, 0> {
  public:
   LArithmeticD(Token::Value op, LOperand* left, LOperand* right)
@@ -1148,6 +1175,17 @@ class LReturn: public LTemplateInstruction<0, 1, 0> {
 };
 
 
+class LLoadNamedDoubleField: public LTemplateInstruction<1, 1, 0> {
+ public:
+  explicit LLoadNamedDoubleField(LOperand* object) {
+    inputs_[0] = object;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LoadNamedDoubleField, "load-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(LoadNamedDoubleField)
+};
+
+
 class LLoadNamedField: public LTemplateInstruction<1, 1, 0> {
  public:
   explicit LLoadNamedField(LOperand* object) {
@@ -1461,6 +1499,28 @@ class LCallConstantFunction: public LTemplateInstruction<1, 0, 0> {
 };
 
 
+class LCallFastApiFunction: public LTemplateInstruction<
+    1, FunctionTemplateInfo::kMaxFastCallParameters, 0> {
+ public:
+  explicit LCallFastApiFunction(int input_count)
+      : input_count_(input_count) { }
+
+  int InputCount() { return input_count_; }
+  void set_input(int index, LOperand* operand) { inputs_[index] = operand; }
+
+  // The C calling convention passes the parameter at 'index', which is the
+  // 'ordinal'-th integer or double parameter, in these registers.
+  static Register IntegerParameterRegister(int index, int ordinal);
+  static XMMRegister DoubleParameterRegister(int index, int ordinal);
+
+  DECLARE_CONCRETE_INSTRUCTION(CallFastApiFunction, "call-fast-api-function")
+  DECLARE_HYDROGEN_ACCESSOR(CallFastApiFunction)
+
+ private:
+  int input_count_;
+};
+
+
 class LInvokeFunction: public LTemplateInstruction<1, 1, 0> {
  public:
   explicit LInvokeFunction(LOperand* function) {
@@ -1691,6 +1751,28 @@ class LStoreNamedField: public LTemplateInstruction<0, 2, 1> {
 };
 
 
+class LStoreNamedDoubleField: public LTemplateInstruction<0, 2, 0> {
+ public:
+  LStoreNamedDoubleField(LOperand* obj, LOperand* val) {
+    inputs_[0] = obj;
+    inputs_[1] = val;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreNamedDoubleField,
+                               "store-named-double-field")
+  DECLARE_HYDROGEN_ACCESSOR(StoreNamedDoubleField)
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  LOperand* object() { return inputs_[0]; }
+  LOperand* value() { return inputs_[1]; }
+
+  Handle<Object> name() const { return hydrogen()->name(); }
+  bool is_in_object() { return hydrogen()->is_in_object(); }
+  int offset() { return hydrogen()->offset(); }
+};
+
+
 class LStoreNamedGeneric: public LTemplateInstruction<0, 2, 0> {
  public:
   LStoreNamedGeneric(LOperand* object, LOperand* value) {
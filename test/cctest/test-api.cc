@@ -17115,3 +17115,509 @@ THREADED_TEST(Regress137496) {
   CompileRun("try { throw new Error(); } finally { gc(); }");
   CHECK(try_catch.HasCaught());
 }
+
+
+TEST(OptimizationProfile) {
+  v8::HandleScope scope;
+  LocalContext context;
+
+  CHECK(v8::V8::LoadOptimizationProfile(v8_str("")));
+  CHECK_EQ(0, v8::V8::GetOptimizationProfile()->Length());
+
+  CHECK(v8::V8::LoadOptimizationProfile(v8_str("0a1b2c3d 42\n00000001 7\n")));
+  v8::String::AsciiValue profile(v8::V8::GetOptimizationProfile());
+  CHECK_EQ("00000001 7\n0a1b2c3d 42\n", *profile);
+
+  // Malformed profiles are rejected and keep the loaded one.
+  CHECK(!v8::V8::LoadOptimizationProfile(v8_str("0a1b2c3d\n")));
+  CHECK(!v8::V8::LoadOptimizationProfile(v8_str("0a1b2c3d 42")));
+  CHECK(!v8::V8::LoadOptimizationProfile(v8_str("123456789 1\n")));
+  CHECK(!v8::V8::LoadOptimizationProfile(v8_str("xyz 1\n")));
+  v8::String::AsciiValue unchanged(v8::V8::GetOptimizationProfile());
+  CHECK_EQ("00000001 7\n0a1b2c3d 42\n", *unchanged);
+}
+
+
+static void RunNativesInNewContext() {
+  v8::HandleScope scope;
+  LocalContext context;
+  ExpectString("[3, 1, 2].sort().join('-')", "1-2-3");
+  ExpectString("'a,b'.split(',').reverse().join()", "b,a");
+  ExpectString("JSON.stringify({x: [1, 'y']})", "{\"x\":[1,\"y\"]}");
+  ExpectString("/(\\d+)/.exec('ab12')[1]", "12");
+  ExpectInt32("new Date(0).getUTCFullYear()", 1970);
+}
+
+
+TEST(LazyNativesSharedBetweenIsolates) {
+  // The natives are preparsed once and the data is reused by every context
+  // and every isolate.
+  i::FLAG_lazy_natives = true;
+  RunNativesInNewContext();
+  RunNativesInNewContext();
+
+  v8::Isolate* isolate = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    RunNativesInNewContext();
+  }
+  isolate->Dispose();
+}
+
+
+static v8::Handle<Value> NativeAnswer(const v8::Arguments& args) {
+  return v8::Integer::New(42);
+}
+
+
+static int RunInContext(v8::Handle<Context> context, const char* source) {
+  Context::Scope context_scope(context);
+  return CompileRun(source)->Int32Value();
+}
+
+
+THREADED_TEST(CloneContext) {
+  v8::HandleScope handle_scope;
+  Local<ObjectTemplate> global_template = ObjectTemplate::New();
+  global_template->Set(v8_str("answer"),
+                       v8::FunctionTemplate::New(NativeAnswer));
+  v8::Persistent<Context> context = Context::New(0, global_template);
+  RunInContext(context,
+               "var counter = 0;"
+               "function bump() { return ++counter; }"
+               "var obj = { x: 1 };"
+               "Array.prototype.extra = 1;");
+
+  v8::Persistent<Context> clone = context->Clone();
+  CHECK(!clone.IsEmpty());
+  CHECK_EQ(42, RunInContext(clone, "answer()"));
+  CHECK_EQ(1, RunInContext(clone, "bump()"));
+  CHECK_EQ(2, RunInContext(clone, "bump()"));
+  CHECK_EQ(2, RunInContext(clone, "obj.x = 2"));
+  CHECK_EQ(3, RunInContext(clone, "Array.prototype.extra = 3"));
+  CHECK_EQ(1, RunInContext(clone, "(([] instanceof Array) && "
+                                  "Object.getPrototypeOf(obj) === "
+                                  "Object.prototype) ? 1 : 0"));
+
+  HEAP->CollectAllGarbage(i::Heap::kNoGCFlags);
+
+  // The original context is not affected by changes to the clone.
+  CHECK_EQ(1, RunInContext(context, "bump()"));
+  CHECK_EQ(1, RunInContext(context, "obj.x"));
+  CHECK_EQ(1, RunInContext(context, "[].extra"));
+  CHECK_EQ(42, RunInContext(context, "answer()"));
+
+  // And the clone keeps its own state.
+  CHECK_EQ(3, RunInContext(clone, "bump()"));
+  CHECK_EQ(2, RunInContext(clone, "obj.x"));
+  CHECK_EQ(3, RunInContext(clone, "[].extra"));
+
+  clone.Dispose();
+  context.Dispose();
+}
+
+
+THREADED_TEST(CloneContextNewSpaceValues) {
+  v8::HandleScope handle_scope;
+  v8::Persistent<Context> context = Context::New();
+  RunInContext(context,
+               "var str = ['new', 'space', 'string'].join(' ');"
+               "var num = Math.sqrt(2) * 3;"
+               "var holder = { str: str.toUpperCase(), num: num + 0.5 };"
+               "function Point(x) { this.x = x; }"
+               "var point = new Point(str);");
+  {
+    Context::Scope context_scope(context);
+    i::Handle<i::Object> str =
+        v8::Utils::OpenHandle(*context->Global()->Get(v8_str("str")));
+    i::Handle<i::Object> num =
+        v8::Utils::OpenHandle(*context->Global()->Get(v8_str("num")));
+    CHECK(str->IsString() && HEAP->InNewSpace(*str));
+    CHECK(num->IsHeapNumber() && HEAP->InNewSpace(*num));
+  }
+
+  // The copies live in old space and still refer to the new space values,
+  // which only survive the scavenges if the copies are in the store buffer.
+  v8::Persistent<Context> clone = context->Clone();
+  context.Dispose();
+  HEAP->CollectGarbage(i::NEW_SPACE);
+  HEAP->CollectGarbage(i::NEW_SPACE);
+
+  CHECK_EQ(1, RunInContext(clone, "str === 'new space string' ? 1 : 0"));
+  CHECK_EQ(1, RunInContext(clone, "num === Math.sqrt(2) * 3 ? 1 : 0"));
+  CHECK_EQ(1, RunInContext(clone, "holder.str === 'NEW SPACE STRING' ? 1 : 0"));
+  CHECK_EQ(1, RunInContext(clone, "holder.num === num + 0.5 ? 1 : 0"));
+  CHECK_EQ(1, RunInContext(clone, "point.x === str ? 1 : 0"));
+
+  // Point's in-object slack tracking can still be in progress in the copy,
+  // finishing it must leave the copied map and instances intact.
+  CHECK_EQ(20, RunInContext(clone,
+                            "var points = [];"
+                            "for (var i = 0; i < 20; i++) {"
+                            "  points.push(new Point(i));"
+                            "  points[i].y = i;"
+                            "}"
+                            "points[19].x + 1"));
+  HEAP->CollectAllGarbage(i::Heap::kNoGCFlags);
+  CHECK_EQ(19, RunInContext(clone, "points[19].y"));
+  CHECK_EQ(1, RunInContext(clone, "point instanceof Point ? 1 : 0"));
+
+  clone.Dispose();
+}
+
+
+static double RandomInContext(v8::Handle<Context> context) {
+  Context::Scope context_scope(context);
+  return CompileRun("Math.random()")->NumberValue();
+}
+
+
+THREADED_TEST(CloneContextRandomSeed) {
+  v8::HandleScope handle_scope;
+  v8::Persistent<Context> context = Context::New();
+  // Seed the original before cloning it.
+  RandomInContext(context);
+
+  v8::Persistent<Context> first = context->Clone();
+  v8::Persistent<Context> second = context->Clone();
+  bool all_equal = true;
+  for (int i = 0; i < 5; i++) {
+    double original_value = RandomInContext(context);
+    double first_value = RandomInContext(first);
+    double second_value = RandomInContext(second);
+    if (first_value != second_value || first_value != original_value) {
+      all_equal = false;
+    }
+  }
+  // Each clone has its own state, so the sequences do not follow each
+  // other.
+  CHECK(!all_equal);
+
+  second.Dispose();
+  first.Dispose();
+  context.Dispose();
+}
+
+
+THREADED_TEST(CloneContextExternalArray) {
+  v8::HandleScope handle_scope;
+  v8::Persistent<Context> context = Context::New();
+  static uint8_t data[4] = { 1, 2, 3, 4 };
+  {
+    Context::Scope context_scope(context);
+    v8::Handle<v8::Object> obj = v8::Object::New();
+    obj->SetIndexedPropertiesToExternalArrayData(
+        data, v8::kExternalUnsignedByteArray, 4);
+    context->Global()->Set(v8_str("bytes"), obj);
+  }
+
+  v8::Persistent<Context> clone = context->Clone();
+  CHECK_EQ(3, RunInContext(clone, "bytes[2]"));
+  CHECK_EQ(9, RunInContext(clone, "bytes[2] = 9; bytes[2]"));
+  CHECK_EQ(3, data[2]);
+  CHECK_EQ(3, RunInContext(context, "bytes[2]"));
+
+  // The copied backing store is released with the clone.
+  clone.Dispose();
+  HEAP->CollectAllGarbage(i::Heap::kNoGCFlags);
+  context.Dispose();
+}
+
+
+static const char* kOptimizedDoubleStore =
+    "function store(o, v) { o.x = v; }"
+    "store(dummy, 1.5); store(dummy, 2.5);"
+    "%OptimizeFunctionOnNextCall(store);";
+
+
+// Optimized code updates the heap number of a double field in place, so
+// no two objects may share it.
+TEST(DoubleFieldBoxesAreNotShared) {
+  bool saved_track_double_fields = i::FLAG_track_double_fields;
+  bool saved_allow_natives_syntax = i::FLAG_allow_natives_syntax;
+  i::FLAG_track_double_fields = true;
+  i::FLAG_allow_natives_syntax = true;
+  v8::HandleScope handle_scope;
+
+  // Template instances made from one boilerplate.
+  {
+    LocalContext env;
+    Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New();
+    templ->InstanceTemplate()->Set(v8_str("x"), v8_num(1.5));
+    Local<v8::Function> fun = templ->GetFunction();
+    env->Global()->Set(v8_str("a"), fun->NewInstance());
+    env->Global()->Set(v8_str("b"), fun->NewInstance());
+    env->Global()->Set(v8_str("dummy"), fun->NewInstance());
+    CompileRun(kOptimizedDoubleStore);
+    CompileRun("store(a, 3.5)");
+    CHECK_EQ(3.5, CompileRun("a.x")->NumberValue());
+    CHECK_EQ(1.5, CompileRun("b.x")->NumberValue());
+  }
+
+  // Cloned contexts.
+  v8::Persistent<Context> context = Context::New();
+  {
+    Context::Scope context_scope(context);
+    CompileRun("var obj = {}; obj.x = 1.5;"
+               "var dummy = {}; dummy.x = 0.5;");
+  }
+  v8::Persistent<Context> first = context->Clone();
+  v8::Persistent<Context> second = context->Clone();
+  {
+    Context::Scope context_scope(first);
+    CompileRun(kOptimizedDoubleStore);
+    CompileRun("store(obj, 3.5)");
+    CHECK_EQ(3.5, CompileRun("obj.x")->NumberValue());
+  }
+  {
+    Context::Scope context_scope(second);
+    CHECK_EQ(1.5, CompileRun("obj.x")->NumberValue());
+    CompileRun(kOptimizedDoubleStore);
+    CompileRun("store(obj, 4.5)");
+    CHECK_EQ(4.5, CompileRun("obj.x")->NumberValue());
+  }
+  {
+    Context::Scope context_scope(first);
+    CHECK_EQ(3.5, CompileRun("obj.x")->NumberValue());
+  }
+  {
+    Context::Scope context_scope(context);
+    CHECK_EQ(1.5, CompileRun("obj.x")->NumberValue());
+  }
+
+  second.Dispose();
+  first.Dispose();
+  context.Dispose();
+  i::FLAG_track_double_fields = saved_track_double_fields;
+  i::FLAG_allow_natives_syntax = saved_allow_natives_syntax;
+}
+
+THREADED_TEST(InstanceTemplateBoilerplate) {
+  v8::HandleScope scope;
+  LocalContext env;
+  Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New();
+  Local<ObjectTemplate> instance_template = templ->InstanceTemplate();
+  instance_template->Set(v8_str("x"), v8_num(1));
+  instance_template->Set(v8_str("s"), v8_str("str"), v8::ReadOnly);
+  instance_template->Set(v8_str("f"), v8::FunctionTemplate::New(NativeAnswer));
+  Local<v8::Function> fun = templ->GetFunction();
+  env->Global()->Set(v8_str("Fun"), fun);
+
+  Local<v8::Object> first = fun->NewInstance();
+  Local<v8::Object> second = fun->NewInstance();
+  Local<v8::Object> third = instance_template->NewInstance();
+  CHECK_EQ(v8::Utils::OpenHandle(*first)->map(),
+           v8::Utils::OpenHandle(*second)->map());
+  CHECK_EQ(v8::Utils::OpenHandle(*first)->map(),
+           v8::Utils::OpenHandle(*third)->map());
+  CHECK(v8::Utils::OpenHandle(*first)->HasFastProperties());
+
+  env->Global()->Set(v8_str("first"), first);
+  env->Global()->Set(v8_str("second"), second);
+  env->Global()->Set(v8_str("third"), third);
+  CHECK_EQ(42, CompileRun("first.f()")->Int32Value());
+  CHECK(CompileRun("first.f === second.f")->BooleanValue());
+  CHECK(CompileRun("first.hasOwnProperty('x')")->BooleanValue());
+  CHECK_EQ(2, CompileRun("first.x = 2; first.x")->Int32Value());
+  CHECK_EQ(1, CompileRun("second.x")->Int32Value());
+  CHECK_EQ(1, CompileRun("third.x")->Int32Value());
+  CHECK_EQ(v8_str("str"), CompileRun("second.s = 'other'; second.s"));
+  CHECK_EQ(1, CompileRun("new Fun().x")->Int32Value());
+
+  // Nested object templates are instantiated for every instance.
+  Local<v8::FunctionTemplate> outer = v8::FunctionTemplate::New();
+  outer->InstanceTemplate()->Set(v8_str("inner"), ObjectTemplate::New());
+  env->Global()->Set(v8_str("Outer"), outer->GetFunction());
+  CHECK(CompileRun("new Outer().inner !== new Outer().inner")->BooleanValue());
+  CHECK_EQ(1, CompileRun("var o = new Outer(); o.inner.y = 1;"
+                         "new Outer().inner.y === undefined ? 1 : 0")
+                  ->Int32Value());
+}
+
+
+THREADED_TEST(InstanceTemplateBoilerplateSetAfterInstantiation) {
+  v8::HandleScope scope;
+  LocalContext env;
+  Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New();
+  Local<ObjectTemplate> instance_template = templ->InstanceTemplate();
+  instance_template->Set(v8_str("x"), v8_num(1));
+  Local<v8::Function> fun = templ->GetFunction();
+  env->Global()->Set(v8_str("Fun"), fun);
+
+  Local<v8::Object> first = fun->NewInstance();
+  i::Handle<i::Context> global_context =
+      v8::Utils::OpenHandle(*env.local());
+  i::Handle<i::Object> cache(global_context->instance_boilerplate_cache());
+  CHECK(cache->IsDictionary());
+  CHECK_EQ(1, i::UnseededNumberDictionary::cast(*cache)->NumberOfElements());
+
+  // Properties added to the template later show up in new instances.
+  instance_template->Set(v8_str("y"), v8_num(2));
+  Local<v8::Object> second = fun->NewInstance();
+  env->Global()->Set(v8_str("first"), first);
+  env->Global()->Set(v8_str("second"), second);
+  CHECK(CompileRun("second.hasOwnProperty('y')")->BooleanValue());
+  CHECK_EQ(2, CompileRun("second.y")->Int32Value());
+  CHECK_EQ(1, CompileRun("second.x")->Int32Value());
+  CHECK_EQ(2, CompileRun("new Fun().y")->Int32Value());
+  CHECK(!CompileRun("first.hasOwnProperty('y')")->BooleanValue());
+}
+
+static int fast_api_calls = 0;
+static int slow_api_calls = 0;
+
+
+static int32_t FastCounterAdd(void* counter, int32_t delta) {
+  fast_api_calls++;
+  return *static_cast<int32_t*>(counter) += delta;
+}
+
+
+static v8::Handle<Value> SlowCounterAdd(const v8::Arguments& args) {
+  slow_api_calls++;
+  void* counter = v8::External::Unwrap(args.Holder()->GetInternalField(0));
+  return v8_num(*static_cast<int32_t*>(counter) += args[0]->Int32Value());
+}
+
+
+static double FastScale(double value, bool negate) {
+  fast_api_calls++;
+  return negate ? -2 * value : 2 * value;
+}
+
+
+static v8::Handle<Value> SlowScale(const v8::Arguments& args) {
+  slow_api_calls++;
+  double value = 2 * args[0]->NumberValue();
+  return v8_num(args[1]->BooleanValue() ? -value : value);
+}
+
+
+THREADED_TEST(FastApiCalls) {
+  i::FLAG_allow_natives_syntax = true;
+  v8::HandleScope scope;
+  LocalContext context;
+  v8::Handle<v8::FunctionTemplate> templ = v8::FunctionTemplate::New();
+  templ->InstanceTemplate()->SetInternalFieldCount(1);
+
+  v8::Handle<v8::FunctionTemplate> add =
+      v8::FunctionTemplate::New(SlowCounterAdd);
+  v8::FastCallbackType add_types[] = { v8::kFastCallbackInt32 };
+  add->SetFastCallHandler(reinterpret_cast<v8::FastCallback>(FastCounterAdd),
+                          v8::kFastCallbackInt32,
+                          v8::kFastCallbackExternal,
+                          1,
+                          add_types);
+  templ->PrototypeTemplate()->Set(v8_str("add"), add);
+
+  v8::Handle<v8::FunctionTemplate> scale =
+      v8::FunctionTemplate::New(SlowScale);
+  v8::FastCallbackType scale_types[] = {
+    v8::kFastCallbackDouble, v8::kFastCallbackBool
+  };
+  scale->SetFastCallHandler(reinterpret_cast<v8::FastCallback>(FastScale),
+                            v8::kFastCallbackDouble,
+                            v8::kFastCallbackVoid,
+                            2,
+                            scale_types);
+  templ->PrototypeTemplate()->Set(v8_str("scale"), scale);
+
+  int32_t counter = 0;
+  v8::Local<v8::Object> obj = templ->GetFunction()->NewInstance();
+  obj->SetInternalField(0, v8::External::Wrap(&counter));
+  context->Global()->Set(v8_str("obj"), obj);
+
+  fast_api_calls = 0;
+  slow_api_calls = 0;
+  CompileRun(
+      "function test(o) {"
+      "  var result = 0;"
+      "  for (var i = 0; i < 10; i++) result = o.add(1);"
+      "  return result + o.scale(0.25, i > 5);"
+      "};"
+      "test(obj); test(obj);"
+      "%OptimizeFunctionOnNextCall(test);");
+  CHECK_EQ(0, fast_api_calls);
+  CHECK_EQ(22, slow_api_calls);
+  CHECK_EQ(29.5, CompileRun("test(obj)")->NumberValue());
+  CHECK_EQ(30, counter);
+#if defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64)
+  if (i::V8::UseCrankshaft()) {
+    CHECK_EQ(11, fast_api_calls);
+    CHECK_EQ(22, slow_api_calls);
+  }
+#endif
+
+  // Arguments of an unexpected type go through the call handler.
+  CHECK_EQ(33, CompileRun("obj.add('3')")->Int32Value());
+  CHECK_EQ(-3.0, CompileRun("obj.scale('1.5', true)")->NumberValue());
+  CHECK_EQ(35, fast_api_calls + slow_api_calls);
+}
+
+
+static v8::Handle<Value> RuntimeProfilerTick(const v8::Arguments& args) {
+  i::RuntimeProfiler* profiler = i::Isolate::Current()->runtime_profiler();
+  // Keep the profiler from optimizing small functions on their first tick.
+  profiler->NotifyICChanged();
+  profiler->OptimizeNow();
+  return v8::Undefined();
+}
+
+
+static bool IsMarkedOrOptimized(const char* name) {
+  i::Handle<i::JSFunction> function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(
+          v8::Context::GetCurrent()->Global()->Get(v8_str(name))));
+  return function->IsMarkedForLazyRecompilation() ||
+      function->IsMarkedForParallelRecompilation() ||
+      function->IsOptimized();
+}
+
+
+TEST(OptimizationProfileOptimizesEarly) {
+  if (!i::V8::UseCrankshaft() || i::FLAG_always_opt) return;
+  v8::HandleScope scope;
+  LocalContext context;
+  context->Global()->Set(
+      v8_str("tick"),
+      v8::FunctionTemplate::New(RuntimeProfilerTick)->GetFunction());
+
+  const char* hot = "function hot(o) { tick(); return o.a + o.b; }\n";
+  CHECK(v8::V8::LoadOptimizationProfile(v8_str("")));
+
+  // Warm up two copies of the same function until the profiler optimizes
+  // them.  Both have the same profile entry, which is exported once.
+  const char* suffixes[] = { "", "// Compiled again.\n" };
+  for (int i = 0; i < 2; i++) {
+    i::EmbeddedVector<char, 256> source;
+    i::OS::SNPrintF(source, "%s%s", hot, suffixes[i]);
+    CompileRun(source.start());
+    CHECK(!IsMarkedOrOptimized("hot"));
+    for (int j = 0; j < 100 && !IsMarkedOrOptimized("hot"); j++) {
+      CompileRun("hot({ a: 1, b: 2 });");
+    }
+    CHECK(IsMarkedOrOptimized("hot"));
+  }
+  v8::Local<v8::String> profile = v8::V8::GetOptimizationProfile();
+  v8::String::AsciiValue lines(profile);
+  int line_count = 0;
+  for (const char* c = *lines; *c != '\0'; c++) {
+    if (*c == '\n') line_count++;
+  }
+  CHECK_EQ(1, line_count);
+
+  // With the profile loaded, a fresh copy of the function is optimized on
+  // its first tick, while other functions still warm up.
+  CHECK(v8::V8::LoadOptimizationProfile(profile));
+  i::EmbeddedVector<char, 256> source;
+  i::OS::SNPrintF(source, "%s%s", hot,
+                  "function cold(o) { tick(); return o.a * o.b; }\n");
+  CompileRun(source.start());
+  CHECK(!IsMarkedOrOptimized("hot"));
+  CompileRun("hot({ a: 1, b: 2 }); cold({ a: 1, b: 2 });");
+  CHECK(IsMarkedOrOptimized("hot"));
+  CHECK(!IsMarkedOrOptimized("cold"));
+
+  v8::String::AsciiValue unchanged(v8::V8::GetOptimizationProfile());
+  CHECK_EQ(*lines, *unchanged);
+}
@@ -688,3 +688,113 @@ TEST(DeoptimizeLoadICStoreICNested) {
   CHECK_EQ(13, env->Global()->Get(v8_str("result"))->Int32Value());
   CHECK_EQ(0, Deoptimizer::GetDeoptimizedCodeCount(Isolate::Current()));
 }
+
+
+TEST(DeoptimizeCapturedObject) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  // Test lazy deoptimization while an object literal whose allocation was
+  // removed by escape analysis is live. The deoptimizer has to materialize
+  // the object with the field values stored so far.
+  {
+    AllowNativesSyntaxNoInlining options;
+    bool escape_analysis = i::FLAG_escape_analysis;
+    i::FLAG_escape_analysis = true;
+    CompileRun(
+        "var deopt = false;"
+        "function h() { if (deopt) %DeoptimizeFunction(f); }"
+        "function f(a) {"
+        "  var o = { x: 0, y: 0 };"
+        "  o.x = a;"
+        "  h();"
+        "  o.y = o.x + 1;"
+        "  return o.x + o.y;"
+        "};"
+        "f(1); f(2);"
+        "%OptimizeFunctionOnNextCall(f);"
+        "f(3);"
+        "deopt = true;"
+        "var result = f(4);");
+    i::FLAG_escape_analysis = escape_analysis;
+  }
+  NonIncrementalGC();
+
+  CHECK(!GetJSFunction(env->Global(), "f")->IsOptimized());
+  CHECK_EQ(9, env->Global()->Get(v8_str("result"))->Int32Value());
+  CHECK_EQ(0, Deoptimizer::GetDeoptimizedCodeCount(Isolate::Current()));
+}
+
+
+TEST(DeoptimizationStatistics) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function deopt_stats_target(x) { return x.a; };"
+        "deopt_stats_target({a: 1}); deopt_stats_target({a: 2});"
+        "%OptimizeFunctionOnNextCall(deopt_stats_target);"
+        "deopt_stats_target({a: 3});"
+        "deopt_stats_target({b: 0, a: 4});");
+  }
+  NonIncrementalGC();
+
+  CHECK(!GetJSFunction(env->Global(), "deopt_stats_target")->IsOptimized());
+  v8::DeoptimizationStatistics statistics[16];
+  int count = v8::V8::GetDeoptimizationStatistics(statistics, 16);
+  CHECK_LE(count, 16);
+  bool found = false;
+  for (int i = 0; i < count; i++) {
+    if (strcmp(statistics[i].function_name(), "deopt_stats_target") == 0) {
+      CHECK_EQ(1, statistics[i].count(v8::DeoptimizationStatistics::kEager));
+      CHECK_EQ(0, statistics[i].count(v8::DeoptimizationStatistics::kLazy));
+      found = true;
+    }
+  }
+  CHECK(found);
+}
+
+
+TEST(DeoptimizationBackoffByReason) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  {
+    AllowNativesSyntaxNoInlining options;
+    // Deoptimizes twice at the same property load.
+    CompileRun(
+        "function same_reason(o) { return o.a; };"
+        "same_reason({a: 1}); same_reason({a: 2});"
+        "%OptimizeFunctionOnNextCall(same_reason);"
+        "same_reason({a: 3});"
+        "same_reason({b: 0, a: 4});"
+        "%OptimizeFunctionOnNextCall(same_reason);"
+        "same_reason({a: 5});"
+        "same_reason({c: 0, a: 6});");
+    // Deoptimizes once each at two property loads.  The call between them
+    // gives the second load its own bailout point.
+    CompileRun(
+        "function id(x) { return x; };"
+        "function two_reasons(o, p) { var x = id(o.a); return x + p.a; };"
+        "two_reasons({a: 1}, {a: 1}); two_reasons({a: 2}, {a: 2});"
+        "%OptimizeFunctionOnNextCall(two_reasons);"
+        "two_reasons({a: 3}, {a: 3});"
+        "two_reasons({b: 0, a: 4}, {a: 4});"
+        "%OptimizeFunctionOnNextCall(two_reasons);"
+        "two_reasons({a: 5}, {a: 5});"
+        "two_reasons({a: 6}, {c: 0, a: 6});");
+  }
+  NonIncrementalGC();
+
+  Handle<JSFunction> same_reason =
+      GetJSFunction(env->Global(), "same_reason");
+  Handle<JSFunction> two_reasons =
+      GetJSFunction(env->Global(), "two_reasons");
+  CHECK_EQ(2, same_reason->shared()->deopt_count());
+  CHECK_EQ(2, two_reasons->shared()->deopt_count());
+  // Only repeated deoptimizations for one reason back off further.
+  CHECK_EQ(2, same_reason->shared()->deopt_backoff());
+  CHECK_EQ(1, two_reasons->shared()->deopt_backoff());
+}
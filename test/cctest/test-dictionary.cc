@@ -99,6 +99,100 @@ TEST(ObjectHashTable) {
 }
 
 
+TEST(OrderedHashTable) {
+  v8::HandleScope scope;
+  LocalContext context;
+  Handle<OrderedHashMap> table = FACTORY->NewOrderedHashMap();
+  Handle<JSObject> a = FACTORY->NewJSArray(7);
+  Handle<JSObject> b = FACTORY->NewJSArray(11);
+  table = PutIntoOrderedHashMap(table, a, b);
+  CHECK_EQ(table->NumberOfElements(), 1);
+  CHECK_EQ(table->Lookup(*a), *b);
+  CHECK_EQ(table->Lookup(*b), HEAP->the_hole_value());
+
+  // Keys mapped to the hole should be removed.
+  table = PutIntoOrderedHashMap(table, a, FACTORY->the_hole_value());
+  CHECK_EQ(table->NumberOfElements(), 0);
+  CHECK_EQ(table->Lookup(*a), HEAP->the_hole_value());
+
+  // Numbers with an integral value are normalized to smis, and -0 is
+  // distinct from 0.
+  Handle<Object> one(HEAP->AllocateHeapNumber(1.0)->ToObjectChecked());
+  Handle<Object> minus_zero = FACTORY->NewNumber(-0.0);
+  table = PutIntoOrderedHashMap(table, one, b);
+  CHECK_EQ(table->Lookup(Smi::FromInt(1)), *b);
+  CHECK_EQ(table->Lookup(*minus_zero), HEAP->the_hole_value());
+  CHECK_EQ(table->Lookup(Smi::FromInt(0)), HEAP->the_hole_value());
+
+  // Entries keep their insertion order across removals and rehashing.
+  for (int i = 2; i < 100; i++) {
+    table = PutIntoOrderedHashMap(table,
+                                  Handle<Object>(Smi::FromInt(i)),
+                                  Handle<Object>(Smi::FromInt(i * 2)));
+  }
+  for (int i = 2; i < 100; i += 2) {
+    table = PutIntoOrderedHashMap(table,
+                                  Handle<Object>(Smi::FromInt(i)),
+                                  FACTORY->the_hole_value());
+  }
+  table = PutIntoOrderedHashMap(table, a, b);
+  CHECK_EQ(table->NumberOfElements(), 51);
+  int expected = 1;
+  for (int entry = 0; entry < table->UsedCapacity(); entry++) {
+    Object* key = table->KeyAt(entry);
+    if (key->IsTheHole()) continue;
+    if (expected < 100) {
+      CHECK_EQ(Smi::FromInt(expected), key);
+      if (expected > 1) {
+        CHECK_EQ(Smi::FromInt(expected * 2), table->ValueAt(entry));
+      }
+      expected += 2;
+    } else {
+      CHECK_EQ(*a, key);
+      expected++;
+    }
+  }
+  CHECK_EQ(102, expected);
+
+  // A rehashed table forwards to its replacement and translates the entry
+  // numbers of iterations that still refer to it.
+  table = PutIntoOrderedHashMap(table, a, FACTORY->the_hole_value());
+  Handle<OrderedHashMap> old_table = table;
+  int used_capacity = table->UsedCapacity();
+  Handle<FixedArray> keys = FACTORY->NewFixedArray(used_capacity);
+  for (int entry = 0; entry < used_capacity; entry++) {
+    keys->set(entry, table->KeyAt(entry));
+  }
+  CHECK(keys->get(used_capacity - 1)->IsTheHole());
+  for (int i = 100; *table == *old_table; i++) {
+    table = PutIntoOrderedHashMap(table,
+                                  Handle<Object>(Smi::FromInt(i)),
+                                  Handle<Object>(Smi::FromInt(i * 2)));
+  }
+  CHECK(!table->IsObsolete());
+  CHECK(old_table->IsObsolete());
+  CHECK_EQ(*table, old_table->NextTable());
+  CHECK_EQ(0, table->NumberOfDeletedElements());
+  for (int entry = 0; entry < used_capacity; entry++) {
+    if (keys->get(entry)->IsTheHole()) continue;
+    CHECK_EQ(keys->get(entry),
+             table->KeyAt(old_table->TranslateEntry(entry)));
+  }
+  CHECK_EQ(Smi::FromInt(100),
+           table->KeyAt(old_table->TranslateEntry(used_capacity)));
+
+  Handle<OrderedHashSet> set = FACTORY->NewOrderedHashSet();
+  set = OrderedHashSetAdd(set, a);
+  set = OrderedHashSetAdd(set, a);
+  CHECK_EQ(set->NumberOfElements(), 1);
+  CHECK(set->Contains(*a));
+  CHECK(!set->Contains(*b));
+  set = OrderedHashSetRemove(set, a);
+  CHECK_EQ(set->NumberOfElements(), 0);
+  CHECK(!set->Contains(*a));
+}
+
+
 #ifdef DEBUG
 TEST(ObjectHashSetCausesGC) {
   v8::HandleScope scope;
@@ -639,6 +639,62 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+
+TEST(HeapSnapshotStreaming) {
+  v8::HandleScope scope;
+  LocalContext env;
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('streamed string');\n"
+      "var b = new B(a);");
+  TestJSONStream stream;
+  CHECK(v8::HeapProfiler::StreamSnapshot(&stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> records(stream.size());
+  stream.WriteTo(records);
+
+  // Every line must be a valid JSON record.
+  AsciiResource records_res(records);
+  v8::Local<v8::String> records_string =
+      v8::String::NewExternal(&records_res);
+  env->Global()->Set(v8_str("records"), records_string);
+  env->Global()->Set(v8_str("property_type"),
+                     v8::Integer::New(v8::HeapGraphEdge::kProperty));
+  v8::Local<v8::Value> parse_result = CompileRun(
+      "var strings = [], edges = [], nodes = [], ordered = true;\n"
+      "records.split('\\n').forEach(function(line) {\n"
+      "  if (line === '') return;\n"
+      "  var r = JSON.parse(line);\n"
+      "  if (r[0] === 's') strings[r[1]] = r[2];\n"
+      "  else if (r[0] === 'n') nodes[r[1]] = r;\n"
+      "  else if (r[0] === 't') nodes[r[1]][3] = r[2];\n"
+      "  else if (r[0] === 'e') {\n"
+      "    ordered = ordered && !!nodes[r[2]] && !!nodes[r[3]];\n"
+      "    edges.push(r);\n"
+      "  }\n"
+      "});\n"
+      "function Name(n) { return typeof n === 'number' ? strings[n] : n; }\n"
+      "function GetChild(from, prop_name) {\n"
+      "  for (var i = 0; i < edges.length; ++i) {\n"
+      "    var e = edges[i];\n"
+      "    if (e[2] === from && e[1] === property_type\n"
+      "        && Name(e[4]) === prop_name) return e[3];\n"
+      "  }\n"
+      "  return null;\n"
+      "}\n"
+      "var global = edges.filter(function(e) { return e[2] === 0; })[0][3];\n"
+      "Name(nodes[GetChild(GetChild(GetChild(global, 'b'), 'x'), 's')][3]);");
+  CHECK(!parse_result.IsEmpty());
+  CHECK_EQ("streamed string", *v8::String::Utf8Value(parse_result));
+  CHECK(CompileRun("ordered")->BooleanValue());
+
+  TestJSONStream aborting_stream(5);
+  CHECK(!v8::HeapProfiler::StreamSnapshot(&aborting_stream));
+  CHECK_EQ(0, aborting_stream.eos_signaled());
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -1658,3 +1714,52 @@ TEST(NoRefsToNonEssentialEntries) {
       GetProperty(global_object, v8::HeapGraphEdge::kInternal, "elements");
   CHECK_EQ(NULL, elements);
 }
+
+
+static const v8::AllocationProfileNode* FindAllocationChild(
+    const v8::AllocationProfileNode* node, const char* name) {
+  for (int i = 0; i < node->GetChildrenCount(); ++i) {
+    const v8::AllocationProfileNode* child = node->GetChild(i);
+    v8::String::AsciiValue child_name(child->GetFunctionName());
+    if (strcmp(*child_name, name) == 0) return child;
+  }
+  return NULL;
+}
+
+
+TEST(SamplingHeapProfiler) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  CHECK_EQ(NULL, v8::HeapProfiler::GetAllocationProfileRoot());
+  CHECK(v8::HeapProfiler::StartSamplingHeapProfiler(1024));
+  CHECK(!v8::HeapProfiler::StartSamplingHeapProfiler(1024));
+
+  CompileRun(
+      "var retained = [];\n"
+      "function allocate() {\n"
+      "  for (var i = 0; i < 10000; i++) retained.push({ x: i, y: i });\n"
+      "}\n"
+      "allocate();\n");
+
+  const v8::AllocationProfileNode* root =
+      v8::HeapProfiler::GetAllocationProfileRoot();
+  CHECK_NE(NULL, root);
+  const v8::AllocationProfileNode* program =
+      FindAllocationChild(root, "(anonymous function)");
+  CHECK_NE(NULL, program);
+  const v8::AllocationProfileNode* allocate =
+      FindAllocationChild(program, "allocate");
+  CHECK_NE(NULL, allocate);
+  CHECK_GT(allocate->GetSamplesCount(), 0);
+  CHECK_EQ(2, allocate->GetLineNumber());
+
+  int samples = allocate->GetSamplesCount();
+  CompileRun("retained = null;");
+  HEAP->CollectAllGarbage(i::Heap::kNoGCFlags);
+  CHECK_EQ(samples, allocate->GetSamplesCount());
+  CHECK_LT(allocate->GetLiveSamplesCount(), samples);
+
+  v8::HeapProfiler::StopSamplingHeapProfiler();
+  CHECK_EQ(NULL, v8::HeapProfiler::GetAllocationProfileRoot());
+}
@@ -8,6 +8,7 @@
 #include "factory.h"
 #include "macro-assembler.h"
 #include "global-handles.h"
+#include "natives.h"
 #include "cctest.h"
 
 using namespace v8::internal;
@@ -985,6 +986,254 @@ TEST(TestCodeFlushing) {
 }
 
 
+TEST(TestCodeAgingResetOnExecution) {
+  // If we do not flush code this test is invalid.  Optimized functions are
+  // never flushed.
+  if (!FLAG_flush_code || i::FLAG_always_opt) return;
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function foo() {"
+             "  var x = 42;"
+             "  var y = 42;"
+             "  return x + y;"
+             "};"
+             "foo()");
+  Handle<String> foo_name = FACTORY->LookupAsciiSymbol("foo");
+  Object* func_value = Isolate::Current()->context()->global()->
+      GetProperty(*foo_name)->ToObjectChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function(JSFunction::cast(func_value));
+  // Without a code age sequence code ages with every collection.
+  if (!function->shared()->code()->has_code_age_sequence()) return;
+
+  // Code that keeps running between collections never gets old enough to
+  // be flushed.
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    CompileRun("foo()");
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+    CHECK(function->shared()->is_compiled());
+  }
+
+  // Once foo stops running, its code is flushed.
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  }
+  CHECK(!function->shared()->is_compiled());
+  CHECK(!function->is_compiled());
+}
+
+
+TEST(TestOptimizeForSize) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  InitializeVM();
+  v8::HandleScope scope;
+  const char* source = "function %s(a, b) {"
+                       "  var s = 0;"
+                       "  for (var i = 0; i < a; i++) s += b + i;"
+                       "  return s > 0 ? s - 1 : s;"
+                       "};"
+                       "%s(1, 1);";
+  EmbeddedVector<char, 256> buffer;
+
+  FLAG_optimize_for_size = false;
+  OS::SNPrintF(buffer, source, "fast", "fast");
+  CompileRun(buffer.start());
+  FLAG_optimize_for_size = true;
+  OS::SNPrintF(buffer, source, "small", "small");
+  CompileRun(buffer.start());
+
+  Handle<JSFunction> fast(JSFunction::cast(
+      Isolate::Current()->context()->global()->GetProperty(
+          *FACTORY->LookupAsciiSymbol("fast"))->ToObjectChecked()));
+  Handle<JSFunction> small(JSFunction::cast(
+      Isolate::Current()->context()->global()->GetProperty(
+          *FACTORY->LookupAsciiSymbol("small"))->ToObjectChecked()));
+  CHECK(fast->shared()->is_compiled());
+  CHECK(small->shared()->is_compiled());
+
+  // Without inlined smi code the same function needs less code space.
+  CHECK_LT(small->shared()->code()->Size(), fast->shared()->code()->Size());
+
+  // Code that is not run is flushed after the next full GC.  Code with a
+  // code age sequence needs one more to find out that it did not run.
+  HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(!small->shared()->is_compiled());
+  FLAG_optimize_for_size = false;
+}
+
+
+TEST(TestCodeAgingOptimizedFunction) {
+  i::FLAG_allow_natives_syntax = true;
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code || !i::V8::UseCrankshaft()) return;
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function foo() {"
+             "  var x = 42;"
+             "  var y = 42;"
+             "  return x + y;"
+             "};"
+             "foo();"
+             "%OptimizeFunctionOnNextCall(foo);"
+             "foo();");
+  Handle<String> foo_name = FACTORY->LookupAsciiSymbol("foo");
+  Object* func_value = Isolate::Current()->context()->global()->
+      GetProperty(*foo_name)->ToObjectChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function(JSFunction::cast(func_value));
+  CHECK(function->IsOptimized());
+  bool cached = !function->shared()->optimized_code_map()->IsSmi();
+
+  // Optimized code never runs the full codegen prologue.  The function
+  // must neither age nor lose its unoptimized or cached optimized code.
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+    CHECK_EQ(0, function->shared()->code_age());
+  }
+  CHECK(function->IsOptimized());
+  CHECK(function->shared()->is_compiled());
+  CHECK_EQ(cached, !function->shared()->optimized_code_map()->IsSmi());
+}
+
+
+TEST(TestCodeAgeSequence) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code || i::FLAG_always_opt) return;
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function foo() {"
+             "  var x = 42;"
+             "  var y = 42;"
+             "  return x + y;"
+             "};"
+             "foo()");
+  Handle<String> foo_name = FACTORY->LookupAsciiSymbol("foo");
+  Object* func_value = Isolate::Current()->context()->global()->
+      GetProperty(*foo_name)->ToObjectChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function(JSFunction::cast(func_value));
+  Handle<Code> code(function->shared()->code());
+  if (!code->has_code_age_sequence()) return;
+  CHECK(!code->IsOld());
+
+  // A full GC patches the prologue of code that is not running.  Running
+  // the code patches it back.
+  HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(code->IsOld());
+  CHECK_EQ(84, CompileRun("foo()")->Int32Value());
+  CHECK(!code->IsOld());
+
+  // Old code still reaches the builtin after it has moved.
+  HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(code->IsOld());
+  Handle<Code> copy = FACTORY->CopyCode(code);
+  CHECK(copy->IsOld());
+  function->shared()->set_code(*copy);
+  function->set_code(*copy);
+  CHECK_EQ(84, CompileRun("foo()")->Int32Value());
+  CHECK(!copy->IsOld());
+  CHECK(code->IsOld());
+}
+
+
+TEST(TestOptimizedCodeMapAging) {
+  i::FLAG_allow_natives_syntax = true;
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code ||
+      !FLAG_cache_optimized_code ||
+      !i::V8::UseCrankshaft() ||
+      i::FLAG_always_opt) {
+    return;
+  }
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function make() {"
+             "  return function foo() {"
+             "    var x = 42;"
+             "    var y = 42;"
+             "    return x + y;"
+             "  };"
+             "};"
+             "var f = make();"
+             "var g = make();"
+             "f();"
+             "g();"
+             "%OptimizeFunctionOnNextCall(f);"
+             "f();");
+  Handle<String> f_name = FACTORY->LookupAsciiSymbol("f");
+  Handle<String> g_name = FACTORY->LookupAsciiSymbol("g");
+  Handle<JSFunction> g(JSFunction::cast(
+      Isolate::Current()->context()->global()->GetProperty(
+          *g_name)->ToObjectChecked()));
+  CHECK(!g->IsOptimized());
+  // A handle to the shared function info would keep its code alive.
+  CHECK(g->shared()->optimized_code_map()->IsFixedArray());
+
+  // A live closure keeps its entry, whatever order the collector visits
+  // the closure and the shared function info in.
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  }
+  {
+    v8::HandleScope inner_scope;
+    Handle<JSFunction> f(JSFunction::cast(
+        Isolate::Current()->context()->global()->GetProperty(
+            *f_name)->ToObjectChecked()));
+    CHECK(f->IsOptimized());
+  }
+  CHECK(g->shared()->optimized_code_map()->IsFixedArray());
+
+  // Once no closure uses the optimized code any more, its entry goes.
+  CompileRun("f = null;");
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  }
+  CHECK(g->shared()->optimized_code_map()->IsSmi());
+  CHECK(!g->IsOptimized());
+}
+
+
+TEST(TestOptimizedCodeMapOfRunningCode) {
+  i::FLAG_allow_natives_syntax = true;
+  if (!FLAG_flush_code ||
+      !FLAG_cache_optimized_code ||
+      !i::V8::UseCrankshaft() ||
+      i::FLAG_always_opt) {
+    return;
+  }
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function make() {"
+             "  return function foo() { return 42; };"
+             "};"
+             "var f = make();"
+             "var g = make();"
+             "f();"
+             "g();"
+             "%OptimizeFunctionOnNextCall(f);"
+             "f();"
+             "f = null;");
+  Handle<String> g_name = FACTORY->LookupAsciiSymbol("g");
+  Handle<JSFunction> g(JSFunction::cast(
+      Isolate::Current()->context()->global()->GetProperty(
+          *g_name)->ToObjectChecked()));
+  CHECK(g->shared()->optimized_code_map()->IsFixedArray());
+
+  // The map only ages while the unoptimized code is old, so running the
+  // function keeps the cached code for the next closure.
+  for (int i = 0; i < 2 * FLAG_flush_code_age; i++) {
+    CompileRun("g();");
+    HEAP->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  }
+  if (g->shared()->code()->has_code_age_sequence()) {
+    CHECK(g->shared()->optimized_code_map()->IsFixedArray());
+  }
+}
+
+
 // Count the number of global contexts in the weak list of global contexts.
 int CountGlobalContexts() {
   int count = 0;
@@ -2180,3 +2429,115 @@ TEST(IncrementalMarkingClearsPolymorhpicIC) {
   Code* ic_after = FindFirstIC(f->shared()->code(), Code::LOAD_IC);
   CHECK(ic_after->ic_state() == UNINITIALIZED);
 }
+
+
+TEST(RecordGCEvents) {
+  i::FLAG_record_gc_events = true;
+  InitializeVM();
+  v8::HandleScope scope;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::GCEvent events[4];
+  // Drain events from collections during bootstrapping.
+  while (v8::V8::GetGCEvents(isolate, events, 4) > 0) { }
+
+  HEAP->CollectGarbage(NEW_SPACE);
+  HEAP->CollectAllGarbage(Heap::kNoGCFlags);
+
+  CHECK_EQ(2, v8::V8::GetGCEvents(isolate, events, 4));
+  CHECK_EQ(v8::kGCTypeScavenge, events[0].type());
+  CHECK_EQ(v8::kGCTypeMarkSweepCompact, events[1].type());
+  CHECK(events[0].gc_count() + 1 == events[1].gc_count());
+  CHECK_EQ(0, events[1].dropped_before());
+  CHECK(events[1].pause_time() >= 0);
+  CHECK(events[1].phase_time(v8::GCEvent::kMarkPhase) <=
+        events[1].pause_time());
+  CHECK(events[1].space_size_after(v8::GCEvent::kOldPointerSpace) > 0);
+  CHECK_EQ(0, v8::V8::GetGCEvents(isolate, events, 4));
+
+  // Scavenges forced through PerformScavenge report the current GC count.
+  HEAP->PerformScavenge();
+  CHECK_EQ(1, v8::V8::GetGCEvents(isolate, events, 4));
+  CHECK_EQ(v8::kGCTypeScavenge, events[0].type());
+  CHECK(events[0].gc_count() > 0);
+}
+
+
+class GCEventPollingThread : public v8::internal::Thread {
+ public:
+  explicit GCEventPollingThread(v8::Isolate* isolate)
+      : Thread("GCEventPollingThread"), isolate_(isolate), count_(0) { }
+
+  virtual void Run() {
+    v8::GCEvent events[4];
+    count_ = v8::V8::GetGCEvents(isolate_, events, 4);
+  }
+
+  int count() { return count_; }
+
+ private:
+  v8::Isolate* isolate_;
+  int count_;
+};
+
+
+TEST(RecordGCEventsFromOtherThread) {
+  i::FLAG_record_gc_events = true;
+  InitializeVM();
+  v8::HandleScope scope;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::GCEvent events[4];
+  while (v8::V8::GetGCEvents(isolate, events, 4) > 0) { }
+
+  HEAP->CollectGarbage(NEW_SPACE);
+
+  // The polling thread has no current isolate, so it must read the events
+  // of the isolate it was handed.
+  GCEventPollingThread thread(isolate);
+  thread.Start();
+  thread.Join();
+  CHECK_EQ(1, thread.count());
+  CHECK_EQ(0, v8::V8::GetGCEvents(isolate, events, 4));
+}
+
+
+TEST(ExperimentalNativesSourceShared) {
+  bool saved_harmony_collections = FLAG_harmony_collections;
+  FLAG_harmony_collections = true;
+  int index = ExperimentalNatives::GetIndex("collection");
+  CHECK_GE(index, 0);
+  int cache_index = Natives::GetBuiltinsCount() + index;
+  const char* raw_source =
+      ExperimentalNatives::GetRawScriptSource(index).start();
+
+  {
+    v8::HandleScope scope;
+    // The source is an external string over the static natives data.
+    v8::Persistent<v8::Context> first = v8::Context::New();
+    Handle<Object> source(HEAP->natives_source_cache()->get(cache_index));
+    CHECK(source->IsExternalAsciiString());
+    CHECK(ExternalAsciiString::cast(*source)->GetChars() == raw_source);
+
+    // Later contexts reuse it instead of copying the source again.
+    v8::Persistent<v8::Context> second = v8::Context::New();
+    CHECK_EQ(*source, HEAP->natives_source_cache()->get(cache_index));
+
+    first.Dispose();
+    second.Dispose();
+  }
+
+  // Another isolate points its string at the same characters.
+  v8::Isolate* other = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(other);
+    v8::HandleScope scope;
+    v8::Persistent<v8::Context> context = v8::Context::New();
+    Object* source = HEAP->natives_source_cache()->get(cache_index);
+    CHECK(source->IsExternalAsciiString());
+    CHECK(ExternalAsciiString::cast(source)->GetChars() == raw_source);
+    context.Dispose();
+  }
+  other->Dispose();
+  FLAG_harmony_collections = saved_harmony_collections;
+}
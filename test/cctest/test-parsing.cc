@@ -105,6 +105,87 @@ TEST(ScanKeywords) {
 }
 
 
+TEST(ScanReservedWords) {
+  static const char* future_reserved_words[] = {
+    "class", "enum", "export", "extends", "import", "super", NULL
+  };
+  static const char* future_strict_reserved_words[] = {
+    "implements", "interface", "let", "package", "private", "protected",
+    "public", "static", "yield", NULL
+  };
+
+  // Without Harmony the contextual keywords are reserved words.
+  i::UnicodeCache unicode_cache;
+  for (int i = 0; future_reserved_words[i] != NULL; i++) {
+    const i::byte* word =
+        reinterpret_cast<const i::byte*>(future_reserved_words[i]);
+    i::Utf8ToUtf16CharacterStream stream(word, i::StrLength(
+        future_reserved_words[i]));
+    i::Scanner scanner(&unicode_cache);
+    scanner.Initialize(&stream);
+    CHECK_EQ(i::Token::FUTURE_RESERVED_WORD, scanner.Next());
+    CHECK_EQ(i::Token::EOS, scanner.Next());
+  }
+  for (int i = 0; future_strict_reserved_words[i] != NULL; i++) {
+    const i::byte* word =
+        reinterpret_cast<const i::byte*>(future_strict_reserved_words[i]);
+    i::Utf8ToUtf16CharacterStream stream(word, i::StrLength(
+        future_strict_reserved_words[i]));
+    i::Scanner scanner(&unicode_cache);
+    scanner.Initialize(&stream);
+    CHECK_EQ(i::Token::FUTURE_STRICT_RESERVED_WORD, scanner.Next());
+    CHECK_EQ(i::Token::EOS, scanner.Next());
+  }
+}
+
+
+TEST(ScanLongCommentsAndWhiteSpace) {
+  // Comments and white space longer than a buffered block of the
+  // character stream are skipped in bulk.
+  static const int kRunLength = 3000;
+  i::ScopedVector<char> source(4 * kRunLength + 100);
+  int pos = 0;
+  source[pos++] = 'a';
+  for (int i = 0; i < kRunLength; i++) source[pos++] = (i % 7) ? ' ' : '\t';
+  source[pos++] = '/';
+  source[pos++] = '/';
+  for (int i = 0; i < kRunLength; i++) source[pos++] = 'x';
+  source[pos++] = '\n';
+  source[pos++] = 'b';
+  source[pos++] = '/';
+  source[pos++] = '*';
+  for (int i = 0; i < kRunLength; i++) source[pos++] = (i % 5) ? '-' : '*';
+  source[pos++] = '*';
+  source[pos++] = '/';
+  source[pos++] = 'c';
+  source[pos++] = '/';
+  source[pos++] = '*';
+  for (int i = 0; i < kRunLength; i++) source[pos++] = (i == 17) ? '\n' : '-';
+  source[pos++] = '*';
+  source[pos++] = '/';
+  source[pos++] = 'd';
+  int length = pos;
+
+  i::UnicodeCache unicode_cache;
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.start()), length);
+  i::Scanner scanner(&unicode_cache);
+  scanner.Initialize(&stream);
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(0, scanner.location().beg_pos);
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(2 * kRunLength + 4, scanner.location().beg_pos);
+  CHECK(!scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(3 * kRunLength + 9, scanner.location().beg_pos);
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(length - 1, scanner.location().beg_pos);
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+}
+
+
 TEST(ScanHTMLEndComments) {
   v8::V8::Initialize();
 
@@ -236,6 +317,71 @@ TEST(Preparsing) {
 }
 
 
+class BackgroundPreParseThread : public i::Thread {
+ public:
+  BackgroundPreParseThread(const char* source, size_t max_stack_size)
+      : Thread("BackgroundPreParseThread"),
+        source_(source),
+        max_stack_size_(max_stack_size),
+        data_(NULL) { }
+
+  void Run() {
+    data_ = v8::ScriptData::PreCompileInBackground(
+        source_, i::StrLength(source_), max_stack_size_);
+  }
+
+  v8::ScriptData* data() { return data_; }
+
+ private:
+  const char* source_;
+  size_t max_stack_size_;
+  v8::ScriptData* data_;
+};
+
+
+TEST(PreparseInBackground) {
+  v8::HandleScope handles;
+  v8::Persistent<v8::Context> context = v8::Context::New();
+  v8::Context::Scope context_scope(context);
+
+  const char* source =
+      "function lazy(a) { return a + 1; }"
+      "function outer() { return function inner(b) { return b * 2; } }"
+      "lazy(41) + outer()(0.5);";
+  const char* error_source = "var x = y z;";
+
+  BackgroundPreParseThread thread(source, 128 * 1024);
+  BackgroundPreParseThread error_thread(error_source, 128 * 1024);
+  thread.Start();
+  error_thread.Start();
+  // The isolate stays usable while the worker threads preparse.
+  CHECK_EQ(3, CompileRun("1 + 2")->Int32Value());
+  thread.Join();
+  error_thread.Join();
+
+  v8::ScriptData* data = thread.data();
+  CHECK(data != NULL);
+  CHECK(!data->HasError());
+  v8::ScriptData* error_data = error_thread.data();
+  CHECK(error_data != NULL);
+  CHECK(error_data->HasError());
+
+  // The background result matches preparsing on the isolate thread.
+  v8::ScriptData* expected =
+      v8::ScriptData::PreCompile(source, i::StrLength(source));
+  CHECK_EQ(expected->Length(), data->Length());
+  CHECK_EQ(0, memcmp(expected->Data(), data->Data(), data->Length()));
+  delete expected;
+
+  v8::Local<v8::Script> script =
+      v8::Script::Compile(v8::String::New(source), NULL, data);
+  CHECK_EQ(43, script->Run()->Int32Value());
+  delete data;
+  delete error_data;
+  context.Dispose();
+}
+
+
 TEST(StandAlonePreParser) {
   v8::V8::Initialize();
 
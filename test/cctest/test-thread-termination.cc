@@ -373,3 +373,53 @@ TEST(TerminateAndReenterFromThreadItself) {
   context.Dispose();
 }
 
+
+
+// Test that a Map whose forEach was terminated still shrinks when its
+// entries are removed, and can be iterated again.
+TEST(TerminateMapForEach) {
+  bool saved_harmony_collections = v8::internal::FLAG_harmony_collections;
+  v8::internal::FLAG_harmony_collections = true;
+  v8::HandleScope scope;
+  v8::Handle<v8::ObjectTemplate> global =
+      CreateGlobalTemplate(TerminateCurrentThread, DoLoopNoCall);
+  v8::Persistent<v8::Context> context = v8::Context::New(NULL, global);
+  v8::Context::Scope context_scope(context);
+  v8::Script::Compile(v8::String::New(
+      "var m = new Map();"
+      "for (var i = 0; i < 1000; i++) m.set(i, i);"))->Run();
+  v8::Handle<v8::String> source = v8::String::New(
+      "try {"
+      "  m.forEach(function() {"
+      "    var term = true;"
+      "    while (true) {"
+      "      if (term) terminate();"
+      "      term = false;"
+      "    }"
+      "  });"
+      "  fail();"
+      "} catch(e) {"
+      "  fail();"
+      "}");
+  CHECK(v8::Script::Compile(source)->Run().IsEmpty());
+  CHECK(!v8::V8::IsExecutionTerminating());
+
+  v8::Handle<v8::Object> map = v8::Handle<v8::Object>::Cast(
+      context->Global()->Get(v8::String::New("m")));
+  v8::internal::Handle<v8::internal::JSMap> holder =
+      v8::internal::Handle<v8::internal::JSMap>::cast(
+          v8::Utils::OpenHandle(*map));
+  int capacity =
+      v8::internal::OrderedHashMap::cast(holder->table())->Capacity();
+  v8::Handle<v8::Value> result = v8::Script::Compile(v8::String::New(
+      "for (var i = 0; i < 1000; i++) m.delete(i);"
+      "m.set('a', 1);"
+      "var visited = 0;"
+      "m.forEach(function(value) { visited += value; });"
+      "visited"))->Run();
+  CHECK_EQ(1, result->Int32Value());
+  CHECK_LT(v8::internal::OrderedHashMap::cast(holder->table())->Capacity(),
+           capacity);
+  context.Dispose();
+  v8::internal::FLAG_harmony_collections = saved_harmony_collections;
+}
@@ -0,0 +1,138 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --track-double-fields
+
+// Double fields keep their number in a heap number that is updated in place.
+// No value read from such a field may observe a later store.
+
+function make(x) {
+  var p = {};
+  p.x = x;
+  p.y = 0.5;
+  return p;
+}
+
+function store(p, x) {
+  p.x = x;
+}
+
+function load(p) {
+  return p.x;
+}
+
+function add(p) {
+  return p.x + p.y;
+}
+
+for (var i = 0; i < 5; i++) {
+  var p = make(1.25);
+  store(p, 2.5);
+  assertEquals(2.5, load(p));
+  assertEquals(3, add(p));
+}
+%OptimizeFunctionOnNextCall(store);
+%OptimizeFunctionOnNextCall(load);
+%OptimizeFunctionOnNextCall(add);
+
+// Loaded values are copies that later stores leave alone.
+var p = make(1.5);
+var a = load(p);
+store(p, 4.5);
+var b = p.x;
+store(p, 8.5);
+assertEquals(1.5, a);
+assertEquals(4.5, b);
+assertEquals(8.5, load(p));
+assertEquals(9, add(p));
+
+// Objects do not share heap numbers.
+var q = make(1.5);
+var r = make(q.x);
+store(q, 3.5);
+assertEquals(3.5, q.x);
+assertEquals(1.5, r.x);
+
+// Small integers and special values are stored as doubles.
+store(p, 7);
+assertEquals(7, load(p));
+store(p, -0);
+assertEquals(-Infinity, 1 / load(p));
+store(p, NaN);
+assertTrue(isNaN(load(p)));
+
+// Storing anything other than a number turns the field back into a
+// normal one.
+store(p, "str");
+assertEquals("str", load(p));
+store(p, 2.25);
+assertEquals(2.25, p.x);
+var s = make(1.5);
+s.x = undefined;
+assertEquals(undefined, s.x);
+s.x = { z: 1 };
+assertEquals(1, s.x.z);
+
+// Keyed loads, descriptors and lookups through the prototype chain all see
+// copies too.
+var t = make(1.5);
+var keyed = t["x"];
+var desc = Object.getOwnPropertyDescriptor(t, "x");
+var child = Object.create(t);
+var inherited = child.x;
+t.x = 6.5;
+assertEquals(1.5, keyed);
+assertEquals(1.5, desc.value);
+assertEquals(1.5, inherited);
+assertEquals(6.5, child.x);
+assertEquals(6.5, t["x"]);
+
+// Literals cloned from the same boilerplate stay independent.
+function literal() {
+  var o = { x: 1.5 };
+  o.x += 1;
+  return o;
+}
+var l1 = literal();
+var l2 = literal();
+l1.x = 5.5;
+assertEquals(2.5, l2.x);
+assertEquals(5.5, l1.x);
+
+// Fields added to objects made by constructors.
+function Point(x) {
+  this.x = x;
+}
+for (var i = 0; i < 3; i++) {
+  var u = new Point(i);
+  u.w = i + 1.5;
+  var w = u.w;
+  u.w = i + 2.5;
+  assertEquals(i + 1.5, w);
+  assertEquals(i + 2.5, u.w);
+  assertEquals(i, u.x);
+}
@@ -0,0 +1,60 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --escape-analysis
+
+// Test that stack traces taken inside a method inlined on a scalar
+// replaced object literal see the receiver with its current fields.
+
+Object.prototype.captureFrames = function captureFrames() {
+  var error = new Error();
+  return error.stack;
+};
+
+Error.prepareStackTrace = function(error, frames) { return frames; };
+
+function trace(a) {
+  var o = { x: a, y: 1 };
+  o.y = a + 1;
+  return o.captureFrames();
+}
+
+function check(a) {
+  var frames = trace(a);
+  assertEquals("captureFrames", frames[0].getFunctionName());
+  assertEquals("Object", frames[0].getTypeName());
+  assertEquals("captureFrames", frames[0].getMethodName());
+  assertEquals(a, frames[0].getThis().x);
+  assertEquals(a + 1, frames[0].getThis().y);
+  assertEquals("trace", frames[1].getFunctionName());
+}
+
+check(1);
+check(2);
+%OptimizeFunctionOnNextCall(trace);
+check(3);
+check(4);
@@ -0,0 +1,162 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --forward_field_stores
+
+// Test that a field load is only replaced by an earlier store's value
+// when nothing in between can have written the field.
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+// Stores through an aliasing object.
+function alias(a, b) {
+  a.x = 1;
+  b.x = 2;
+  return a.x;
+}
+
+var p = new Point(0, 0);
+var q = new Point(0, 0);
+for (var i = 0; i < 5; i++) {
+  assertEquals(1, alias(p, q));
+  assertEquals(2, alias(p, p));
+}
+%OptimizeFunctionOnNextCall(alias);
+assertEquals(1, alias(p, q));
+assertEquals(2, alias(p, p));
+
+// A store to another property at the same offset in an object of another
+// map ends the forwarding too.
+function Other(y) {
+  this.y = y;
+}
+
+function sameOffset(a, b) {
+  a.x = 1;
+  b.y = 2;
+  return a.x;
+}
+
+var o = new Other(0);
+for (var i = 0; i < 5; i++) {
+  assertEquals(1, sameOffset(p, o));
+}
+%OptimizeFunctionOnNextCall(sameOffset);
+assertEquals(1, sameOffset(p, o));
+
+// Calls may write the field.
+function setX(point) {
+  point.x = 42;
+}
+
+function noop(point) { }
+
+function acrossCall(point, f) {
+  point.x = 1;
+  f(point);
+  return point.x;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(42, acrossCall(p, setX));
+  assertEquals(1, acrossCall(p, noop));
+}
+%OptimizeFunctionOnNextCall(acrossCall);
+assertEquals(42, acrossCall(p, setX));
+assertEquals(1, acrossCall(p, noop));
+
+// Setters and other side effects may write the field.
+var withSetter = {
+  x: 0,
+  set y(value) { this.x = value * 2; }
+};
+
+function acrossSetter(obj, value) {
+  obj.x = 1;
+  obj.y = value;
+  return obj.x;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(6, acrossSetter(withSetter, 3));
+}
+%OptimizeFunctionOnNextCall(acrossSetter);
+assertEquals(8, acrossSetter(withSetter, 4));
+
+// Map transitions between the store and the load.
+function transition(obj) {
+  obj.a = 1.5;
+  obj.b = 2;
+  obj.c = obj.a * 2;
+  return obj.a + obj.b + obj.c;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(6.5, transition({}));
+}
+%OptimizeFunctionOnNextCall(transition);
+assertEquals(6.5, transition({}));
+var transitioned = {};
+transition(transitioned);
+assertEquals(1.5, transitioned.a);
+assertEquals(3, transitioned.c);
+
+// The object changes to dictionary mode in a call between the store and
+// the load.
+function removeX(point) {
+  delete point.x;
+}
+
+function acrossDelete(point, f) {
+  point.x = 1;
+  f(point);
+  return point.x;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(1, acrossDelete(new Point(0, 0), noop));
+}
+%OptimizeFunctionOnNextCall(acrossDelete);
+assertEquals(1, acrossDelete(new Point(0, 0), noop));
+assertEquals(undefined, acrossDelete(new Point(0, 0), removeX));
+
+// Doubles stored to a field and read back keep their value.
+function doubles(point, value) {
+  point.x = value * 0.5;
+  point.y = point.x + 0.25;
+  return point.x * point.y;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(0.75 * 1, doubles(new Point(1.1, 2.2), 1.5));
+}
+%OptimizeFunctionOnNextCall(doubles);
+assertEquals(0.75, doubles(new Point(1.1, 2.2), 1.5));
+assertEquals(-0.5 * -0.25, doubles(new Point(1.1, 2.2), -1));
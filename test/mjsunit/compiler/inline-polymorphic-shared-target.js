@@ -0,0 +1,63 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Test polymorphic call sites where several receiver maps share a target.
+
+function A(x) { this.x = x; }
+A.prototype.get = function() { return this.x; };
+
+function B(x) { this.x = x; this.y = 0; }
+B.prototype = Object.create(A.prototype);
+
+function C(x) { this.x = x; }
+C.prototype.get = function() { return this.x + 100; };
+
+function call_get(o) {
+  return o.get();
+}
+
+var a = new A(1);
+var b = new B(2);
+var c = new C(3);
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(1, call_get(a));
+  assertEquals(2, call_get(b));
+  assertEquals(103, call_get(c));
+}
+%OptimizeFunctionOnNextCall(call_get);
+assertEquals(1, call_get(a));
+assertEquals(2, call_get(b));
+assertEquals(103, call_get(c));
+
+// Changing the shared method on the prototype must be observed by both maps.
+A.prototype.get = function() { return -this.x; };
+assertEquals(-1, call_get(a));
+assertEquals(-2, call_get(b));
+assertEquals(103, call_get(c));
@@ -0,0 +1,83 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --check-elimination
+
+// Test that map checks removed across blocks still catch map changes.
+
+function P(x, y) { this.x = x; this.y = y; }
+
+function sum(p, n) {
+  var s = 0;
+  for (var i = 0; i < n; i++) {
+    if (i & 1) {
+      s += p.x;
+    } else {
+      s += p.y;
+    }
+    p.x = p.x + 1;
+  }
+  return s + p.x + p.y;
+}
+
+function grow(p, transition) {
+  var r = p.x;
+  if (transition) p.z = 1;
+  return r + p.x + (p.z || 0);
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(9, sum(new P(1, 2), 2));
+  assertEquals(2, grow(new P(1, 2), false));
+}
+%OptimizeFunctionOnNextCall(sum);
+%OptimizeFunctionOnNextCall(grow);
+assertEquals(9, sum(new P(1, 2), 2));
+assertEquals(2, grow(new P(1, 2), false));
+assertEquals(3, grow(new P(1, 2), true));
+
+var q = new P(1, 2);
+q.w = 0;
+assertEquals(9, sum(q, 2));
+
+// An elements kind transition only changes objects that have its original
+// map, so the map check after it must stay for objects with other maps.
+function storeElement(a, v) {
+  a[0] = v;
+  return a[1];
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(2, storeElement([1, 2], 1.5));
+  assertEquals(2.5, storeElement([1.5, 2.5], 0.5));
+}
+%OptimizeFunctionOnNextCall(storeElement);
+assertEquals(2, storeElement([1, 2], 1.5));
+var objects = [{}, "x"];
+assertEquals("x", storeElement(objects, 1.5));
+assertEquals(1.5, objects[0]);
+assertEquals("x", objects[1]);
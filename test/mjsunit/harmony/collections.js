@@ -25,7 +25,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-// Flags: --harmony-collections --expose-gc
+// Flags: --harmony-collections --expose-gc --allow-natives-syntax
 
 
 // Test valid getter and setter calls on Sets.
@@ -282,11 +282,11 @@ assertEquals(10, o.myValue);
 var alwaysBogus = [ undefined, null, true, "x", 23, {} ];
 var bogusReceiversTestSet = [
   { proto: Set.prototype,
-    funcs: [ 'add', 'has', 'delete' ],
+    funcs: [ 'add', 'has', 'delete', 'forEach' ],
     receivers: alwaysBogus.concat([ new Map, new WeakMap ]),
   },
   { proto: Map.prototype,
-    funcs: [ 'get', 'set', 'has', 'delete' ],
+    funcs: [ 'get', 'set', 'has', 'delete', 'forEach' ],
     receivers: alwaysBogus.concat([ new Set, new WeakMap ]),
   },
   { proto: WeakMap.prototype,
@@ -310,6 +310,209 @@ function TestBogusReceivers(testSet) {
 TestBogusReceivers(bogusReceiversTestSet);
 
 
+// Test that forEach visits entries in insertion order.
+function TestSetForEach() {
+  var s = new Set;
+  var values = [ 3, 'a', undefined, -0, NaN, {}, 1.5 ];
+  for (var i = 0; i < values.length; i++) s.add(values[i]);
+  s.add(3);
+  s.delete('a');
+  s.add('a');
+  var expected = [ 3, undefined, -0, NaN, values[5], 1.5, 'a' ];
+  var visited = [];
+  var receiver = {};
+  s.forEach(function(value, key, set) {
+    assertSame(value, key);
+    assertSame(s, set);
+    assertSame(receiver, this);
+    visited.push(value);
+  }, receiver);
+  assertEquals(expected.length, visited.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertSame(expected[i], visited[i]);
+  }
+  assertThrows(function() { s.forEach(23); }, TypeError);
+}
+TestSetForEach();
+
+
+function TestMapForEach() {
+  var m = new Map;
+  var keys = [];
+  for (var i = 0; i < 100; i++) {
+    m.set(i, i * 2);
+    m.set('k' + i, i);
+  }
+  for (var i = 0; i < 100; i += 2) {
+    m.delete(i);
+    m.delete('k' + i);
+  }
+  m.set(undefined, 'u');
+  var visited = [];
+  m.forEach(function(value, key, map) {
+    assertSame(m, map);
+    assertSame(m.get(key), value);
+    visited.push(key);
+  });
+  assertEquals(101, visited.length);
+  for (var i = 0; i < 50; i++) {
+    assertSame(2 * i + 1, visited[2 * i]);
+    assertSame('k' + (2 * i + 1), visited[2 * i + 1]);
+  }
+  assertSame(undefined, visited[100]);
+
+  // Entries added during the iteration are visited, also when the table
+  // has to grow.
+  var count = 0;
+  m.forEach(function(value, key) {
+    count++;
+    if (count <= 50) m.set({}, key);
+  });
+  assertEquals(151, count);
+}
+TestMapForEach();
+
+
+// Test that forEach sees changes made by the callback.
+function TestForEachMutation() {
+  var m = new Map;
+  m.set(1, 'a');
+  m.set(2, 'b');
+  m.set(3, 'c');
+  var visited = [];
+  m.forEach(function(value, key) {
+    visited.push(key);
+    if (key == 1) {
+      m.delete(2);
+      m.set(4, 'd');
+      m.set(3, 'e');
+    }
+    if (key == 3) assertEquals('e', value);
+  });
+  assertEquals([1, 3, 4], visited);
+
+  // Removing and adding back a visited key visits it again.
+  visited = [];
+  m.forEach(function(value, key) {
+    visited.push(key);
+    if (value == 'a') {
+      m.delete(1);
+      m.set(1, 'f');
+    }
+  });
+  assertEquals([1, 3, 4, 1], visited);
+
+  // Removing most of the entries shrinks the table, and the iteration
+  // continues in the smaller one.
+  var s = new Set;
+  for (var i = 0; i < 100; i++) s.add(i);
+  visited = [];
+  s.forEach(function(value) {
+    visited.push(value);
+    if (value == 0) {
+      for (var i = 1; i < 99; i++) s.delete(i);
+    }
+  });
+  assertEquals([0, 99], visited);
+
+  // Adding entries grows the table, and the iteration visits them in the
+  // larger one.
+  var g = new Set;
+  g.add(0);
+  g.add(1);
+  visited = [];
+  g.forEach(function(value) {
+    visited.push(value);
+    if (value == 0) {
+      g.delete(1);
+      for (var i = 2; i < 50; i++) g.add(i);
+    }
+  });
+  assertEquals(49, visited.length);
+  for (var i = 1; i < visited.length; i++) assertEquals(i + 1, visited[i]);
+
+  // An exception ends the iteration.
+  assertThrows(function() {
+    s.forEach(function(value) { throw new Error(value); });
+  }, Error);
+  s.delete(0);
+  s.delete(99);
+  s.add('x');
+  visited = [];
+  s.forEach(function(value) { visited.push(value); });
+  assertEquals(['x'], visited);
+}
+TestForEachMutation();
+
+
+// Test lookups from optimized code.
+function TestOptimizedLookups() {
+  var m = new Map;
+  var s = new Set;
+  var key = {};
+  m.set(1, 'one');
+  m.set('two', 2);
+  m.set(key, 'object');
+  s.add(1);
+  s.add('two');
+  s.add(key);
+  function check(m, s) {
+    assertEquals('one', m.get(1));
+    assertEquals(2, m.get('two'));
+    assertEquals(undefined, m.get(3));
+    assertEquals('object', m.get(key));
+    assertTrue(m.has(1));
+    assertFalse(m.has('three'));
+    assertTrue(s.has('two'));
+    assertFalse(s.has(2));
+    assertTrue(s.has(1.0));
+    assertTrue(s.has(key));
+  }
+  check(m, s);
+  check(m, s);
+  %OptimizeFunctionOnNextCall(check);
+  check(m, s);
+  for (var i = 0; i < 100; i++) m.set(i + 10, i);
+  m.delete(1);
+  m.set(1, 'one');
+  check(m, s);
+}
+TestOptimizedLookups();
+
+
+// Test that optimized lookups with keys other than smis and symbols are
+// handled without deoptimizing.
+function TestOptimizedLookupsGenericKeys() {
+  var m = new Map;
+  var s = new Set;
+  var key = {};
+  m.set(key, 'object');
+  m.set('k1', 'computed');
+  m.set(1.5, 'double');
+  s.add(key);
+  s.add('k1');
+  s.add(1.5);
+  function check(m, s, i) {
+    assertEquals('object', m.get(key));
+    assertEquals('computed', m.get('k' + i));
+    assertEquals('double', m.get(i + 0.5));
+    assertEquals(undefined, m.get('k' + (i + 1)));
+    assertTrue(m.has(key));
+    assertFalse(m.has({}));
+    assertTrue(s.has('k' + i));
+    assertTrue(s.has(i + 0.5));
+    assertFalse(s.has(i + 0.25));
+  }
+  check(m, s, 1);
+  check(m, s, 1);
+  %OptimizeFunctionOnNextCall(check);
+  check(m, s, 1);
+  check(m, s, 1);
+  assertTrue(%GetOptimizationStatus(check) != 2);
+}
+TestOptimizedLookupsGenericKeys();
+
+
 // Stress Test
 // There is a proposed stress-test available at the es-discuss mailing list
 // which cannot be reasonably automated.  Check it out by hand if you like:
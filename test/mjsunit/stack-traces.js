@@ -288,4 +288,32 @@ testOmittedBuiltin(function(){ [thrower, 2].sort(function (a,b) {
                    }, "QuickSort");
 
 // Omitted because ADD from runtime.js is non-native builtin.
-testOmittedBuiltin(function(){ thrower + 2; }, "ADD");
\ No newline at end of file
+testOmittedBuiltin(function(){ thrower + 2; }, "ADD");
+
+// Stack traces are formatted when 'stack' is first read, and only once.
+function testLazyFormatting() {
+  var formatted = 0;
+  Error.prepareStackTrace = function(error, frames) {
+    formatted++;
+    assertEquals(undefined, error.stack);
+    return frames[0].getFunctionName();
+  };
+  var e = new Error();
+  var derived = Object.create(e);
+  assertEquals(0, formatted);
+  assertEquals("testLazyFormatting", derived.stack);
+  assertEquals("testLazyFormatting", e.stack);
+  assertEquals(1, formatted);
+  e.stack = 42;
+  assertEquals(42, e.stack);
+
+  var o = {};
+  Error.captureStackTrace(o);
+  Error.captureStackTrace(o);
+  assertEquals(1, formatted);
+  assertEquals("testLazyFormatting", o.stack);
+  assertEquals(2, formatted);
+  delete Error.prepareStackTrace;
+}
+
+testLazyFormatting();
@@ -69,3 +69,21 @@ for (var i = 1; i <= 128; i <<= 1); {
     }
   }
 }
+
+// Two-byte strings with runs of ASCII characters.
+assertEquals("abc\u03b1\u03b2\u03b3 xyz",
+             "ABC\u0391\u0392\u0393 XYZ".toLowerCase());
+assertEquals("ABC\u0391\u0392\u0393 XYZ",
+             "abc\u03b1\u03b2\u03b3 xyz".toUpperCase());
+assertEquals("already lower \u00e9", "already lower \u00e9".toLowerCase());
+assertEquals("\u1234 MIXED CASE", "\u1234 mixed Case".toUpperCase());
+
+// Characters that convert to several characters.
+assertEquals("STRASSE ABC", "stra\u00dfe abc".toUpperCase());
+assertEquals("XX STRASSE", "xx stra\u00dfe".toUpperCase());
+
+// Substrings and concatenations of ASCII strings.
+var sentence = "The Quick Brown Fox Jumps Over The Lazy Dog";
+assertEquals("quick brown fox", sentence.substring(4, 19).toLowerCase());
+assertEquals("QUICK BROWN FOX", sentence.substring(4, 19).toUpperCase());
+assertEquals("the lazy dog!", (sentence.substring(31) + "!").toLowerCase());
@@ -76,3 +76,41 @@ assertEquals(cc8_2, decodeURI(encodeURI(s8)).charCodeAt(1));
 assertEquals(cc9_1, decodeURI(encodeURI(s9)).charCodeAt(0));
 assertEquals(cc9_2, decodeURI(encodeURI(s9)).charCodeAt(1));
 assertEquals(cc10, decodeURI(encodeURI(s10)).charCodeAt(0));
+
+// Reserved characters are only decoded by decodeURIComponent.
+assertEquals("%23%24%26%2B%2C%2F%3A%3B%3D%3F%40",
+             decodeURI("%23%24%26%2B%2C%2F%3A%3B%3D%3F%40"));
+assertEquals("#$&+,/:;=?@",
+             decodeURIComponent("%23%24%26%2B%2C%2F%3A%3B%3D%3F%40"));
+assertEquals("%2f a", decodeURI("%2f%20a"));
+assertEquals("a%2Fb%20c%23", encodeURIComponent("a/b c#"));
+assertEquals("a/b%20c#", encodeURI("a/b c#"));
+
+// Escape sequences mixed with non-ASCII characters.
+assertEquals("\u00e9t\u00e9 \u1234",
+             decodeURIComponent("%C3%A9t%C3%A9%20\u1234"));
+assertEquals("%C3%A9t%C3%A9%20%E1%88%B4",
+             encodeURIComponent("\u00e9t\u00e9 \u1234"));
+assertEquals("\ud800\udc00x", decodeURI("%F0%90%80%80x"));
+
+// Lone surrogates cannot be encoded.
+assertThrows(function(){ encodeURI("\ud800"); }, URIError);
+assertThrows(function(){ encodeURI("a\udc00b"); }, URIError);
+assertThrows(function(){ encodeURIComponent("\ud800a"); }, URIError);
+
+// Malformed escape sequences.
+assertThrows(function(){ decodeURI("%"); }, URIError);
+assertThrows(function(){ decodeURI("%4"); }, URIError);
+assertThrows(function(){ decodeURI("%4g"); }, URIError);
+assertThrows(function(){ decodeURI("%80"); }, URIError);
+assertThrows(function(){ decodeURI("%C3"); }, URIError);
+assertThrows(function(){ decodeURI("%C3%"); }, URIError);
+assertThrows(function(){ decodeURI("%C3x%A9"); }, URIError);
+assertThrows(function(){ decodeURI("%C3%29"); }, URIError);
+assertThrows(function(){ decodeURI("%F4%90%80%80"); }, URIError);
+assertThrows(function(){ decodeURI("%F8%80%80%80%80"); }, URIError);
+
+// Strings that need no escaping round trip unchanged.
+var plain = "abc-def_ghi.jkl";
+assertSame(plain, encodeURIComponent(plain));
+assertSame(plain, decodeURIComponent(plain));
@@ -43,7 +43,7 @@
               # The dependency on v8_base should come from a transitive
               # dependency however the Android toolchain requires libv8_base.a
               # to appear before libv8_snapshot.a so it's listed explicitly.
-              'dependencies': ['v8_base', 'v8_nosnapshot'],
+              'dependencies': ['v8_base', 'v8_snapshot'],
             },
             {
               # The dependency on v8_base should come from a transitive
@@ -89,6 +89,57 @@
             ],
           },
         },
+        {
+          'target_name': 'v8_snapshot',
+          'type': '<(library)',
+          'conditions': [
+            ['want_separate_host_toolset==1', {
+              'toolsets': ['host', 'target'],
+              'dependencies': ['mksnapshot#host', 'js2c#host'],
+            }, {
+              'toolsets': ['target'],
+              'dependencies': ['mksnapshot', 'js2c'],
+            }],
+            ['component=="shared_library"', {
+              'defines': [
+                'V8_SHARED',
+                'BUILDING_V8_SHARED',
+              ],
+              'direct_dependent_settings': {
+                'defines': [
+                  'V8_SHARED',
+                  'USING_V8_SHARED',
+                ],
+              },
+            }],
+          ],
+          'dependencies': [
+            'v8_base',
+          ],
+          'include_dirs+': [
+            '../../src',
+          ],
+          'sources': [
+            '<(SHARED_INTERMEDIATE_DIR)/libraries.cc',
+            '<(SHARED_INTERMEDIATE_DIR)/experimental-libraries.cc',
+            '<(INTERMEDIATE_DIR)/snapshot.cc',
+          ],
+          'actions': [
+            {
+              'action_name': 'run_mksnapshot',
+              'inputs': [
+                '<(PRODUCT_DIR)/<(EXECUTABLE_PREFIX)mksnapshot<(EXECUTABLE_SUFFIX)',
+              ],
+              'outputs': [
+                '<(INTERMEDIATE_DIR)/snapshot.cc',
+              ],
+              'action': [
+                '<@(_inputs)',
+                '<@(_outputs)',
+              ],
+            },
+          ],
+        },
         {
           'target_name': 'v8_nosnapshot',
           'type': '<(library)',
@@ -752,6 +803,27 @@
               }
            ]
         },
+        {
+          'target_name': 'mksnapshot',
+          'type': 'executable',
+          'dependencies': [
+            'v8_base',
+            'v8_nosnapshot',
+          ],
+          'include_dirs+': [
+            '../../src',
+          ],
+          'sources': [
+            '../../src/mksnapshot.cc',
+          ],
+          'conditions': [
+            ['want_separate_host_toolset==1', {
+              'toolsets': ['host'],
+            }, {
+              'toolsets': ['target'],
+            }],
+          ],
+        },
         {
           'target_name': 'v8_shell',
           'type': 'executable',